@@ -0,0 +1,15 @@
+# Optional replacement of the global operator new/delete with the Ball heap:
+# link ${PROJECT_NAME}-new into an executable to route its allocations there.
+set(PROJECT_NEW_NAME ${PROJECT_NAME}-new)
+
+add_library(${PROJECT_NEW_NAME} OBJECT
+	${SOURCE_DIR}/ball/new.cpp
+)
+
+target_link_libraries(${PROJECT_NEW_NAME} PUBLIC ${PROJECT_NAME})
+
+set_target_properties(${PROJECT_NEW_NAME} PROPERTIES
+	CXX_EXTENSIONS OFF
+	CXX_STANDARD 20
+	CXX_STANDARD_REQUIRED ON
+)
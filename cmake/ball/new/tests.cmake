@@ -0,0 +1,29 @@
+if(NOT BUILD_TESTING)
+	return()
+endif()
+
+enable_testing()
+
+set(PROJECT_NEW_TESTS_NAME ${PROJECT_NAME}-new-tests)
+set(PROJECT_NEW_TESTS_OUTPUT_NAME ${PROJECT_OUTPUT_NAME}-new-tests)
+
+add_executable(${PROJECT_NEW_TESTS_NAME}
+	${SOURCE_DIR}/ball/new/tests.cpp
+)
+
+target_link_libraries(${PROJECT_NEW_TESTS_NAME} PRIVATE ${PROJECT_NAME} ${PROJECT_NEW_NAME})
+
+set_target_properties(${PROJECT_NEW_TESTS_NAME} PROPERTIES
+	OUTPUT_NAME ${PROJECT_NEW_TESTS_OUTPUT_NAME}
+
+	CXX_EXTENSIONS OFF
+	CXX_STANDARD 20
+	CXX_STANDARD_REQUIRED ON
+
+	CXX_SCAN_FOR_MODULES ON
+)
+
+add_test(
+	NAME ${PROJECT_NEW_TESTS_NAME}
+	COMMAND $<TARGET_FILE:${PROJECT_NEW_TESTS_NAME}>
+)
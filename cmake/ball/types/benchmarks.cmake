@@ -0,0 +1,22 @@
+if(NOT BALL_ENABLE_BENCHMARKS)
+	return()
+endif()
+
+set(PROJECT_BENCHMARKS_NAME ${PROJECT_NAME}-benchmarks)
+set(PROJECT_BENCHMARKS_OUTPUT_NAME ${PROJECT_OUTPUT_NAME}-benchmarks)
+
+add_executable(${PROJECT_BENCHMARKS_NAME}
+	${SOURCE_DIR}/ball/types/benchmarks.cpp
+)
+
+target_link_libraries(${PROJECT_BENCHMARKS_NAME} PRIVATE ${PROJECT_NAME})
+
+set_target_properties(${PROJECT_BENCHMARKS_NAME} PROPERTIES
+	OUTPUT_NAME ${PROJECT_BENCHMARKS_OUTPUT_NAME}
+
+	CXX_EXTENSIONS OFF
+	CXX_STANDARD 20
+	CXX_STANDARD_REQUIRED ON
+
+	CXX_SCAN_FOR_MODULES ON
+)
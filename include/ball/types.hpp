@@ -7,7 +7,15 @@ BALL_EXPORT namespace Ball::Types
 {
 #	include "types/base.h"
 #	include "types/allocator.hpp"
+#	include "types/arena.hpp"
+#	include "types/memorybudget.hpp"
+#	include "types/memoryresource.hpp"
 #	include "types/vector.hpp"
+#	include "types/mappedvector.hpp"
+#	include "types/reservedvector.hpp"
+#	include "types/ringbuffer.hpp"
+#	include "types/sharedsegment.hpp"
+#	include "types/sparsearray.hpp"
 #	include "types/elements.hpp"
 #	include "types/math.hpp"
 #	include "types/memoryview.hpp"
@@ -5,46 +5,246 @@
 
 #	include "base/arch/unsigned.h"
 #	include "memoryaligned.h"
+#	include "memorystats.h"
+#	include "memoryslab.h"
 
+///-----------------------------------------------------------------------------
+/// @brief Default allocation entry point for containers.
+/// @note  Small requests (see BALL_SLAB_IS_SMALL) are served by size classes
+///        of the slab heap; large ones and slab exhaustion fall back to the
+///        mmap path (Ball_AllocAlignEx). Free/Realloc/Size dispatch by ownership.
+///        @p nFlags (BALL_ALLOC_*) only apply to the mmap path, except for
+///        BALL_ALLOC_PADDED, which slab blocks honor too.
+///-----------------------------------------------------------------------------
 class CAllocatorBase
 {
 public:
-	static void *Alloc( size_t nSize, size_t nAligned )
+	/// BALL_ALLOC_* policy of every block (see CAllocator).
+	static constexpr uint32_t FLAGS = 0;
+
+	static void *Alloc( size_t nSize, size_t nAligned, uint32_t nFlags = 0 )
 	{
-		return Ball_AllocAlign( nSize, nAligned );
+		const size_t nSlabSize = SlabRequest( nSize, nFlags );
+
+		if ( BALL_SLAB_IS_SMALL( nSlabSize, nAligned ) )
+		{
+			ptr_t pMem = Ball_SlabAlloc( nSlabSize, nAligned );
+
+			if ( pMem )
+				return pMem;
+		}
+
+		return Ball_AllocAlignEx( nSize, nAligned, nFlags );
 	}
 
-	static void *Realloc( ptr_t pMem, size_t nSize, size_t nAligned )
+	static void *Realloc( ptr_t pMem, size_t nSize, size_t nAligned, uint32_t nFlags = 0 )
 	{
+		if ( !pMem )
+			return Alloc( nSize, nAligned, nFlags );
+
+		if ( Ball_SlabOwns( pMem ) )
+		{
+			const size_t nSlabSize = SlabRequest( nSize, nFlags );
+
+			if ( !nSize || BALL_SLAB_IS_SMALL( nSlabSize, nAligned ) )
+				return Ball_SlabRealloc( pMem, nSlabSize, nAligned );
+
+			// Leaving the slab: the mmap block must carry the flags.
+			ptr_t pNew = Ball_AllocAlignEx( nSize, nAligned, nFlags );
+
+			if ( pNew )
+			{
+				__builtin_memcpy( pNew, pMem, Ball_SlabSize( pMem ) );
+				Ball_SlabFree( pMem );
+			}
+
+			return pNew;
+		}
+
 		return Ball_ReallocAlign( pMem, nSize, nAligned );
 	}
 
 	static void Free( ptr_t pMem )
 	{
-		Ball_FreeAlign( pMem );
+		if ( Ball_SlabOwns( pMem ) )
+			Ball_SlabFree( pMem );
+		else
+			Ball_FreeAlign( pMem );
 	}
 
+	///-----------------------------------------------------------------------------
+	/// @brief Usable size of a block: at least the requested size (plus the
+	///        padding of BALL_ALLOC_PADDED blocks), rounded up to its size
+	///        class on the slab heap and to its mapping's pages otherwise.
+	///-----------------------------------------------------------------------------
 	static size_t Size( ptr_t pMem, size_t nAligned, size_t nOffset = 0 )
 	{
-		return Ball_MemSize( pMem, nAligned, nOffset );
+		if ( Ball_SlabOwns( pMem ) )
+			return Ball_SlabSize( pMem );
+
+		return Ball_MemUsableSize( pMem, nAligned, nOffset );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Allocate @p nCount blocks of pSizes[ n ] bytes out of one mapping
+	///         (see Ball_AllocBatch); each is freed or resized on its own.
+	/// @return false (all of @p ppBlocks nullptr) on failure.
+	///-----------------------------------------------------------------------------
+	static bool AllocMany( ptr_t *ppBlocks, const size_t *pSizes, size_t nCount, size_t nAligned, uint32_t nFlags = 0 )
+	{
+		return Ball_AllocBatch( ppBlocks, pSizes, nCount, 1, nAligned, nFlags );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Release mappings retained for reuse beyond @p nMaxBytes.
+	/// @return Bytes returned to the kernel.
+	///-----------------------------------------------------------------------------
+	static size_t Trim( size_t nMaxBytes = 0 )
+	{
+		return Ball_MemCacheTrim( nMaxBytes );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Counters of the mmap path and, per size class, of the slab heap
+	///        (see Ball_MemStats_t).
+	///-----------------------------------------------------------------------------
+	static Ball_MemStats_t Stats()
+	{
+		Ball_MemStats_t stats;
+
+		Ball_MemStats( &stats );
+
+		return stats;
+	}
+
+protected:
+	/// @brief Slab request for @p nSize bytes: the mmap path pads on its own.
+	static constexpr size_t SlabRequest( size_t nSize, uint32_t nFlags )
+	{
+		return ( nSize && ( nFlags & BALL_ALLOC_PADDED ) ) ? nSize + BALL_ALLOC_PADDING : nSize;
 	}
 }; // class CAllocatorBase
 
-template < typename I, typename T >
+///-----------------------------------------------------------------------------
+/// @brief Typed CAllocatorBase; @p F is a BALL_ALLOC_* policy applied to every
+///        mmap-backed block (e.g. BALL_ALLOC_HUGEPAGE for large vectors).
+///-----------------------------------------------------------------------------
+template < typename I, typename T, uint32_t F = 0 >
 class CAllocator : public CAllocatorBase
 {
 public:
 	using Base_t = CAllocatorBase;
 
+	static constexpr uint32_t FLAGS = F;
+
 	static T *Alloc( I nCount, size_t nAligned )
 	{
-		return reinterpret_cast< T * >( Base_t::Alloc( nCount * sizeof( T ), nAligned ) );
+		return reinterpret_cast< T * >( Base_t::Alloc( nCount * sizeof( T ), nAligned, F ) );
 	}
 
 	static T *Realloc( T *pMem, I nCount, size_t nAligned )
 	{
-		return reinterpret_cast< T * >( Base_t::Realloc( pMem, nCount * sizeof( T ), nAligned ) );
+		return reinterpret_cast< T * >( Base_t::Realloc( pMem, nCount * sizeof( T ), nAligned, F ) );
+	}
+
+	/// @brief Base_t::AllocMany for pCounts[ n ] elements per block.
+	static bool AllocMany( T **ppBlocks, const size_t *pCounts, size_t nCount, size_t nAligned )
+	{
+		return Ball_AllocBatch( reinterpret_cast< ptr_t * >( ppBlocks ), pCounts, nCount, sizeof( T ), nAligned, F );
 	}
 }; // class CAllocator
 
+///-----------------------------------------------------------------------------
+/// @brief Thread-caching allocation entry point.
+/// @note  Small requests come from per-thread size-class bins, refilled and
+///        flushed a whole slab run at a time, so the hit path takes no lock.
+///        Blocks may be freed from any thread; foreign frees go through a
+///        lock-free queue of the owning thread. Large requests (and @p nFlags)
+///        behave exactly like CAllocatorBase, and Free/Size/AllocMany are
+///        shared with it.
+///-----------------------------------------------------------------------------
+class CThreadCacheAllocatorBase : public CAllocatorBase
+{
+public:
+	static void *Alloc( size_t nSize, size_t nAligned, uint32_t nFlags = 0 )
+	{
+		const size_t nSlabSize = SlabRequest( nSize, nFlags );
+
+		if ( BALL_SLAB_IS_SMALL( nSlabSize, nAligned ) )
+		{
+			ptr_t pMem = Ball_SlabCacheAlloc( nSlabSize, nAligned );
+
+			if ( pMem )
+				return pMem;
+		}
+
+		return Ball_AllocAlignEx( nSize, nAligned, nFlags );
+	}
+
+	static void *Realloc( ptr_t pMem, size_t nSize, size_t nAligned, uint32_t nFlags = 0 )
+	{
+		if ( !pMem )
+			return Alloc( nSize, nAligned, nFlags );
+
+		if ( Ball_SlabOwns( pMem ) )
+		{
+			const size_t nSlabSize = SlabRequest( nSize, nFlags );
+
+			if ( !nSize || BALL_SLAB_IS_SMALL( nSlabSize, nAligned ) )
+				return Ball_SlabCacheRealloc( pMem, nSlabSize, nAligned );
+
+			// Leaving the slab: the mmap block must carry the flags.
+			ptr_t pNew = Ball_AllocAlignEx( nSize, nAligned, nFlags );
+
+			if ( pNew )
+			{
+				__builtin_memcpy( pNew, pMem, Ball_SlabSize( pMem ) );
+				Ball_SlabFree( pMem );
+			}
+
+			return pNew;
+		}
+
+		return Ball_ReallocAlign( pMem, nSize, nAligned );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Collect blocks freed by other threads and give empty runs of the
+	///        calling thread back to the shared heap (done on thread exit too).
+	///-----------------------------------------------------------------------------
+	static void Flush()
+	{
+		Ball_SlabCacheFlush();
+	}
+}; // class CThreadCacheAllocatorBase
+
+///-----------------------------------------------------------------------------
+/// @brief Typed CThreadCacheAllocatorBase; @p F is a BALL_ALLOC_* policy, as
+///        for CAllocator.
+///-----------------------------------------------------------------------------
+template < typename I, typename T, uint32_t F = 0 >
+class CThreadCacheAllocator : public CThreadCacheAllocatorBase
+{
+public:
+	using Base_t = CThreadCacheAllocatorBase;
+
+	static constexpr uint32_t FLAGS = F;
+
+	static T *Alloc( I nCount, size_t nAligned )
+	{
+		return reinterpret_cast< T * >( Base_t::Alloc( nCount * sizeof( T ), nAligned, F ) );
+	}
+
+	static T *Realloc( T *pMem, I nCount, size_t nAligned )
+	{
+		return reinterpret_cast< T * >( Base_t::Realloc( pMem, nCount * sizeof( T ), nAligned, F ) );
+	}
+
+	/// @brief Base_t::AllocMany for pCounts[ n ] elements per block.
+	static bool AllocMany( T **ppBlocks, const size_t *pCounts, size_t nCount, size_t nAligned )
+	{
+		return Ball_AllocBatch( reinterpret_cast< ptr_t * >( ppBlocks ), pCounts, nCount, sizeof( T ), nAligned, F );
+	}
+}; // class CThreadCacheAllocator
+
 #endif // !defined( _INCLUDE_BALL_TYPES_CALLOCATOR_HPP_ )
@@ -0,0 +1,409 @@
+#ifndef _INCLUDE_BALL_TYPES_ARENA_HPP_
+#	define _INCLUDE_BALL_TYPES_ARENA_HPP_
+
+#	pragma once
+
+#	include "base/arch.h"
+#	include "c/assert.h"
+#	include "allocator.hpp"
+#	include "memoryresource.hpp"
+
+///-----------------------------------------------------------------------------
+/// @brief Monotonic (bump-pointer) arena.
+/// @note  Memory comes from an optional caller buffer first, then from heap
+///        chunks of growing size. Blocks are never freed one by one: Free only
+///        rewinds the most recent block and Realloc extends it in place, which
+///        covers the append-only growth of a single container. Everything else
+///        is reclaimed at once by Reset() or the destructor.
+///        Not thread-safe; one arena per thread or external synchronization.
+///-----------------------------------------------------------------------------
+class CArena
+{
+public:
+	static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+	static constexpr size_t MAX_CHUNK_SIZE =     16 * 1024 * 1024;
+
+	///-----------------------------------------------------------------------------
+	/// @brief Header placed right before every block handed out by CArenaAllocator.
+	///-----------------------------------------------------------------------------
+	struct Block_t
+	{
+		CArena *pArena; ///< Owning arena, nullptr for heap fallback blocks.
+		size_t  nSize;  ///< Usable size; for heap fallback blocks the distance to the heap block start.
+	}; // struct Block_t
+
+	explicit CArena( size_t nChunkSize = DEFAULT_CHUNK_SIZE ) noexcept :
+		CArena( nullptr, 0, nChunkSize )
+	{
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Use @p pBuffer (e.g. a stack array) before touching the heap.
+	/// @note  The buffer must outlive the arena.
+	///-----------------------------------------------------------------------------
+	CArena( ptr_t pBuffer, size_t nBufferSize, size_t nChunkSize = DEFAULT_CHUNK_SIZE ) noexcept :
+		m_pBuffer( reinterpret_cast< uchar_t * >( pBuffer ) ),
+		m_nBufferSize( pBuffer ? nBufferSize : 0 ),
+		m_nChunkSize( nChunkSize ? nChunkSize : DEFAULT_CHUNK_SIZE ),
+		m_nNextChunkSize( m_nChunkSize ),
+		m_pChunks( nullptr ),
+		m_pCursor( m_pBuffer ),
+		m_pLimit( m_pBuffer + m_nBufferSize ),
+		m_pLast( nullptr )
+	{
+	}
+
+	template < size_t N >
+	explicit CArena( uchar_t ( &buffer )[ N ], size_t nChunkSize = DEFAULT_CHUNK_SIZE ) noexcept :
+		CArena( buffer, N, nChunkSize )
+	{
+	}
+
+	CArena( const CArena & ) = delete;
+	CArena &operator=( const CArena & ) = delete;
+
+	~CArena() noexcept
+	{
+		ReleaseChunks( nullptr );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Allocate @p nSize bytes aligned to @p nAligned (power of two).
+	/// @return Block pointer or nullptr when a new chunk cannot be obtained.
+	///-----------------------------------------------------------------------------
+	ptr_t Alloc( size_t nSize, size_t nAligned )
+	{
+		if ( nAligned < alignof( Block_t ) )
+			nAligned = alignof( Block_t );
+
+		uchar_t *pBlock = Place( m_pCursor, nAligned );
+
+		if ( !m_pCursor || pBlock + nSize > m_pLimit || pBlock + nSize < pBlock )
+		{
+			if ( !NewChunk( nSize + sizeof( Block_t ) + nAligned ) )
+				return nullptr;
+
+			pBlock = Place( m_pCursor, nAligned );
+		}
+
+		Block_t *pHeader = HeaderOf( pBlock );
+
+		pHeader->pArena = this;
+		pHeader->nSize = nSize;
+
+		m_pCursor = pBlock + nSize;
+		m_pLast = pBlock;
+
+		return pBlock;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Resize a block of this arena.
+	/// @return The same block when it is the most recent one and still fits the
+	///         current chunk, otherwise a new block holding a copy (the old one is
+	///         only reclaimed by Reset()).
+	///-----------------------------------------------------------------------------
+	ptr_t Realloc( ptr_t pMem, size_t nSize, size_t nAligned )
+	{
+		if ( !pMem )
+			return Alloc( nSize, nAligned );
+
+		Block_t *pHeader = HeaderOf( pMem );
+
+		BALL_ASSERT( pHeader->pArena == this );
+
+		uchar_t *pBlock = reinterpret_cast< uchar_t * >( pMem );
+
+		if ( nSize <= pHeader->nSize || ( pBlock == m_pLast && pBlock + nSize <= m_pLimit && pBlock + nSize > pBlock ) )
+		{
+			if ( pBlock == m_pLast )
+				m_pCursor = pBlock + nSize;
+
+			pHeader->nSize = nSize;
+
+			return pMem;
+		}
+
+		const size_t nOldSize = pHeader->nSize;
+		ptr_t pNew = Alloc( nSize, nAligned );
+
+		if ( pNew )
+			__builtin_memcpy( pNew, pMem, nOldSize );
+
+		return pNew;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Rewind the most recent block; other blocks wait for Reset().
+	///-----------------------------------------------------------------------------
+	void Free( ptr_t pMem ) noexcept
+	{
+		if ( pMem && pMem == m_pLast )
+		{
+			m_pCursor = reinterpret_cast< uchar_t * >( HeaderOf( pMem ) );
+			m_pLast = nullptr;
+		}
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Forget every block at once.
+	/// @note  The newest (largest) chunk is kept for the next round, so a reused
+	///        arena stops hitting the heap once it has seen its peak.
+	///-----------------------------------------------------------------------------
+	void Reset() noexcept
+	{
+		Chunk_t *pKeep = m_pChunks;
+
+		ReleaseChunks( pKeep );
+
+		m_pChunks = pKeep;
+		m_pLast = nullptr;
+
+		if ( m_nBufferSize )
+		{
+			m_pCursor = m_pBuffer;
+			m_pLimit = m_pBuffer + m_nBufferSize;
+		}
+		else if ( pKeep )
+		{
+			m_pCursor = reinterpret_cast< uchar_t * >( pKeep + 1 );
+			m_pLimit = reinterpret_cast< uchar_t * >( pKeep ) + pKeep->nSize;
+		}
+		else
+		{
+			m_pCursor = m_pLimit = nullptr;
+		}
+	}
+
+	/// @brief Bytes left in the current chunk (or buffer).
+	size_t Available() const noexcept { return static_cast< size_t >( m_pLimit - m_pCursor ); }
+
+	///-----------------------------------------------------------------------------
+	/// @brief Arena CArenaAllocator draws from on the calling thread.
+	///-----------------------------------------------------------------------------
+	static CArena *&Current() noexcept
+	{
+		static thread_local CArena *s_pCurrent = nullptr;
+
+		return s_pCurrent;
+	}
+
+	static Block_t *HeaderOf( ptr_t pMem ) noexcept
+	{
+		return reinterpret_cast< Block_t * >( pMem ) - 1;
+	}
+
+private:
+	struct Chunk_t
+	{
+		Chunk_t *pPrev;
+		size_t   nSize;
+	}; // struct Chunk_t
+
+	static uchar_t *Place( uchar_t *pCursor, size_t nAligned ) noexcept
+	{
+		const uintptr_t nAddress = reinterpret_cast< uintptr_t >( pCursor ) + sizeof( Block_t );
+
+		return reinterpret_cast< uchar_t * >( ( nAddress + nAligned - 1 ) & ~( nAligned - 1 ) );
+	}
+
+	bool NewChunk( size_t nRequired )
+	{
+		// A kept chunk only lives at the head; it is used once the buffer runs out.
+		Chunk_t *pSpare = m_pChunks;
+
+		if ( pSpare && m_pLimit != reinterpret_cast< uchar_t * >( pSpare ) + pSpare->nSize &&
+		     pSpare->nSize - sizeof( Chunk_t ) >= nRequired )
+		{
+			m_pCursor = reinterpret_cast< uchar_t * >( pSpare + 1 );
+			m_pLimit = reinterpret_cast< uchar_t * >( pSpare ) + pSpare->nSize;
+
+			return true;
+		}
+
+		size_t nSize = m_nNextChunkSize;
+
+		while ( nSize - sizeof( Chunk_t ) < nRequired && nSize < ( size_t( 1 ) << ( sizeof( size_t ) * 8 - 2 ) ) )
+			nSize <<= 1;
+
+		Chunk_t *pChunk = reinterpret_cast< Chunk_t * >( CAllocatorBase::Alloc( nSize, alignof( Chunk_t ) ) );
+
+		BALL_ASSERT_MESSAGE( pChunk != nullptr, "Failed to allocate arena chunk" );
+
+		if ( !pChunk )
+			return false;
+
+		pChunk->pPrev = m_pChunks;
+		pChunk->nSize = nSize;
+		m_pChunks = pChunk;
+
+		if ( m_nNextChunkSize < MAX_CHUNK_SIZE )
+			m_nNextChunkSize <<= 1;
+
+		m_pCursor = reinterpret_cast< uchar_t * >( pChunk + 1 );
+		m_pLimit = reinterpret_cast< uchar_t * >( pChunk ) + nSize;
+
+		return true;
+	}
+
+	void ReleaseChunks( Chunk_t *pKeep ) noexcept
+	{
+		Chunk_t *pChunk = m_pChunks;
+
+		while ( pChunk )
+		{
+			Chunk_t *pPrev = pChunk->pPrev;
+
+			if ( pChunk != pKeep )
+				CAllocatorBase::Free( pChunk );
+			else
+				pChunk->pPrev = nullptr;
+
+			pChunk = pPrev;
+		}
+
+		m_pChunks = nullptr;
+	}
+
+	uchar_t *m_pBuffer;
+	size_t   m_nBufferSize;
+	size_t   m_nChunkSize;
+	size_t   m_nNextChunkSize;
+	Chunk_t *m_pChunks;
+	uchar_t *m_pCursor;
+	uchar_t *m_pLimit;
+	uchar_t *m_pLast;
+}; // class CArena
+
+///-----------------------------------------------------------------------------
+/// @brief Binds @p arena as CArena::Current() for the enclosing scope.
+///-----------------------------------------------------------------------------
+class CArenaScope
+{
+public:
+	explicit CArenaScope( CArena &arena ) noexcept : m_pPrevious( CArena::Current() ) { CArena::Current() = &arena; }
+	~CArenaScope() noexcept { CArena::Current() = m_pPrevious; }
+
+	CArenaScope( const CArenaScope & ) = delete;
+	CArenaScope &operator=( const CArenaScope & ) = delete;
+
+private:
+	CArena *m_pPrevious;
+}; // class CArenaScope
+
+///-----------------------------------------------------------------------------
+/// @brief Allocation entry point drawing from the calling thread's CArena.
+/// @note  Blocks remember their arena, so Free/Realloc do not depend on the
+///        scope still being active, but the arena must outlive them. Without a
+///        bound arena, requests fall back to CAllocatorBase (the blocks carry
+///        the same header and are freed normally).
+///-----------------------------------------------------------------------------
+class CArenaAllocatorBase
+{
+public:
+	using Block_t = CArena::Block_t;
+
+	/// No BALL_ALLOC_* policy: blocks are carved out of the arena unpadded.
+	static constexpr uint32_t FLAGS = 0;
+
+	static void *Alloc( size_t nSize, size_t nAligned )
+	{
+		CArena *pArena = CArena::Current();
+
+		if ( pArena )
+			return pArena->Alloc( nSize, nAligned );
+
+		const size_t nOffset = nAligned > sizeof( Block_t ) ? nAligned : sizeof( Block_t );
+		uchar_t *pHeap = reinterpret_cast< uchar_t * >( CAllocatorBase::Alloc( nOffset + nSize, nOffset ) );
+
+		if ( !pHeap )
+			return nullptr;
+
+		Block_t *pHeader = CArena::HeaderOf( pHeap + nOffset );
+
+		pHeader->pArena = nullptr;
+		pHeader->nSize = nOffset;
+
+		return pHeap + nOffset;
+	}
+
+	static void *Realloc( ptr_t pMem, size_t nSize, size_t nAligned )
+	{
+		if ( !pMem )
+			return Alloc( nSize, nAligned );
+
+		const Block_t *pHeader = CArena::HeaderOf( pMem );
+
+		if ( pHeader->pArena )
+			return pHeader->pArena->Realloc( pMem, nSize, nAligned );
+
+		const size_t nOffset = pHeader->nSize;
+
+		BALL_ASSERT( nAligned <= nOffset );
+
+		uchar_t *pHeap = reinterpret_cast< uchar_t * >( CAllocatorBase::Realloc( reinterpret_cast< uchar_t * >( pMem ) - nOffset, nOffset + nSize, nOffset ) );
+
+		return pHeap ? pHeap + nOffset : nullptr;
+	}
+
+	static void Free( ptr_t pMem )
+	{
+		if ( !pMem )
+			return;
+
+		const Block_t *pHeader = CArena::HeaderOf( pMem );
+
+		if ( pHeader->pArena )
+			pHeader->pArena->Free( pMem );
+		else
+			CAllocatorBase::Free( reinterpret_cast< uchar_t * >( pMem ) - pHeader->nSize );
+	}
+
+	static size_t Size( ptr_t pMem, size_t nAligned, size_t nOffset = 0 )
+	{
+		const Block_t *pHeader = CArena::HeaderOf( pMem );
+
+		if ( pHeader->pArena )
+			return pHeader->nSize;
+
+		return CAllocatorBase::Size( reinterpret_cast< uchar_t * >( pMem ) - pHeader->nSize, nAligned, nOffset ) - pHeader->nSize;
+	}
+}; // class CArenaAllocatorBase
+
+template < typename I, typename T >
+class CArenaAllocator : public CArenaAllocatorBase
+{
+public:
+	using Base_t = CArenaAllocatorBase;
+
+	static T *Alloc( I nCount, size_t nAligned )
+	{
+		return reinterpret_cast< T * >( Base_t::Alloc( nCount * sizeof( T ), nAligned ) );
+	}
+
+	static T *Realloc( T *pMem, I nCount, size_t nAligned )
+	{
+		return reinterpret_cast< T * >( Base_t::Realloc( pMem, nCount * sizeof( T ), nAligned ) );
+	}
+}; // class CArenaAllocator
+
+///-----------------------------------------------------------------------------
+/// @brief CMemoryResource handing out blocks of one arena, whichever arena the
+///        thread has bound (see CResourceAllocator).
+///-----------------------------------------------------------------------------
+class CArenaResource final : public CMemoryResource
+{
+public:
+	explicit CArenaResource( CArena &arena ) noexcept : m_pArena( &arena ) {}
+
+	void *Alloc( size_t nSize, size_t nAligned ) override { return m_pArena->Alloc( nSize, nAligned ); }
+	void *Realloc( ptr_t pMem, size_t nSize, size_t nAligned ) override { return m_pArena->Realloc( pMem, nSize, nAligned ); }
+	void Free( ptr_t pMem ) override { m_pArena->Free( pMem ); }
+
+	CArena &Arena() const noexcept { return *m_pArena; }
+
+private:
+	CArena *m_pArena;
+}; // class CArenaResource
+
+#endif // !defined( _INCLUDE_BALL_TYPES_ARENA_HPP_ )
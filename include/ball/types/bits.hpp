@@ -146,7 +146,7 @@ constexpr T NextDoublingCapacityT( T nOldCount, T nRequestedCount, T nMinCount,
 	const U nRequired = static_cast< U >( nRequestedCount );
 	const U nMin = static_cast< U >( nMinCount );
 	const U nMax = static_cast< U >( nMaxCount );
-	const U nMinRequired = BALL_MIN( nRequired, nMin );
+	const U nMinRequired = BALL_MAX( nRequired, nMin );
 
 	// If old_count is zero (violates the usual precondition), we cannot grow by doubling.
 	// Define behavior: jump directly to max(mn, min(rq, mx)).
@@ -0,0 +1,70 @@
+#ifndef _INCLUDE_BALL_TYPES_C_ATOMIC_H_
+#	define _INCLUDE_BALL_TYPES_C_ATOMIC_H_
+
+#	include "macros.h"
+
+#	define BALL_ATOMIC_RELAXED __ATOMIC_RELAXED
+#	define BALL_ATOMIC_ACQUIRE __ATOMIC_ACQUIRE
+#	define BALL_ATOMIC_RELEASE __ATOMIC_RELEASE
+#	define BALL_ATOMIC_ACQ_REL __ATOMIC_ACQ_REL
+
+#	define BALL_ATOMIC_LOAD( p, order ) __atomic_load_n( p, order )
+#	define BALL_ATOMIC_STORE( p, v, order ) __atomic_store_n( p, v, order )
+#	define BALL_ATOMIC_EXCHANGE( p, v, order ) __atomic_exchange_n( p, v, order )
+#	define BALL_ATOMIC_ADD( p, v, order ) __atomic_add_fetch( p, v, order )
+#	define BALL_ATOMIC_SUB( p, v, order ) __atomic_sub_fetch( p, v, order )
+#	define BALL_ATOMIC_CAS( p, pExpected, v, order ) __atomic_compare_exchange_n( p, pExpected, v, 0, order, BALL_ATOMIC_RELAXED )
+
+#	if defined( __x86_64__ ) || defined( __i386__ )
+#		define BALL_CPU_RELAX() __builtin_ia32_pause()
+#	elif defined( __aarch64__ ) || defined( __arm__ )
+#		define BALL_CPU_RELAX() __asm__ __volatile__( "yield" )
+#	else
+#		define BALL_CPU_RELAX() ( ( void )0 )
+#	endif
+
+/// Number of busy-wait iterations before a waiter yields its time slice.
+#	define BALL_SPINLOCK_SPINS 64
+
+BALL_DLL_IMPORT_C int sched_yield( void );
+
+///-----------------------------------------------------------------------------
+/// @brief Minimal test-and-test-and-set lock for short critical sections.
+/// @note  Zero-initialized storage is an unlocked lock.
+///-----------------------------------------------------------------------------
+typedef int Ball_SpinLock_t;
+
+static inline void Ball_SpinLock( Ball_SpinLock_t *pLock )
+{
+	for ( ; ; )
+	{
+		if ( !BALL_ATOMIC_EXCHANGE( pLock, 1, BALL_ATOMIC_ACQUIRE ) )
+			return;
+
+		for ( int n = 0; BALL_ATOMIC_LOAD( pLock, BALL_ATOMIC_RELAXED ); n++ )
+		{
+			if ( n < BALL_SPINLOCK_SPINS )
+			{
+				BALL_CPU_RELAX();
+			}
+			else
+			{
+				( void )sched_yield();
+				n = 0;
+			}
+		}
+	}
+}
+
+/// @brief Take the lock only if it is free; returns nonzero when taken.
+static inline int Ball_SpinTryLock( Ball_SpinLock_t *pLock )
+{
+	return !BALL_ATOMIC_LOAD( pLock, BALL_ATOMIC_RELAXED ) && !BALL_ATOMIC_EXCHANGE( pLock, 1, BALL_ATOMIC_ACQUIRE );
+}
+
+static inline void Ball_SpinUnlock( Ball_SpinLock_t *pLock )
+{
+	BALL_ATOMIC_STORE( pLock, 0, BALL_ATOMIC_RELEASE );
+}
+
+#endif // !defined( _INCLUDE_BALL_TYPES_C_ATOMIC_H_ )
@@ -0,0 +1,22 @@
+#ifndef _INCLUDE_BALL_TYPES_C_FILE_H_
+#	define _INCLUDE_BALL_TYPES_C_FILE_H_
+
+#	include "macros.h"
+
+#	define BALL_O_RDONLY 00
+#	define BALL_O_RDWR 02
+#	define BALL_O_CREAT 0100
+#	define BALL_O_EXCL 0200
+#	define BALL_O_CLOEXEC 02000000
+
+#	define BALL_SEEK_END 2
+
+BALL_DLL_IMPORT_C int open( const char *pszPath, int nFlags, ... );
+BALL_DLL_IMPORT_C int close( int nFD );
+BALL_DLL_IMPORT_C int ftruncate( int nFD, long nLength );
+BALL_DLL_IMPORT_C long lseek( int nFD, long nOffset, int nWhence );
+BALL_DLL_IMPORT_C int unlink( const char *pszPath );
+BALL_DLL_IMPORT_C int shm_open( const char *pszName, int nFlags, unsigned int nMode );
+BALL_DLL_IMPORT_C int shm_unlink( const char *pszName );
+
+#endif // !defined( _INCLUDE_BALL_TYPES_C_FILE_H_ )
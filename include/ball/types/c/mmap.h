@@ -4,12 +4,16 @@
 #	include "macros.h"
 
 #	define BALL_SC_PAGESIZE 30
+#	define BALL_SC_NPROCESSORS_ONLN 84
 
+#	define BALL_PROT_NONE 0x0
 #	define BALL_PROT_READ 0x1
 #	define BALL_PROT_WRITE 0x2
 #	define BALL_PROT_EXEC 0x4
 
+#	define BALL_MAP_SHARED 0x01
 #	define BALL_MAP_PRIVATE 0x02
+#	define BALL_MAP_FIXED 0x10
 
 #	ifdef __MCST__
 #		define BALL_MAP_ANONYMOUS 0x10
@@ -17,14 +21,32 @@
 #		define BALL_MAP_ANONYMOUS 0x20
 #	endif // defined( __MCST__ )
 
+#	define BALL_MAP_NORESERVE 0x4000
+#	define BALL_MAP_HUGETLB 0x40000
+#	define BALL_MAP_HUGE_2MB ( 21 << 26 )
+
 #	define BALL_MREMAP_MAYMOVE 1
+#	define BALL_MREMAP_FIXED 2
+
+#	define BALL_MADV_DONTNEED 4
+#	define BALL_MADV_HUGEPAGE 14
+#	define BALL_MADV_POPULATE_WRITE 23
+
+#	define BALL_MS_ASYNC 1
+#	define BALL_MS_SYNC 4
+
+#	define BALL_MFD_CLOEXEC 0x1
 
 #	define BALL_MAP_FAILED ( ( void * )-1 )
 
 BALL_DLL_IMPORT_C void *mmap( void *pMem, unsigned long long nLength, int nProt, int nFlags, int nFD, long nOffset );
 BALL_DLL_IMPORT_C int munmap( void *pMem, unsigned long long nLength );
+BALL_DLL_IMPORT_C int mprotect( void *pMem, unsigned long long nLength, int nProt );
 BALL_DLL_IMPORT_C void *mremap( void *pOldAddress, unsigned long long nOldSize, unsigned long long nNewSize, int nFlags, ... );
+BALL_DLL_IMPORT_C int msync( void *pMem, unsigned long long nLength, int nFlags );
+BALL_DLL_IMPORT_C int madvise( void *pMem, unsigned long long nLength, int nAdvice );
 BALL_DLL_IMPORT_C long sysconf( int nName );
+BALL_DLL_IMPORT_C int memfd_create( const char *pszName, unsigned int nFlags );
 
 #endif // !defined( _INCLUDE_BALL_TYPES_C_MMAP_H_ )
 
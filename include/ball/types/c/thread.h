@@ -0,0 +1,26 @@
+#ifndef _INCLUDE_BALL_TYPES_C_THREAD_H_
+#	define _INCLUDE_BALL_TYPES_C_THREAD_H_
+
+#	include "macros.h"
+
+#	if defined( __x86_64__ )
+#		define BALL_SYS_FUTEX 202
+#	elif defined( __i386__ )
+#		define BALL_SYS_FUTEX 240
+#	elif defined( __aarch64__ )
+#		define BALL_SYS_FUTEX 98
+#	endif
+
+#	define BALL_FUTEX_WAIT_PRIVATE 128
+#	define BALL_FUTEX_WAKE_PRIVATE 129
+
+typedef unsigned int Ball_ThreadKey_t;
+typedef unsigned long int Ball_Thread_t;
+
+BALL_DLL_IMPORT_C int pthread_key_create( Ball_ThreadKey_t *pKey, void ( *pfnDestructor )( void * ) );
+BALL_DLL_IMPORT_C int pthread_setspecific( Ball_ThreadKey_t nKey, const void *pValue );
+BALL_DLL_IMPORT_C int pthread_create( Ball_Thread_t *pThread, const void *pAttributes, void *( *pfnStart )( void * ), void *pArgument );
+BALL_DLL_IMPORT_C int pthread_join( Ball_Thread_t nThread, void **ppResult );
+BALL_DLL_IMPORT_C long syscall( long nNumber, ... );
+
+#endif // !defined( _INCLUDE_BALL_TYPES_C_THREAD_H_ )
@@ -0,0 +1,17 @@
+#ifndef _INCLUDE_BALL_TYPES_C_TIME_H_
+#	define _INCLUDE_BALL_TYPES_C_TIME_H_
+
+#	include "macros.h"
+
+#	define BALL_CLOCK_MONOTONIC 1
+#	define BALL_CLOCK_MONOTONIC_COARSE 6
+
+struct Ball_TimeSpec_t
+{
+	long nSeconds;
+	long nNanoseconds;
+}; // struct Ball_TimeSpec_t
+
+BALL_DLL_IMPORT_C int clock_gettime( int nClock, struct Ball_TimeSpec_t *pTime );
+
+#endif // !defined( _INCLUDE_BALL_TYPES_C_TIME_H_ )
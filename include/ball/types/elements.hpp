@@ -3,6 +3,13 @@
 
 #	include "base/arch.h"
 #	include "base/fixed.h"
+#	include "memorycompare.h"
+#	include "memorycopy.h"
+#	include "memoryfind.h"
+#	include "meta/isbitwisecomparable.hpp"
+#	include "meta/issame.hpp"
+#	include "meta/istriviallyrelocatable.hpp"
+#	include "meta/removecv.hpp"
 #	include "meta/removereference.hpp"
 #	include "xvalue.hpp"
 
@@ -33,14 +40,32 @@ constexpr void DestructElement( T ( *pMemory )[ N ] )
 	}
 }
 
+///-----------------------------------------------------------------------------
+/// @brief  Whether CopyElements/CopyElementsFromEnd hand @p nCount elements of T
+///         to the vector kernels (Ball_MemMove): trivially copyable elements
+///         filling at least BALL_MEMCOPY_MIN_SIZE bytes.
+///-----------------------------------------------------------------------------
+template < typename T, typename I >
+constexpr bool IsBulkCopy( const I nCount ) noexcept
+{
+	if constexpr ( __is_trivially_copyable( T ) )
+		return nCount > I( 0 ) && static_cast< size_t >( nCount ) >= BALL_MEMCOPY_MIN_SIZE / sizeof( T );
+	else
+		return false;
+}
+
 ///-----------------------------------------------------------------------------
 /// @brief Copy elements from [pSrc, pSrcEnd) into destination starting at pDest.
-///        Overlap-safe, memmove-like (byte-wise for trivially copyable types).
+///        Overlap-safe when pDest <= pSrc. Long runs of trivially copyable
+///        elements go to the vector kernels (fully memmove-like).
 /// @return pDest
 ///-----------------------------------------------------------------------------
 template < typename T, typename I >
 inline T *CopyElements( const I nCount, T *pDest, const T *pSrc ) noexcept
 {
+	if ( IsBulkCopy< T >( nCount ) )
+		return static_cast< T * >( Ball_MemMove( static_cast< void * >( pDest ), static_cast< const void * >( pSrc ), static_cast< size_t >( nCount ) * sizeof( T ) ) );
+
 	for ( I n = 0; n < nCount; ++n )
 		pDest[ n ] = pSrc[ n ];
 
@@ -51,12 +76,16 @@ inline T *CopyElements( const I nCount, T *pDest, const T *pSrc ) noexcept
 ///-----------------------------------------------------------------------------
 /// @brief Copy elements right-to-left: copy nLength elements from pSrc to pDest,
 ///        starting at the end (index nLength-1 down to 0).
-///        Useful when ranges may overlap with pDest >= pSrc.
+///        Useful when ranges may overlap with pDest >= pSrc. Long runs of
+///        trivially copyable elements go to the vector kernels, as in CopyElements.
 /// @return pDest
 ///-----------------------------------------------------------------------------
 template < typename T, typename I >
 inline T *CopyElementsFromEnd( I nCount, T *pDest, const T *pSrc ) noexcept
 {
+	if ( IsBulkCopy< T >( nCount ) )
+		return static_cast< T * >( Ball_MemMove( static_cast< void * >( pDest ), static_cast< const void * >( pSrc ), static_cast< size_t >( nCount ) * sizeof( T ) ) );
+
 	for ( I n = nCount; n-- > 0; )
 		pDest[ n ] = pSrc[ n ];
 
@@ -83,6 +112,49 @@ constexpr T *ShiftElements( T *pDest, const T *pSrc, const T *pSrcEnd ) noexcept
 		return pDest;
 }
 
+///-----------------------------------------------------------------------------
+/// @brief Relocate @p nCount live elements from pSrc to pDest: afterwards pDest
+///        holds them and pSrc is raw memory. Overlap-safe (memmove-like).
+///        One bulk memmove for IS_TRIVIALLY_RELOCATABLE types (the vector kernels
+///        from BALL_MEMCOPY_MIN_SIZE bytes on), otherwise a move construction +
+///        destruction per element, walking away from the overlap.
+/// @return pDest
+///-----------------------------------------------------------------------------
+template < typename T, typename I >
+constexpr T *RelocateElements( const I nCount, T *pDest, T *pSrc ) noexcept
+{
+	if ( pDest == pSrc || nCount <= I( 0 ) )
+		return pDest;
+
+	if constexpr ( IS_TRIVIALLY_RELOCATABLE< T > )
+	{
+		const size_t nSize = static_cast< size_t >( nCount ) * sizeof( T );
+
+		if ( nSize >= BALL_MEMCOPY_MIN_SIZE )
+			Ball_MemMove( static_cast< void * >( pDest ), static_cast< const void * >( pSrc ), nSize );
+		else
+			__builtin_memmove( static_cast< void * >( pDest ), static_cast< const void * >( pSrc ), nSize );
+	}
+	else if ( pDest < pSrc )
+	{
+		for ( I n = 0; n < nCount; ++n )
+		{
+			ConstructElement( &pDest[ n ], Move( pSrc[ n ] ) );
+			DestructElement( &pSrc[ n ] );
+		}
+	}
+	else
+	{
+		for ( I n = nCount; n-- > 0; )
+		{
+			ConstructElement( &pDest[ n ], Move( pSrc[ n ] ) );
+			DestructElement( &pSrc[ n ] );
+		}
+	}
+
+	return pDest;
+}
+
 template < typename T >
 constexpr void ConstructElements( T *pElement, const T *pEnd ) noexcept
 {
@@ -115,6 +187,9 @@ constexpr int8_t CompareElements( const I nCount, const T *pLeft, const T *pRigh
 
 	const size_t nSize = static_cast< size_t >( nCount ) * sizeof( T );
 
+	if ( !__builtin_is_constant_evaluated() && nSize >= BALL_MEMCOMPARE_MIN_SIZE )
+		return static_cast< int8_t >( Ball_MemCompare( pLeft, pRight, nSize ) );
+
 	const uchar_t *_pLeft = reinterpret_cast< const uchar_t * >( pLeft );
 	const uchar_t *_pRight = reinterpret_cast< const uchar_t * >( pRight );
 
@@ -130,4 +205,161 @@ constexpr int8_t CompareElements( const I nCount, const T *pLeft, const T *pRigh
 	return 0;
 }
 
+///-----------------------------------------------------------------------------
+/// @brief  Index of the first of @p nCount element pairs that differ (==), or
+///         @p nCount when all are equal.
+/// @note   Long runs of bitwise comparable elements (IS_BITWISE_COMPARABLE)
+///         go to the vector kernels (Ball_MemMismatch) at run time; the
+///         callers order the differing pair with the element operators.
+///-----------------------------------------------------------------------------
+template < typename T, typename I = size_t >
+constexpr I MismatchElements( const I nCount, const T *pLeft, const T *pRight ) noexcept
+{
+	if constexpr ( IS_BITWISE_COMPARABLE< T > )
+	{
+		const size_t nSize = static_cast< size_t >( nCount ) * sizeof( T );
+
+		if ( !__builtin_is_constant_evaluated() && nSize >= BALL_MEMCOMPARE_MIN_SIZE )
+			return static_cast< I >( Ball_MemMismatch( pLeft, pRight, nSize ) / sizeof( T ) );
+	}
+
+	I n = 0;
+
+	while ( n < nCount && pLeft[ n ] == pRight[ n ] )
+		++n;
+
+	return n;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Search kernel (BALL_MEMFIND_*) of elements of T, or ~0u when T is
+///        searched element by element (class types, long double, ...).
+///-----------------------------------------------------------------------------
+template < typename T, typename U = RemoveCV_t< T > >
+constexpr uint32_t MEMFIND_TYPE = IS_SAME< U, float > ? BALL_MEMFIND_FLOAT
+                                : IS_SAME< U, double > ? BALL_MEMFIND_DOUBLE
+                                : !IS_BITWISE_COMPARABLE< U > ? ~0u
+                                : sizeof( U ) == 1 ? BALL_MEMFIND_UINT8
+                                : sizeof( U ) == 2 ? BALL_MEMFIND_UINT16
+                                : sizeof( U ) == 4 ? BALL_MEMFIND_UINT32
+                                : sizeof( U ) == 8 ? BALL_MEMFIND_UINT64 : ~0u;
+
+///-----------------------------------------------------------------------------
+/// @brief  Whether a search over @p nCount elements of T runs on the vector
+///         kernels (Ball_MemFind and co.): a MEMFIND_TYPE, at run time, and at
+///         least BALL_MEMFIND_MIN_SIZE bytes.
+///-----------------------------------------------------------------------------
+template < typename T, typename I >
+constexpr bool IsBulkFind( const I nCount ) noexcept
+{
+	if constexpr ( MEMFIND_TYPE< T > != ~0u )
+		return !__builtin_is_constant_evaluated() && static_cast< size_t >( nCount ) >= BALL_MEMFIND_MIN_SIZE / sizeof( T );
+	else
+		return false;
+}
+
+///-----------------------------------------------------------------------------
+/// @return Index of the first of @p nCount elements equal to @p value, or
+///         @p nCount when there is none.
+///-----------------------------------------------------------------------------
+template < typename T, typename I = size_t >
+constexpr I FindElement( const I nCount, const T *pElements, const T &value ) noexcept
+{
+	if ( IsBulkFind< T >( nCount ) )
+		return static_cast< I >( Ball_MemFind( pElements, static_cast< size_t >( nCount ), &value, MEMFIND_TYPE< T > ) );
+
+	I n = 0;
+
+	while ( n < nCount && !( pElements[ n ] == value ) )
+		++n;
+
+	return n;
+}
+
+///-----------------------------------------------------------------------------
+/// @return Index of the last of @p nCount elements equal to @p value, or
+///         @p nCount when there is none.
+///-----------------------------------------------------------------------------
+template < typename T, typename I = size_t >
+constexpr I RFindElement( const I nCount, const T *pElements, const T &value ) noexcept
+{
+	if ( IsBulkFind< T >( nCount ) )
+		return static_cast< I >( Ball_MemRFind( pElements, static_cast< size_t >( nCount ), &value, MEMFIND_TYPE< T > ) );
+
+	for ( I n = nCount; n > I( 0 ); --n )
+	{
+		if ( pElements[ n - 1 ] == value )
+			return n - 1;
+	}
+
+	return nCount;
+}
+
+///-----------------------------------------------------------------------------
+/// @return Number of the @p nCount elements equal to @p value.
+///-----------------------------------------------------------------------------
+template < typename T, typename I = size_t >
+constexpr I CountElements( const I nCount, const T *pElements, const T &value ) noexcept
+{
+	if ( IsBulkFind< T >( nCount ) )
+		return static_cast< I >( Ball_MemCount( pElements, static_cast< size_t >( nCount ), &value, MEMFIND_TYPE< T > ) );
+
+	I nFound = 0;
+
+	for ( I n = 0; n < nCount; ++n )
+	{
+		if ( pElements[ n ] == value )
+			++nFound;
+	}
+
+	return nFound;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Call @p fnFound( I index ) for each of the @p nCount elements equal
+///         to @p value, in order.
+/// @return Number of elements found.
+/// @note   The kernels store indices in batches of BATCH; each is delivered
+///         before the search goes on.
+///-----------------------------------------------------------------------------
+template < typename T, typename I = size_t, class F >
+constexpr I FindAllElements( const I nCount, const T *pElements, const T &value, F &&fnFound )
+{
+	if ( IsBulkFind< T >( nCount ) )
+	{
+		constexpr size_t BATCH = 256;
+
+		size_t aIndices[ BATCH ];
+		size_t nFrom = 0, nFound = 0;
+
+		for ( ; ; )
+		{
+			const size_t nBatch = Ball_MemFindAll( pElements + nFrom, static_cast< size_t >( nCount ) - nFrom, &value, MEMFIND_TYPE< T >, aIndices, BATCH );
+
+			for ( size_t n = 0; n < nBatch; n++ )
+				fnFound( static_cast< I >( nFrom + aIndices[ n ] ) );
+
+			nFound += nBatch;
+
+			if ( nBatch < BATCH )
+				return static_cast< I >( nFound );
+
+			nFrom += aIndices[ BATCH - 1 ] + 1;
+		}
+	}
+
+	I nFound = 0;
+
+	for ( I n = 0; n < nCount; ++n )
+	{
+		if ( pElements[ n ] == value )
+		{
+			fnFound( n );
+			++nFound;
+		}
+	}
+
+	return nFound;
+}
+
 #endif // !defined( _INCLUDE_BALL_TYPES_ELEMENTS_HPP_ )
@@ -0,0 +1,115 @@
+#ifndef _INCLUDE_BALL_TYPES_GROWTH_HPP_
+#	define _INCLUDE_BALL_TYPES_GROWTH_HPP_
+
+#	pragma once
+
+#	include "base/arch.h"
+#	include "c/math.h"
+#	include "meta/number.hpp"
+#	include "bits.hpp"
+
+// Growth policies of CVectorBase/CVectorBase_Growable (the G parameter). Each has
+//
+//   template < typename I >
+//   static constexpr I Capacity( I nCapacity, I nRequest, I nMin, size_t nElementSize ) noexcept;
+//
+// returning the capacity to allocate when @p nRequest elements do not fit the current
+// @p nCapacity: at least nRequest and nMin (the inline count of growable vectors), or
+// MNumber< I >::INVALID when no such capacity can be represented.
+
+///-----------------------------------------------------------------------------
+/// @brief Next power of two: the fewest reallocations, up to 50% slack (default).
+///-----------------------------------------------------------------------------
+class CGrowPowerOfTwo
+{
+public:
+	template < typename I >
+	static constexpr I Capacity( I nCapacity, I nRequest, I nMin, size_t nElementSize ) noexcept
+	{
+		( void )nCapacity;
+		( void )nElementSize;
+
+		return NextPowerOfTwo( BALL_MAX( nRequest, nMin ) );
+	}
+}; // class CGrowPowerOfTwo
+
+///-----------------------------------------------------------------------------
+/// @brief Grow by half the current capacity: about twice the reallocations of
+///        CGrowPowerOfTwo for at most 33% slack.
+///-----------------------------------------------------------------------------
+class CGrowOneAndHalf
+{
+public:
+	/// Capacity of the first block, so small vectors do not grow one by one.
+	static constexpr size_t MIN_CAPACITY = 4;
+
+	template < typename I >
+	static constexpr I Capacity( I nCapacity, I nRequest, I nMin, size_t nElementSize ) noexcept
+	{
+		( void )nElementSize;
+
+		using Number_t = MNumber< I >;
+
+		const I nGrown = nCapacity <= Number_t::MAX - nCapacity / 2 ? static_cast< I >( nCapacity + nCapacity / 2 ) : Number_t::MAX;
+		const I nNew = BALL_MAX( BALL_MAX( nGrown, nRequest ), nMin );
+
+		return BALL_MAX( nNew, static_cast< I >( MIN_CAPACITY ) );
+	}
+}; // class CGrowOneAndHalf
+
+///-----------------------------------------------------------------------------
+/// @brief Powers of two up to @p PAGE bytes, then CGrowOneAndHalf rounded up to
+///        whole pages: large mapped blocks end on a page boundary, so the
+///        tail of their last page is used rather than wasted.
+///-----------------------------------------------------------------------------
+template < size_t PAGE = 4096 >
+class CGrowPages
+{
+public:
+	static_assert( ( PAGE & ( PAGE - 1 ) ) == 0, "CGrowPages: page size must be a power of two" );
+
+	template < typename I >
+	static constexpr I Capacity( I nCapacity, I nRequest, I nMin, size_t nElementSize ) noexcept
+	{
+		using Number_t = MNumber< I >;
+
+		if ( static_cast< size_t >( nRequest ) <= PAGE / nElementSize )
+			return CGrowPowerOfTwo::Capacity( nCapacity, nRequest, nMin, nElementSize );
+
+		const I nNew = CGrowOneAndHalf::Capacity( nCapacity, nRequest, nMin, nElementSize );
+
+		if ( static_cast< size_t >( nNew ) > ( ~static_cast< size_t >( 0 ) - PAGE ) / nElementSize )
+			return nNew;
+
+		const size_t nCount = BALL_ROUND_UP( static_cast< size_t >( nNew ) * nElementSize, PAGE ) / nElementSize;
+
+		return nCount < static_cast< size_t >( Number_t::MAX ) ? static_cast< I >( nCount ) : nNew;
+	}
+}; // class CGrowPages
+
+///-----------------------------------------------------------------------------
+/// @brief Doubling from the current capacity clamped to [MIN, MAX] elements
+///        (see NextDoublingCapacityT); past MAX the growth fails.
+///-----------------------------------------------------------------------------
+template < size_t MIN = 1, size_t MAX = ~static_cast< size_t >( 0 ) >
+class CGrowDoubling
+{
+public:
+	static_assert( 0 < MIN && MIN <= MAX, "CGrowDoubling: 0 < MIN <= MAX" );
+
+	template < typename I >
+	static constexpr I Capacity( I nCapacity, I nRequest, I nMin, size_t nElementSize ) noexcept
+	{
+		( void )nElementSize;
+
+		using Number_t = MNumber< I >;
+
+		const I nMaxCount = MAX < static_cast< size_t >( Number_t::MAX ) ? static_cast< I >( MAX ) : Number_t::MAX;
+		const I nMinCount = MIN < static_cast< size_t >( nMaxCount ) ? static_cast< I >( MIN ) : nMaxCount;
+		const I nNew = NextDoublingCapacityT( nCapacity, nRequest, BALL_MAX( nMinCount, nMin ), nMaxCount );
+
+		return nNew < nRequest ? Number_t::INVALID : nNew;
+	}
+}; // class CGrowDoubling
+
+#endif // !defined( _INCLUDE_BALL_TYPES_GROWTH_HPP_ )
@@ -0,0 +1,409 @@
+#ifndef _INCLUDE_BALL_TYPES_MAPPEDVECTOR_HPP_
+#	define _INCLUDE_BALL_TYPES_MAPPEDVECTOR_HPP_
+
+#	pragma once
+
+#	include "base/arch.h"
+#	include "c/assert.h"
+#	include "c/file.h"
+#	include "c/math.h"
+#	include "c/mmap.h"
+#	include "memoryaligned.h"
+#	include "meta/number.hpp"
+#	include "memoryview.hpp"
+#	include "vector.hpp"
+
+// ===============================
+// CVectorBase_Mapped (storage is a memory-mapped file)
+// ===============================
+///-----------------------------------------------------------------------------
+/// @brief Vector storage backed by a file mapping.
+/// @note  File layout: one HEADER_SIZE page (magic, element size, count)
+///        followed by the elements, so the data is usable straight from the
+///        mapping without any load step. Elements must be trivially copyable.
+///
+/// Modes:
+///   - MODE_READ_ONLY:     PROT_READ view of an existing file; cannot grow or
+///                         change (mutating calls assert, and elements must
+///                         only be read, e.g. through a const reference).
+///   - MODE_COPY_ON_WRITE: private writable view; changes never reach the file.
+///                         The first growth copies it into anonymous memory.
+///   - MODE_SHARED:        writable view of a file created on demand; grows
+///                         by ftruncate + mremap, persisted by Flush()/Close().
+///-----------------------------------------------------------------------------
+template < class B, typename I, typename T >
+class CVectorBase_Mapped : public B
+{
+public:
+	using Base_t =      B;
+	using Index_t =     I;
+	using Element_t =   T;
+	using Number_t =    MNumber< Index_t >;
+	using Unsigned_t =  typename Number_t::U;
+	using View_t =      Base_t;
+	using ConstView_t = typename Base_t::Const_t;
+
+	using Base_t::Base_t;
+	using Base_t::Count;
+	using Base_t::Data;
+
+	static_assert( __is_trivially_copyable( T ), "CVectorBase_Mapped requires trivially copyable elements" );
+
+	static constexpr bool IS_GROWABLE = false;
+	static constexpr I INVALID_INDEX = Number_t::INVALID;
+
+	static constexpr uint32_t MODE_READ_ONLY =     0;
+	static constexpr uint32_t MODE_COPY_ON_WRITE = 1;
+	static constexpr uint32_t MODE_SHARED =        2;
+
+	static constexpr uint32_t MAGIC =       0x4D564543; // "MVEC" (without null-terminated)
+	static constexpr uint32_t VERSION =     1;
+	static constexpr size_t   HEADER_SIZE = 4096;
+
+	static_assert( alignof( T ) <= HEADER_SIZE, "CVectorBase_Mapped: element alignment exceeds the header page" );
+
+	struct Header_t
+	{
+		uint32_t nMagic;
+		uint32_t nVersion;
+		uint64_t nElementSize;
+		uint64_t nCount;
+	}; // struct Header_t
+
+	constexpr ~CVectorBase_Mapped() noexcept
+	{
+		Close();
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Elements that fit without growing: none past Count() for read-only
+	///        views, the file length (not the page-rounded mapping, whose tail
+	///        past EOF is never written back) in shared mode.
+	///-----------------------------------------------------------------------------
+	constexpr I Capacity() const noexcept
+	{
+		if ( !m_pMap )
+			return I( 0 );
+
+		if ( m_nMode == MODE_READ_ONLY )
+			return Count();
+
+		const size_t nLength = m_nMode == MODE_SHARED ? m_nFileLength : m_nMapLength;
+
+		return static_cast< I >( ( nLength - HEADER_SIZE ) / sizeof( T ) );
+	}
+	constexpr size_t CapacitySize() const noexcept { return static_cast< size_t >( Capacity() ) * sizeof( Element_t ); }
+
+	bool IsOpen() const noexcept { return m_pMap != nullptr; }
+	uint32_t Mode() const noexcept { return m_nMode; }
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Map @p pszPath in @p nMode (see class notes); closes any previous file.
+	/// @return false when the file cannot be opened/created or its header does not
+	///         match this element type.
+	///-----------------------------------------------------------------------------
+	bool Open( const char *pszPath, uint32_t nMode = MODE_SHARED )
+	{
+		Close();
+
+		const bool bShared = nMode == MODE_SHARED;
+		const int nFD = bShared ? open( pszPath, BALL_O_RDWR | BALL_O_CREAT | BALL_O_CLOEXEC, 0644 )
+		                        : open( pszPath, BALL_O_RDONLY | BALL_O_CLOEXEC );
+
+		if ( nFD < 0 )
+			return false;
+
+		long nFileSize = lseek( nFD, 0, BALL_SEEK_END );
+		const bool bCreate = bShared && nFileSize < static_cast< long >( HEADER_SIZE );
+
+		if ( bCreate )
+		{
+			nFileSize = static_cast< long >( HEADER_SIZE );
+
+			if ( ftruncate( nFD, nFileSize ) != 0 )
+				nFileSize = -1;
+		}
+
+		if ( nFileSize < static_cast< long >( HEADER_SIZE ) )
+		{
+			( void )close( nFD );
+
+			return false;
+		}
+
+		const size_t nMapLength = BALL_ROUND_UP( static_cast< size_t >( nFileSize ), Ball_PageSize() );
+		const int nProt = nMode == MODE_READ_ONLY ? BALL_PROT_READ : BALL_PROT_READ | BALL_PROT_WRITE;
+
+		void *pMap = mmap( nullptr, nMapLength, nProt, bShared ? BALL_MAP_SHARED : BALL_MAP_PRIVATE, nFD, 0 );
+
+		if ( pMap == BALL_MAP_FAILED )
+		{
+			( void )close( nFD );
+
+			return false;
+		}
+
+		Header_t *pHeader = reinterpret_cast< Header_t * >( pMap );
+
+		if ( bCreate )
+		{
+			pHeader->nMagic = MAGIC;
+			pHeader->nVersion = VERSION;
+			pHeader->nElementSize = sizeof( T );
+			pHeader->nCount = 0;
+		}
+
+		const uint64_t nMaxCount = ( static_cast< uint64_t >( nFileSize ) - HEADER_SIZE ) / sizeof( T );
+
+		if ( pHeader->nMagic != MAGIC || pHeader->nVersion != VERSION ||
+		     pHeader->nElementSize != sizeof( T ) || pHeader->nCount > nMaxCount ||
+		     pHeader->nCount > static_cast< uint64_t >( Number_t::MAX ) )
+		{
+			( void )munmap( pMap, nMapLength );
+			( void )close( nFD );
+
+			return false;
+		}
+
+		m_nFD = nFD;
+		m_nMode = nMode;
+		m_pMap = reinterpret_cast< uchar_t * >( pMap );
+		m_nMapLength = nMapLength;
+		m_nFileLength = static_cast< size_t >( nFileSize );
+
+		Set( static_cast< I >( pHeader->nCount ), Elements() );
+
+		return true;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Persist the element count and write dirty pages back (shared mode).
+	/// @param  bAsync Schedule the write-back (MS_ASYNC) instead of waiting for it.
+	/// @return false on msync failure; true (no-op) for the other modes.
+	///-----------------------------------------------------------------------------
+	bool Flush( bool bAsync = false )
+	{
+		if ( !m_pMap || m_nMode != MODE_SHARED )
+			return true;
+
+		reinterpret_cast< Header_t * >( m_pMap )->nCount = static_cast< uint64_t >( Count() );
+
+		return msync( m_pMap, m_nMapLength, bAsync ? BALL_MS_ASYNC : BALL_MS_SYNC ) == 0;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Persist the count (shared mode), unmap and close the file.
+	/// @note  Dirty pages are written back by the kernel; call Flush() first when
+	///        the data must be on disk before continuing.
+	///-----------------------------------------------------------------------------
+	void Close() noexcept
+	{
+		if ( m_pMap )
+		{
+			if ( m_nMode == MODE_SHARED )
+				reinterpret_cast< Header_t * >( m_pMap )->nCount = static_cast< uint64_t >( Count() );
+
+			( void )munmap( m_pMap, m_nMapLength );
+
+			if ( m_nFD >= 0 )
+				( void )close( m_nFD );
+		}
+
+		m_nFD = -1;
+		m_pMap = nullptr;
+		m_nMapLength = 0;
+		m_nFileLength = 0;
+
+		Set( 0, nullptr );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Shrink the mapping (and in shared mode the file) to the pages that
+	///        hold Count() elements. A copy-on-write view still backed by the file
+	///        and a read-only view are left as they are.
+	///-----------------------------------------------------------------------------
+	void ShrinkToFit()
+	{
+		if ( !m_pMap || m_nMode == MODE_READ_ONLY || ( m_nMode == MODE_COPY_ON_WRITE && m_nFD >= 0 ) )
+			return;
+
+		const size_t nNewLength = BALL_ROUND_UP( HEADER_SIZE + static_cast< size_t >( Count() ) * sizeof( T ), Ball_PageSize() );
+
+		if ( nNewLength >= m_nMapLength )
+			return;
+
+		// Shrinking in place does not move the mapping.
+		if ( mremap( m_pMap, m_nMapLength, nNewLength, 0 ) == BALL_MAP_FAILED )
+			return;
+
+		m_nMapLength = nNewLength;
+
+		if ( m_nMode == MODE_SHARED && ftruncate( m_nFD, static_cast< long >( nNewLength ) ) == 0 )
+			m_nFileLength = nNewLength;
+	}
+
+protected:
+	using Base_t::Set;
+
+	///-----------------------------------------------------------------------------
+	/// @brief Ensure the mapping can hold at least @p nRequestCapacity elements
+	///        (rounded up to a power of two, then to whole pages).
+	/// @note  Shared mode extends the file first (ftruncate) and then, unless the
+	///        new length still fits its last page, the mapping (mremap, may move);
+	///        copy-on-write mode copies into anonymous memory
+	///        once and grows that by mremap from then on. Read-only and closed
+	///        vectors cannot grow (asserts, returns the current storage). Every
+	///        insert, replace or resize of a read-only view comes through here
+	///        and asserts, even within Count() (only clearing it is allowed).
+	///-----------------------------------------------------------------------------
+	T *EnsureCapacity( I nRequestCapacity )
+	{
+		T *pElements = Data();
+
+		BALL_ASSERT_MESSAGE( !m_pMap || m_nMode != MODE_READ_ONLY || nRequestCapacity == 0, "Mapped vector is read-only" );
+
+		if ( nRequestCapacity <= Capacity() )
+			return pElements;
+
+		BALL_ASSERT_MESSAGE( m_pMap && m_nMode != MODE_READ_ONLY, "Mapped vector is closed or read-only" );
+
+		if ( !m_pMap || m_nMode == MODE_READ_ONLY )
+			return pElements;
+
+		const I nNewCapacity = NextPowerOfTwo( nRequestCapacity );
+
+		BALL_ASSERT_MESSAGE( nNewCapacity != Number_t::INVALID, "Capacity overflow!" );
+
+		if ( nNewCapacity == Number_t::INVALID )
+			return pElements;
+
+		const size_t nNewLength = BALL_ROUND_UP( HEADER_SIZE + static_cast< size_t >( nNewCapacity ) * sizeof( T ), Ball_PageSize() );
+
+		if ( m_nMode == MODE_SHARED )
+		{
+			if ( ftruncate( m_nFD, static_cast< long >( nNewLength ) ) != 0 )
+			{
+				BALL_ASSERT_MESSAGE( false, "Failed to extend mapped file" );
+
+				return pElements;
+			}
+
+			m_nFileLength = nNewLength;
+
+			if ( nNewLength <= m_nMapLength )
+				return Elements();
+		}
+
+		void *pMap;
+
+		if ( m_nMode == MODE_COPY_ON_WRITE && m_nFD >= 0 )
+		{
+			// A private file mapping cannot grow past the end of the file (SIGBUS),
+			// so the first growth detaches into anonymous memory and drops the file.
+			pMap = mmap( nullptr, nNewLength, BALL_PROT_READ | BALL_PROT_WRITE, BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS, -1, 0 );
+
+			if ( pMap != BALL_MAP_FAILED )
+			{
+				CopyElements( m_nMapLength, reinterpret_cast< uchar_t * >( pMap ), m_pMap );
+				( void )munmap( m_pMap, m_nMapLength );
+				( void )close( m_nFD );
+				m_nFD = -1;
+			}
+		}
+		else
+		{
+			pMap = mremap( m_pMap, m_nMapLength, nNewLength, BALL_MREMAP_MAYMOVE );
+		}
+
+		BALL_ASSERT_MESSAGE( pMap != BALL_MAP_FAILED, "Failed to extend file mapping" );
+
+		if ( pMap == BALL_MAP_FAILED )
+			return pElements;
+
+		uchar_t *pNewMap = reinterpret_cast< uchar_t * >( pMap );
+
+		m_pMap = pNewMap;
+		m_nMapLength = nNewLength;
+
+		return Elements();
+	}
+
+	/// @brief Copy contents from another view (replaces the current elements).
+	CVectorBase_Mapped &CopyFrom( const CMemoryView< I, T > &other )
+	{
+		const I nNewCount = other.Count();
+
+		T *pElements = EnsureCapacity( nNewCount );
+
+		if ( nNewCount > 0 && nNewCount <= Capacity() )
+		{
+			CopyElements( nNewCount, pElements, other.Data() );
+			Set( nNewCount, pElements );
+		}
+
+		return *this;
+	}
+
+	/// @brief Take over @p other's file and mapping.
+	CVectorBase_Mapped &MoveFrom( CVectorBase_Mapped &&other ) noexcept
+	{
+		if ( this != &other )
+		{
+			Base_t::Swap( other );
+			Math_Swap( m_nFD, other.m_nFD );
+			Math_Swap( m_nMode, other.m_nMode );
+			Math_Swap( m_pMap, other.m_pMap );
+			Math_Swap( m_nMapLength, other.m_nMapLength );
+			Math_Swap( m_nFileLength, other.m_nFileLength );
+		}
+
+		return *this;
+	}
+
+private:
+	T *Elements() noexcept { return reinterpret_cast< T * >( m_pMap + HEADER_SIZE ); }
+
+	int      m_nFD = -1;
+	uint32_t m_nMode = MODE_READ_ONLY;
+	uchar_t *m_pMap = nullptr;
+	size_t   m_nMapLength = 0;
+	size_t   m_nFileLength = 0; // Bytes of the file (shared mode writes reach only these).
+}; // class CVectorBase_Mapped
+
+///-----------------------------------------------------------------------------
+/// @brief Vector whose elements live in a memory-mapped file (see CVectorBase_Mapped).
+///-----------------------------------------------------------------------------
+template < typename I, typename T >
+class CMappedVector : public CVectorImpl< CVectorBase_Mapped< CMemoryView< I, T >, I, T >, I, T >
+{
+public:
+	using Base_t = CVectorImpl< CVectorBase_Mapped< CMemoryView< I, T >, I, T >, I, T >;
+
+	CMappedVector() noexcept = default;
+
+	explicit CMappedVector( const char *pszPath, uint32_t nMode = Base_t::MODE_SHARED )
+	{
+		Base_t::Open( pszPath, nMode );
+	}
+
+	// Close before CVectorImpl destroys the elements, so the stored count survives.
+	~CMappedVector() noexcept { Base_t::Close(); }
+
+	/// @brief CVectorImpl::Remove, which shifts the tail without EnsureCapacity():
+	///        refused (asserts, returns INVALID_INDEX) for a read-only view.
+	I Remove( const I nIndex, const I n = 1 )
+	{
+		const bool bReadOnly = Base_t::IsOpen() && Base_t::Mode() == Base_t::MODE_READ_ONLY;
+
+		BALL_ASSERT_MESSAGE( !bReadOnly, "Mapped vector is read-only" );
+
+		if ( bReadOnly )
+			return Base_t::INVALID_INDEX;
+
+		return Base_t::Remove( nIndex, n );
+	}
+};
+
+template < typename T > using MappedVector_t =      CMappedVector< size_t, T >;
+
+#endif // !defined( _INCLUDE_BALL_TYPES_MAPPEDVECTOR_HPP_ )
@@ -4,20 +4,56 @@
 #	include "base/arch.h"
 #	include "base/fixed.h"
 
+/// Back large mappings with 2 MiB pages (MAP_HUGETLB, else THP via madvise).
+#	define BALL_ALLOC_HUGEPAGE 0x1u
+
+/// Fault the pages in when mapping them (and on growth), not on first write.
+#	define BALL_ALLOC_POPULATE 0x2u
+
+/// Follow the requested size with BALL_ALLOC_PADDING readable bytes (kept
+/// through reallocs), so vector loads may run past the end of the data.
+#	define BALL_ALLOC_PADDED 0x4u
+
+/// Padding of BALL_ALLOC_PADDED blocks: one 512-bit vector.
+#	define BALL_ALLOC_PADDING ( ( size_t )64u )
+
+/// Huge page size used by BALL_ALLOC_HUGEPAGE; smaller mappings use regular pages.
+#	define BALL_HUGEPAGE_SIZE ( ( size_t )2u << 20 )
+
 #	if defined( _WIN32 )
 #		include "c/memoryaligned.h"
 
 inline ptr_t Ball_AllocAlign( size_t nSize, size_t nAlign ) { return _aligned_malloc( nSize, nAlign ); }
+inline ptr_t Ball_AllocAlignEx( size_t nSize, size_t nAlign, uint32_t ) { return _aligned_malloc( nSize, nAlign ); }
 inline void Ball_FreeAlign( ptr_t pMem ) { return _aligned_free( pMem ); }
 inline ptr_t Ball_ReallocAlign( ptr_t pMem, size_t nSize, size_t nAlign ) { return _aligned_realloc( pMem, nSize, nAlign ); }
 inline size_t Ball_MemSize( ptr_t pMem, size_t nAlign, size_t nOffset ) { return _aligned_msize( pMem, nAlign, nOffset ); }
+inline size_t Ball_MemUsableSize( ptr_t pMem, size_t nAlign, size_t nOffset ) { return _aligned_msize( pMem, nAlign, nOffset ); }
+inline size_t Ball_MemCacheTrim( size_t ) { return 0; }
+inline void Ball_MemPopulate( ptr_t, size_t ) {}
+inline ptr_t Ball_ReserveAlign( size_t, size_t, uint32_t ) { return BALL_NULL; }
+inline size_t Ball_PageSize() { return 4096u; }
+inline bool_t Ball_AllocBatch( ptr_t *ppBlocks, const size_t *pCounts, size_t nCount, size_t nUnit, size_t nAlign, uint32_t )
+{
+	for ( size_t n = 0; n < nCount; n++ )
+		ppBlocks[ n ] = pCounts[ n ] ? _aligned_malloc( pCounts[ n ] * nUnit, nAlign ) : BALL_NULL;
+
+	return 1;
+}
 #	else // !defined( _WIN32 )
 #		include "c/macros.h"
 
 BALL_EXTERN_C ptr_t Ball_AllocAlign( size_t nSize, size_t nAlign );
+BALL_EXTERN_C ptr_t Ball_AllocAlignEx( size_t nSize, size_t nAlign, uint32_t nFlags );
 BALL_EXTERN_C void Ball_FreeAlign( ptr_t pMem );
 BALL_EXTERN_C ptr_t Ball_ReallocAlign( ptr_t pMem, size_t nSize, size_t nAlign );
 BALL_EXTERN_C size_t Ball_MemSize( ptr_t pMem, size_t nAlign, size_t nOffset );
+BALL_EXTERN_C size_t Ball_MemUsableSize( ptr_t pMem, size_t nAlign, size_t nOffset );
+BALL_EXTERN_C size_t Ball_MemCacheTrim( size_t nMaxBytes );
+BALL_EXTERN_C void Ball_MemPopulate( ptr_t pMem, size_t nSize );
+BALL_EXTERN_C ptr_t Ball_ReserveAlign( size_t nMaxSize, size_t nAlign, uint32_t nFlags );
+BALL_EXTERN_C bool_t Ball_AllocBatch( ptr_t *ppBlocks, const size_t *pCounts, size_t nCount, size_t nUnit, size_t nAlign, uint32_t nFlags );
+BALL_EXTERN_C size_t Ball_PageSize( void );
 #	endif // defined( _WIN32 )
 
 #endif // !defined( _INCLUDE_BALL_TYPES_MEMORYALIGNED_H_ )
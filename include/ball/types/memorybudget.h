@@ -0,0 +1,63 @@
+#ifndef _INCLUDE_BALL_TYPES_MEMORYBUDGET_H_
+#	define _INCLUDE_BALL_TYPES_MEMORYBUDGET_H_
+
+#	include "base/arch.h"
+#	include "base/fixed.h"
+#	include "c/macros.h"
+
+struct Ball_MemBudget_t;
+
+/// Called on the allocating thread right after the allocation that pushed a budget past its soft limit.
+typedef void ( *Ball_MemPressureFn_t )( struct Ball_MemBudget_t *pBudget, void *pContext );
+
+///-----------------------------------------------------------------------------
+/// @brief Pressure callback registration; the node is owned by the caller and
+///        must outlive the budget it is added to.
+///-----------------------------------------------------------------------------
+struct Ball_MemPressureHook_t
+{
+	Ball_MemPressureFn_t           pfnPressure;
+	void                          *pContext;
+	struct Ball_MemPressureHook_t *pNext;         ///< Managed by Ball_MemBudgetAddHook.
+}; // struct Ball_MemPressureHook_t
+
+///-----------------------------------------------------------------------------
+/// @brief Named accounting scope for mapped memory (Ball_*Align blocks).
+/// @note
+///   * A block is charged its mapping length to the calling thread's current
+///     budget (Ball_MemBudgetSwap) and to every ancestor, and credited back to
+///     the same budgets when it is freed, whichever thread frees it.
+///   * An allocation that would take any budget in the chain past its hard
+///     limit fails (returns BALL_NULL). Crossing a soft limit succeeds and
+///     then runs that budget's hooks once; they re-arm when usage drops back
+///     below the soft limit.
+///   * Slab-served small blocks are not charged.
+///   * Limits of 0 mean "none". Storage is owned by the caller; a budget must
+///     outlive every block charged to it.
+///-----------------------------------------------------------------------------
+struct Ball_MemBudget_t
+{
+	const char                    *pszName;
+	struct Ball_MemBudget_t       *pParent;
+	uint64_t                       nSoftLimit;
+	uint64_t                       nHardLimit;
+	uint64_t                       nUsed;         ///< Bytes currently charged (atomic).
+	uint64_t                       nPeak;         ///< High-water mark of nUsed (atomic).
+	uint64_t                       nDenied;       ///< Allocations refused by the hard limit (atomic).
+	struct Ball_MemPressureHook_t *pHooks;        ///< Pushed atomically, never removed.
+}; // struct Ball_MemBudget_t
+
+#	if defined( _WIN32 )
+inline void Ball_MemBudgetInit( struct Ball_MemBudget_t *pBudget, const char *pszName, struct Ball_MemBudget_t *pParent, uint64_t nSoftLimit, uint64_t nHardLimit )
+{
+	*pBudget = { pszName, pParent, nSoftLimit, nHardLimit, 0, 0, 0, BALL_NULL };
+}
+inline void Ball_MemBudgetAddHook( struct Ball_MemBudget_t *pBudget, struct Ball_MemPressureHook_t *pHook ) { pHook->pNext = pBudget->pHooks; pBudget->pHooks = pHook; }
+inline struct Ball_MemBudget_t *Ball_MemBudgetSwap( struct Ball_MemBudget_t * ) { return BALL_NULL; }
+#	else // !defined( _WIN32 )
+BALL_EXTERN_C void Ball_MemBudgetInit( struct Ball_MemBudget_t *pBudget, const char *pszName, struct Ball_MemBudget_t *pParent, uint64_t nSoftLimit, uint64_t nHardLimit );
+BALL_EXTERN_C void Ball_MemBudgetAddHook( struct Ball_MemBudget_t *pBudget, struct Ball_MemPressureHook_t *pHook );
+BALL_EXTERN_C struct Ball_MemBudget_t *Ball_MemBudgetSwap( struct Ball_MemBudget_t *pBudget );
+#	endif // defined( _WIN32 )
+
+#endif // !defined( _INCLUDE_BALL_TYPES_MEMORYBUDGET_H_ )
@@ -0,0 +1,62 @@
+#ifndef _INCLUDE_BALL_TYPES_MEMORYBUDGET_HPP_
+#	define _INCLUDE_BALL_TYPES_MEMORYBUDGET_HPP_
+
+#	pragma once
+
+#	include "base/arch.h"
+#	include "c/atomic.h"
+#	include "memorybudget.h"
+
+///-----------------------------------------------------------------------------
+/// @brief Named memory budget (see Ball_MemBudget_t): mapped memory allocated
+///        inside a CMemoryBudgetScope is charged to it and to its parents.
+/// @note  Must outlive every block charged to it; not copyable or movable,
+///        since blocks and child budgets point at it.
+///-----------------------------------------------------------------------------
+class CMemoryBudget
+{
+public:
+	using Hook_t = Ball_MemPressureHook_t;
+
+	explicit CMemoryBudget( const char *pszName, uint64_t nSoftLimit = 0, uint64_t nHardLimit = 0, CMemoryBudget *pParent = nullptr ) noexcept
+	{
+		Ball_MemBudgetInit( &m_Budget, pszName, pParent ? &pParent->m_Budget : nullptr, nSoftLimit, nHardLimit );
+	}
+
+	CMemoryBudget( const CMemoryBudget & ) = delete;
+	CMemoryBudget &operator=( const CMemoryBudget & ) = delete;
+
+	const char *Name() const noexcept { return m_Budget.pszName; }
+	uint64_t SoftLimit() const noexcept { return m_Budget.nSoftLimit; }
+	uint64_t HardLimit() const noexcept { return m_Budget.nHardLimit; }
+
+	uint64_t Used() const noexcept { return BALL_ATOMIC_LOAD( &m_Budget.nUsed, BALL_ATOMIC_RELAXED ); }
+	uint64_t Peak() const noexcept { return BALL_ATOMIC_LOAD( &m_Budget.nPeak, BALL_ATOMIC_RELAXED ); }
+	uint64_t Denied() const noexcept { return BALL_ATOMIC_LOAD( &m_Budget.nDenied, BALL_ATOMIC_RELAXED ); }
+
+	/// @brief Run @p hook (caller-owned, must outlive the budget) when the soft limit is crossed.
+	void AddHook( Hook_t &hook ) noexcept { Ball_MemBudgetAddHook( &m_Budget, &hook ); }
+
+	Ball_MemBudget_t *Get() noexcept { return &m_Budget; }
+
+private:
+	Ball_MemBudget_t m_Budget;
+}; // class CMemoryBudget
+
+///-----------------------------------------------------------------------------
+/// @brief Charges the calling thread's mappings to a budget for its lifetime.
+///-----------------------------------------------------------------------------
+class CMemoryBudgetScope
+{
+public:
+	explicit CMemoryBudgetScope( CMemoryBudget &budget ) noexcept : m_pPrevious( Ball_MemBudgetSwap( budget.Get() ) ) {}
+	~CMemoryBudgetScope() noexcept { Ball_MemBudgetSwap( m_pPrevious ); }
+
+	CMemoryBudgetScope( const CMemoryBudgetScope & ) = delete;
+	CMemoryBudgetScope &operator=( const CMemoryBudgetScope & ) = delete;
+
+private:
+	Ball_MemBudget_t *m_pPrevious;
+}; // class CMemoryBudgetScope
+
+#endif // !defined( _INCLUDE_BALL_TYPES_MEMORYBUDGET_HPP_ )
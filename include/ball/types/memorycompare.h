@@ -0,0 +1,37 @@
+#ifndef _INCLUDE_BALL_TYPES_MEMORYCOMPARE_H_
+#	define _INCLUDE_BALL_TYPES_MEMORYCOMPARE_H_
+
+#	include "base/arch.h"
+#	include "base/fixed.h"
+#	include "c/macros.h"
+#	include "memorycopy.h"
+
+// Comparison kernels use the vector width of Ball_MemCopyKernel() (BALL_MEMCOPY_*).
+
+/// Smallest run (bytes) the element comparisons hand to the kernels; shorter ones stay inline loops.
+#	define BALL_MEMCOMPARE_MIN_SIZE ( ( size_t )32u )
+
+#	if defined( _WIN32 )
+inline size_t Ball_MemMismatch( const void *pLeft, const void *pRight, size_t nSize )
+{
+	const uchar_t *pL = ( const uchar_t * )pLeft, *pR = ( const uchar_t * )pRight;
+	size_t n = 0;
+
+	while ( n < nSize && pL[ n ] == pR[ n ] )
+		n++;
+
+	return n;
+}
+
+inline int Ball_MemCompare( const void *pLeft, const void *pRight, size_t nSize )
+{
+	const size_t n = Ball_MemMismatch( pLeft, pRight, nSize );
+
+	return n == nSize ? 0 : ( ( const uchar_t * )pLeft )[ n ] < ( ( const uchar_t * )pRight )[ n ] ? -1 : 1;
+}
+#	else // !defined( _WIN32 )
+BALL_EXTERN_C size_t Ball_MemMismatch( const void *pLeft, const void *pRight, size_t nSize );
+BALL_EXTERN_C int Ball_MemCompare( const void *pLeft, const void *pRight, size_t nSize );
+#	endif // defined( _WIN32 )
+
+#endif // !defined( _INCLUDE_BALL_TYPES_MEMORYCOMPARE_H_ )
@@ -0,0 +1,44 @@
+#ifndef _INCLUDE_BALL_TYPES_MEMORYCOPY_H_
+#	define _INCLUDE_BALL_TYPES_MEMORYCOPY_H_
+
+#	include "base/arch.h"
+#	include "base/fixed.h"
+#	include "c/macros.h"
+
+/// Kernel sets of Ball_MemMove, by vector width. The widest one the CPU (and OS) supports is used.
+#	define BALL_MEMCOPY_SYSTEM 0u // The C library memmove (fallback off x86).
+#	define BALL_MEMCOPY_SSE2   1u // 16-byte vectors.
+#	define BALL_MEMCOPY_AVX2   2u // 32-byte vectors.
+#	define BALL_MEMCOPY_AVX512 3u // 64-byte vectors (AVX-512 F and BW).
+
+/// Smallest copy (bytes) CopyElements hands to Ball_MemMove; shorter ones stay inline loops.
+#	define BALL_MEMCOPY_MIN_SIZE ( ( size_t )128u )
+
+/// Default Ball_MemCopyTune size: disjoint copies from here on stream past the
+/// cache (non-temporal stores) and are split across threads.
+#	define BALL_MEMCOPY_LARGE_SIZE ( ( size_t )16u << 20 )
+
+/// Default and most threads (the caller included) one large copy is split across.
+#	define BALL_MEMCOPY_THREADS     4u
+#	define BALL_MEMCOPY_MAX_THREADS 16u
+
+/// Smallest share of a large copy given to one thread.
+#	define BALL_MEMCOPY_THREAD_SIZE ( ( size_t )4u << 20 )
+
+#	if defined( _WIN32 )
+inline ptr_t Ball_MemMove( ptr_t pDest, const void *pSrc, size_t nSize ) { return __builtin_memmove( pDest, pSrc, nSize ); }
+inline uint32_t Ball_MemCopyKernel() { return BALL_MEMCOPY_SYSTEM; }
+inline uint32_t Ball_MemCopySetKernel( uint32_t ) { return BALL_MEMCOPY_SYSTEM; }
+inline ptr_t Ball_MemCopy( ptr_t pDest, const void *pSrc, size_t nSize ) { return __builtin_memcpy( pDest, pSrc, nSize ); }
+inline void Ball_MemCopyTune( size_t, uint32_t ) {}
+inline void Ball_MemCopyTuning( size_t *pLargeSize, uint32_t *pThreads ) { *pLargeSize = ~( size_t )0u; *pThreads = 1; }
+#	else // !defined( _WIN32 )
+BALL_EXTERN_C ptr_t Ball_MemMove( ptr_t pDest, const void *pSrc, size_t nSize );
+BALL_EXTERN_C uint32_t Ball_MemCopyKernel( void );
+BALL_EXTERN_C uint32_t Ball_MemCopySetKernel( uint32_t nKernel );
+BALL_EXTERN_C ptr_t Ball_MemCopy( ptr_t pDest, const void *pSrc, size_t nSize );
+BALL_EXTERN_C void Ball_MemCopyTune( size_t nLargeSize, uint32_t nThreads );
+BALL_EXTERN_C void Ball_MemCopyTuning( size_t *pLargeSize, uint32_t *pThreads );
+#	endif // defined( _WIN32 )
+
+#endif // !defined( _INCLUDE_BALL_TYPES_MEMORYCOPY_H_ )
@@ -0,0 +1,88 @@
+#ifndef _INCLUDE_BALL_TYPES_MEMORYFIND_H_
+#	define _INCLUDE_BALL_TYPES_MEMORYFIND_H_
+
+#	include "base/arch.h"
+#	include "base/fixed.h"
+#	include "c/macros.h"
+#	include "memorycopy.h"
+
+// Search kernels use the vector width of Ball_MemCopyKernel() (BALL_MEMCOPY_*).
+
+/// Element types of the search kernels: integers (and anything equal exactly when its bytes are) by
+/// size, and floating point compared as such (+0 finds -0, NaN is never found).
+#	define BALL_MEMFIND_UINT8  0u
+#	define BALL_MEMFIND_UINT16 1u
+#	define BALL_MEMFIND_UINT32 2u
+#	define BALL_MEMFIND_UINT64 3u
+#	define BALL_MEMFIND_FLOAT  4u
+#	define BALL_MEMFIND_DOUBLE 5u
+#	define BALL_MEMFIND_TYPES  6u
+
+/// Smallest run (bytes) the element searches hand to the kernels; shorter ones stay inline loops.
+#	define BALL_MEMFIND_MIN_SIZE ( ( size_t )64u )
+
+#	if defined( _WIN32 )
+inline bool_t Ball_MemFindIsEqual( const void *pData, size_t n, const void *pValue, uint32_t nType )
+{
+	switch ( nType )
+	{
+	case BALL_MEMFIND_UINT8:  return ( ( const uint8_t * )pData )[ n ] == *( const uint8_t * )pValue;
+	case BALL_MEMFIND_UINT16: return ( ( const uint16_t * )pData )[ n ] == *( const uint16_t * )pValue;
+	case BALL_MEMFIND_UINT32: return ( ( const uint32_t * )pData )[ n ] == *( const uint32_t * )pValue;
+	case BALL_MEMFIND_UINT64: return ( ( const uint64_t * )pData )[ n ] == *( const uint64_t * )pValue;
+	case BALL_MEMFIND_FLOAT:  return ( ( const float * )pData )[ n ] == *( const float * )pValue;
+	default:                  return ( ( const double * )pData )[ n ] == *( const double * )pValue;
+	}
+}
+
+inline size_t Ball_MemFind( const void *pData, size_t nCount, const void *pValue, uint32_t nType )
+{
+	size_t n = 0;
+
+	while ( n < nCount && !Ball_MemFindIsEqual( pData, n, pValue, nType ) )
+		n++;
+
+	return n;
+}
+
+inline size_t Ball_MemRFind( const void *pData, size_t nCount, const void *pValue, uint32_t nType )
+{
+	for ( size_t n = nCount; n-- > 0; )
+	{
+		if ( Ball_MemFindIsEqual( pData, n, pValue, nType ) )
+			return n;
+	}
+
+	return nCount;
+}
+
+inline size_t Ball_MemCount( const void *pData, size_t nCount, const void *pValue, uint32_t nType )
+{
+	size_t nFound = 0;
+
+	for ( size_t n = 0; n < nCount; n++ )
+		nFound += Ball_MemFindIsEqual( pData, n, pValue, nType );
+
+	return nFound;
+}
+
+inline size_t Ball_MemFindAll( const void *pData, size_t nCount, const void *pValue, uint32_t nType, size_t *pIndices, size_t nMaxIndices )
+{
+	size_t nFound = 0;
+
+	for ( size_t n = 0; n < nCount && nFound < nMaxIndices; n++ )
+	{
+		if ( Ball_MemFindIsEqual( pData, n, pValue, nType ) )
+			pIndices[ nFound++ ] = n;
+	}
+
+	return nFound;
+}
+#	else // !defined( _WIN32 )
+BALL_EXTERN_C size_t Ball_MemFind( const void *pData, size_t nCount, const void *pValue, uint32_t nType );
+BALL_EXTERN_C size_t Ball_MemRFind( const void *pData, size_t nCount, const void *pValue, uint32_t nType );
+BALL_EXTERN_C size_t Ball_MemCount( const void *pData, size_t nCount, const void *pValue, uint32_t nType );
+BALL_EXTERN_C size_t Ball_MemFindAll( const void *pData, size_t nCount, const void *pValue, uint32_t nType, size_t *pIndices, size_t nMaxIndices );
+#	endif // defined( _WIN32 )
+
+#endif // !defined( _INCLUDE_BALL_TYPES_MEMORYFIND_H_ )
@@ -0,0 +1,94 @@
+#ifndef _INCLUDE_BALL_TYPES_MEMORYRESOURCE_HPP_
+#	define _INCLUDE_BALL_TYPES_MEMORYRESOURCE_HPP_
+
+#	pragma once
+
+#	include "base/arch.h"
+#	include "allocator.hpp"
+
+///-----------------------------------------------------------------------------
+/// @brief Allocation strategy chosen at run time: containers using a
+///        CResourceAllocator call it through a pointer instead of a template
+///        parameter, so one container type serves every strategy.
+/// @note  Blocks must go back to the resource they came from. Resources are
+///        not owned by the containers and must outlive their blocks.
+///-----------------------------------------------------------------------------
+class CMemoryResource
+{
+public:
+	virtual void *Alloc( size_t nSize, size_t nAligned ) = 0;
+	virtual void *Realloc( ptr_t pMem, size_t nSize, size_t nAligned ) = 0;
+	virtual void Free( ptr_t pMem ) = 0;
+
+	/// @brief The Ball heap (CAllocatorBase), used when no resource is given.
+	static CMemoryResource &Default() noexcept;
+
+protected:
+	// Not deleted through the interface.
+	~CMemoryResource() = default;
+}; // class CMemoryResource
+
+///-----------------------------------------------------------------------------
+/// @brief CMemoryResource over a static allocator base (CAllocatorBase,
+///        CThreadCacheAllocatorBase, CArenaAllocatorBase, ...).
+///-----------------------------------------------------------------------------
+template < class A >
+class CAllocatorResource final : public CMemoryResource
+{
+public:
+	void *Alloc( size_t nSize, size_t nAligned ) override { return A::Alloc( nSize, nAligned ); }
+	void *Realloc( ptr_t pMem, size_t nSize, size_t nAligned ) override { return A::Realloc( pMem, nSize, nAligned ); }
+	void Free( ptr_t pMem ) override { A::Free( pMem ); }
+
+	/// @brief The shared instance (stateless, constant-initialized).
+	static CAllocatorResource &Instance() noexcept
+	{
+		static constinit CAllocatorResource s_instance;
+
+		return s_instance;
+	}
+}; // class CAllocatorResource
+
+inline CMemoryResource &CMemoryResource::Default() noexcept
+{
+	return CAllocatorResource< CAllocatorBase >::Instance();
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Container allocator dispatching to the CMemoryResource it holds.
+/// @note  Unlike the static allocators it is stored in the container (one
+///        pointer), which picks the resource per instance: see
+///        CVectorBase::SetAllocator(). Swaps and moves carry it along.
+///-----------------------------------------------------------------------------
+template < typename I, typename T >
+class CResourceAllocator
+{
+public:
+	/// No BALL_ALLOC_* policy: the resource decides.
+	static constexpr uint32_t FLAGS = 0;
+
+	CResourceAllocator() noexcept : m_pResource( &CMemoryResource::Default() ) {}
+	CResourceAllocator( CMemoryResource &resource ) noexcept : m_pResource( &resource ) {}
+
+	CMemoryResource &Resource() const noexcept { return *m_pResource; }
+
+	T *Alloc( I nCount, size_t nAligned )
+	{
+		return reinterpret_cast< T * >( m_pResource->Alloc( static_cast< size_t >( nCount ) * sizeof( T ), nAligned ) );
+	}
+
+	T *Realloc( T *pMem, I nCount, size_t nAligned )
+	{
+		return reinterpret_cast< T * >( m_pResource->Realloc( pMem, static_cast< size_t >( nCount ) * sizeof( T ), nAligned ) );
+	}
+
+	void Free( ptr_t pMem )
+	{
+		m_pResource->Free( pMem );
+	}
+
+private:
+	CMemoryResource *m_pResource;
+}; // class CResourceAllocator
+
+#endif // !defined( _INCLUDE_BALL_TYPES_MEMORYRESOURCE_HPP_ )
@@ -0,0 +1,38 @@
+#ifndef _INCLUDE_BALL_TYPES_MEMORYSLAB_H_
+#	define _INCLUDE_BALL_TYPES_MEMORYSLAB_H_
+
+#	include "base/arch.h"
+#	include "base/fixed.h"
+#	include "c/macros.h"
+
+/// Largest request (bytes) served by size classes; bigger ones go to Ball_AllocAlign.
+#	define BALL_SLAB_MAX_SIZE 65536u
+
+/// Largest alignment a size class can guarantee (one slab page).
+#	define BALL_SLAB_MAX_ALIGN 4096u
+
+#	define BALL_SLAB_IS_SMALL( size, align ) ( ( size ) <= BALL_SLAB_MAX_SIZE && ( align ) <= BALL_SLAB_MAX_ALIGN )
+
+#	if defined( _WIN32 )
+inline bool_t Ball_SlabOwns( ptr_t ) { return false; }
+inline ptr_t Ball_SlabAlloc( size_t, size_t ) { return BALL_NULL; }
+inline void Ball_SlabFree( ptr_t ) {}
+inline ptr_t Ball_SlabRealloc( ptr_t, size_t, size_t ) { return BALL_NULL; }
+inline size_t Ball_SlabSize( ptr_t ) { return 0; }
+inline size_t Ball_SlabClassSize( uint32_t ) { return 0; }
+inline ptr_t Ball_SlabCacheAlloc( size_t, size_t ) { return BALL_NULL; }
+inline ptr_t Ball_SlabCacheRealloc( ptr_t, size_t, size_t ) { return BALL_NULL; }
+inline void Ball_SlabCacheFlush() {}
+#	else // !defined( _WIN32 )
+BALL_EXTERN_C bool_t Ball_SlabOwns( ptr_t pMem );
+BALL_EXTERN_C ptr_t Ball_SlabAlloc( size_t nSize, size_t nAlign );
+BALL_EXTERN_C void Ball_SlabFree( ptr_t pMem );
+BALL_EXTERN_C ptr_t Ball_SlabRealloc( ptr_t pMem, size_t nSize, size_t nAlign );
+BALL_EXTERN_C size_t Ball_SlabSize( ptr_t pMem );
+BALL_EXTERN_C size_t Ball_SlabClassSize( uint32_t nClass );
+BALL_EXTERN_C ptr_t Ball_SlabCacheAlloc( size_t nSize, size_t nAlign );
+BALL_EXTERN_C ptr_t Ball_SlabCacheRealloc( ptr_t pMem, size_t nSize, size_t nAlign );
+BALL_EXTERN_C void Ball_SlabCacheFlush( void );
+#	endif // defined( _WIN32 )
+
+#endif // !defined( _INCLUDE_BALL_TYPES_MEMORYSLAB_H_ )
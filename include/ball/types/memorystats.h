@@ -0,0 +1,58 @@
+#ifndef _INCLUDE_BALL_TYPES_MEMORYSTATS_H_
+#	define _INCLUDE_BALL_TYPES_MEMORYSTATS_H_
+
+#	include "base/arch.h"
+#	include "base/fixed.h"
+#	include "c/macros.h"
+
+/// Histogram buckets: bucket n counts requests with floor( log2( size ) ) == n.
+#	define BALL_MEMSTATS_HISTOGRAM 64
+
+/// Size classes of the slab heap (8 bytes to BALL_SLAB_MAX_SIZE), counted one by one.
+#	define BALL_MEMSTATS_SLAB_CLASSES 26
+
+///-----------------------------------------------------------------------------
+/// @brief Snapshot of the mmap-backed allocation layer (Ball_*Align) and of
+///        the slab heap (Ball_Slab*, per size class, smallest first).
+/// @note  Call counters are kept per thread and summed on read, so a snapshot
+///        taken while other threads allocate is approximate, never torn.
+///        Mapped bytes are process-wide and exact.
+///-----------------------------------------------------------------------------
+struct Ball_MemStats_t
+{
+	uint64_t nAllocCalls;         ///< Ball_AllocAlign/Ball_AllocAlignEx calls.
+	uint64_t nFreeCalls;          ///< Ball_FreeAlign calls on valid blocks.
+	uint64_t nReallocCalls;       ///< Ball_ReallocAlign calls on existing blocks.
+	uint64_t nReallocInPlace;     ///< Reallocs that fit the existing mapping (no syscall).
+	uint64_t nReallocRemap;       ///< Reallocs resized by mremap (no copy).
+	uint64_t nReallocCopy;        ///< Reallocs that fell back to alloc + copy + free.
+	uint64_t nReallocCopyBytes;   ///< Bytes copied by those fallbacks.
+	uint64_t nMapCalls;           ///< mmap syscalls.
+	uint64_t nUnmapCalls;         ///< munmap syscalls (including alignment trims).
+	uint64_t nRemapCalls;         ///< mremap syscalls (including failed attempts).
+	uint64_t nCacheHits;          ///< Allocations served by a retained mapping.
+	uint64_t nShrinkCalls;        ///< Shrinking reallocs that returned trailing pages.
+	uint64_t nShrinkBytes;        ///< Bytes those shrinks returned to the OS.
+	uint64_t nPopulateBytes;      ///< Bytes prefaulted (BALL_ALLOC_POPULATE, Ball_MemPopulate).
+	uint64_t nCommitCalls;        ///< mprotect commits of reserved ranges (Ball_ReserveAlign).
+	uint64_t nBatchCalls;         ///< Ball_AllocBatch mappings.
+	uint64_t nBatchBlocks;        ///< Blocks carved out of them.
+	uint64_t nMappedBytes;        ///< Bytes currently mapped for live blocks (committed part of reservations).
+	uint64_t nPeakMappedBytes;    ///< High-water mark of nMappedBytes.
+	uint64_t nCachedBytes;        ///< Bytes of freed mappings retained for reuse.
+	uint64_t aSizeHistogram[ BALL_MEMSTATS_HISTOGRAM ]; ///< Allocation requests by log2 size.
+	uint64_t aSlabAllocs[ BALL_MEMSTATS_SLAB_CLASSES ];    ///< Slab blocks handed out.
+	uint64_t aSlabFrees[ BALL_MEMSTATS_SLAB_CLASSES ];     ///< Slab blocks returned (from any thread).
+	uint64_t aSlabLiveBytes[ BALL_MEMSTATS_SLAB_CLASSES ]; ///< Class bytes of the slab blocks in use (allocs - frees, at read).
+}; // struct Ball_MemStats_t
+
+#	if defined( _WIN32 )
+inline void Ball_MemStats( struct Ball_MemStats_t *pStats ) { __builtin_memset( pStats, 0, sizeof( *pStats ) ); }
+#	else // !defined( _WIN32 )
+BALL_EXTERN_C void Ball_MemStats( struct Ball_MemStats_t *pStats );
+
+/// Count a slab block of class @p nClass handed out or returned; called by the slab heap.
+BALL_EXTERN_C void Ball_MemStatSlab( uint32_t nClass, bool_t bAlloc );
+#	endif // defined( _WIN32 )
+
+#endif // !defined( _INCLUDE_BALL_TYPES_MEMORYSTATS_H_ )
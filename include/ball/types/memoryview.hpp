@@ -6,6 +6,7 @@
 #	include "c/assert.h"
 #	include "meta/number.hpp"
 #	include "math.hpp"
+#	include "elements.hpp"
 
 #	include "memoryviewbase.hpp"
 
@@ -22,6 +23,9 @@ public:
 	/// @brief Special "not found" value.
 	static constexpr I INVALID_INDEX = Number_t::INVALID;
 
+	/// @brief Whether the storage is followed by BALL_ALLOC_PADDING readable bytes (see CPaddedView).
+	static constexpr bool IS_PADDED = false;
+
 	// --------- basic associated types ----------
 	using value_type      = T;
 	using size_type       = I;
@@ -61,7 +65,7 @@ public:
 
 	// --------- basic access ----------
 	using Base_t::Empty;
-	constexpr const T *Get() const noexcept       { return Base_t::template Get< T >(); }
+	constexpr const T *Get() const noexcept       { return Base(); }
 
 	// --------- iterators ----------
 	constexpr iterator begin()                        { return Base(); }
@@ -152,11 +156,7 @@ public:
 		if ( nPrefixCount > Count() )
 			return false;
 
-		for ( I i = 0; i < nPrefixCount; ++i )
-			if ( !( Data()[ i ] == vPrefix.Data()[ i ] ) )
-				return false;
-
-		return true;
+		return MismatchElements( nPrefixCount, Data(), vPrefix.Data() ) == nPrefixCount;
 	}
 
 	constexpr bool EndsWith( Const_t &vSuffix ) const noexcept
@@ -168,15 +168,13 @@ public:
 
 		I nOffset = static_cast< I >( nCount - nSuffixCount );
 
-		for ( I i = 0; i < nSuffixCount; ++i )
-			if ( !( Data()[ nOffset + i ] == vSuffix.Data()[ i ] ) )
-				return false;
-
-		return true;
+		return MismatchElements( nSuffixCount, Data() + nOffset, vSuffix.Data() ) == nSuffixCount;
 	}
 
 	constexpr I Find( const T &value, const I iFrom = I( 0 ) ) const noexcept { return Base_t::template Find< T >( value, iFrom ); }
-	constexpr I RFind( const T &value, const I iFrom = I( 0 ) ) const noexcept { return Base_t::template RFind< T >( value, iFrom ); }
+	constexpr I RFind( const T &value, const I iFrom = INVALID_INDEX ) const noexcept { return Base_t::template RFind< T >( value, iFrom ); }
+	constexpr I CountOf( const T &value ) const noexcept { return Base_t::template CountOf< T >( value ); }
+	template < class F > constexpr I FindAll( const T &value, F &&fnFound, const I iFrom = I( 0 ) ) const { return Base_t::template FindAll< T >( value, fnFound, iFrom ); }
 
 	/// @brief Find first occurrence of subelement @p needle starting at @p from.
 	///        Returns INVALID_INDEX if not found.
@@ -189,36 +187,37 @@ public:
 		const T *pData     = Base();
 		const T *pViewBase = v.Base();
 
+		// INVALID_INDEX: search from the first element.
+		const I iStart = ( iFrom == INVALID_INDEX ) ? I( 0 ) : iFrom;
+
 		// Empty haystack: nothing to find.
 		if ( !pData )
 			return INVALID_INDEX;
 
 		// Empty needle: by convention return clamped start position.
 		if ( nViewCount == I( 0 ) )
-			return iFrom;
+			return iStart;
 
 		// Out-of-range or needle longer than the remaining span.
-		if ( iFrom > nCount || nViewCount > nCount - iFrom )
+		if ( iStart > nCount || nViewCount > nCount - iStart )
 			return INVALID_INDEX;
 
 		const I nLast = static_cast< I >( nCount - nViewCount );
 
-		for ( I n = iFrom; n <= nLast; ++n )
+		for ( I n = iStart; n <= nLast; ++n )
 		{
-			// Quick check on the first element.
-			if ( !( pData[ n ] == pViewBase[ 0 ] ) )
-				continue;
+			// Skip to the next start holding the first element.
+			const I nSkip = FindElement( static_cast< I >( nLast - n + 1 ), pData + n, pViewBase[ 0 ] );
 
-			// Verify the rest of the needle.
-			I j = I( 1 );
+			if ( nSkip > nLast - n )
+				break;
 
-			for ( ; j < nViewCount; ++j )
-			{
-				if ( !( pData[ n + j ] == pViewBase[ j ] ) )
-					break;
-			}
+			n = static_cast< I >( n + nSkip );
 
-			if ( j == nViewCount )
+			// Verify the rest of the needle.
+			const I nRest = static_cast< I >( nViewCount - 1 );
+
+			if ( MismatchElements( nRest, pData + n + 1, pViewBase + 1 ) == nRest )
 				return n;
 		}
 
@@ -288,30 +287,21 @@ public:
 			iStart = iFrom;
 		}
 
-		// Backward scan: iStart .. 0
-		for ( I n = iStart; ; )
-		{
-			// Quick check on the first element at this start.
-			if ( pData[ n ] == pViewBase[ 0 ] )
-			{
-				// Verify the rest of the needle forward from i.
-				I j = I( 1 );
+		// Backward scan: iStart .. 0, over starts holding the first element.
+		const I nRest = static_cast< I >( nViewCount - 1 );
 
-				for ( ; j < nViewCount; ++j )
-				{
-					if ( !( pData[ n + j ] == pViewBase[ j ] ) )
-						break;
-				}
-
-				if ( j == nViewCount )
-					return n;
-			}
+		for ( I nEnd = static_cast< I >( iStart + 1 ); nEnd > I( 0 ); )
+		{
+			const I n = RFindElement( nEnd, pData, pViewBase[ 0 ] );
 
-			// Stop when i == 0 to avoid unsigned underflow.
-			if ( n == I( 0 ) )
+			if ( n == nEnd )
 				break;
 
-			--n;
+			// Verify the rest of the needle forward from n.
+			if ( MismatchElements( nRest, pData + n + 1, pViewBase + 1 ) == nRest )
+				return n;
+
+			nEnd = n;
 		}
 
 		return INVALID_INDEX;
@@ -320,14 +310,10 @@ public:
 	// --------- comparisons ----------
 	friend constexpr bool operator==( const CMemoryView &a, const CMemoryView &b ) noexcept
 	{
-		if ( a.m_nCount != b.m_nCount )
+		if ( a.Count() != b.Count() )
 			return false;
 
-		for ( I i = 0; i < a.m_nCount; ++i )
-			if ( !( a.m_pElements[ i ] == b.m_pElements[ i ] ) )
-				return false;
-
-		return true;
+		return MismatchElements( a.Count(), a.Data(), b.Data() ) == a.Count();
 	}
 
 	friend constexpr bool operator!=( const CMemoryView &a, const CMemoryView &b ) noexcept
@@ -337,21 +323,32 @@ public:
 
 	friend constexpr bool operator<( const CMemoryView &a, const CMemoryView &b ) noexcept
 	{
-		I n = ( a.m_nCount < b.m_nCount ) ? a.m_nCount : b.m_nCount;
+		I n = ( a.Count() < b.Count() ) ? a.Count() : b.Count();
+
+		if constexpr ( IS_BITWISE_COMPARABLE< T > )
+		{
+			// Skip the equal prefix in bulk; the first differing pair decides.
+			const I i = MismatchElements( n, a.Data(), b.Data() );
 
-		for ( I i = 0; i < n; ++i )
+			if ( i < n )
+				return a.Data()[ i ] < b.Data()[ i ];
+		}
+		else
 		{
-			const T &va = a.m_pElements[ i ];
-			const T &vb = b.m_pElements[ i ];
+			for ( I i = 0; i < n; ++i )
+			{
+				const T &va = a.Data()[ i ];
+				const T &vb = b.Data()[ i ];
 
-			if ( va < vb )
-				return true;
+				if ( va < vb )
+					return true;
 
-			if ( vb < va )
-				return false;
+				if ( vb < va )
+					return false;
+			}
 		}
 
-		return a.m_nCount < b.m_nCount;
+		return a.Count() < b.Count();
 	}
 
 	friend constexpr bool operator >( const CMemoryView &a, const CMemoryView &b ) noexcept { return b < a; }
@@ -369,4 +366,22 @@ protected:
 	using Base_t::MoveFrom;
 }; // class CMemoryView
 
+///-----------------------------------------------------------------------------
+/// @brief CMemoryView over storage followed by at least BALL_ALLOC_PADDING
+///        readable bytes (a BALL_ALLOC_PADDED block, see CVectorBase::PaddedView),
+///        so kernels may load whole vectors past Count() without a scalar tail.
+/// @note  The padding holds arbitrary bytes; an empty view may have no storage.
+///-----------------------------------------------------------------------------
+template < typename I, typename T >
+class CPaddedView : public CMemoryView< I, T >
+{
+public:
+	using Base_t = CMemoryView< I, T >;
+
+	static constexpr bool IS_PADDED = true;
+
+	explicit constexpr CPaddedView( I nCount, T *pElements ) noexcept : Base_t( nCount, pElements ) {}
+	constexpr CPaddedView() noexcept : Base_t() {}
+}; // class CPaddedView
+
 #endif // !defined( _INCLUDE_BALL_TYPES_MEMORYVIEW_HPP_ )
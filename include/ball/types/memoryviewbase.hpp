@@ -9,6 +9,7 @@
 #	include "meta/number.hpp"
 #	include "meta/pack.hpp"
 #	include "math.hpp"
+#	include "elements.hpp"
 
 ///-----------------------------------------------------------------------------
 /// @brief View over multiple parallel arrays with different element types,
@@ -139,6 +140,8 @@ public:
 	template < typename T, Enable_t< T > = 0 > constexpr const T *cend() const noexcept { return Data< T >() + Count(); }
 
 	// --------- typed find helpers (optional, no memcmp/STL) ----------
+	// Integer, character, pointer and floating point elements are searched by
+	// the vector kernels (FindElement and co., see memoryfind.h).
 	template < typename T, Enable_t< T > = 0 >
 	constexpr I Find( const T &value, const I iFrom = I( 0 ) ) const noexcept
 	{
@@ -148,15 +151,16 @@ public:
 		if ( !p || iFrom >= nCount )
 			return INVALID_INDEX;
 
-		for ( I i = iFrom; i < nCount; ++i )
-			if ( p[ i ] == value )
-				return i;
+		const I nRest = static_cast< I >( nCount - iFrom );
+		const I i = FindElement( nRest, p + iFrom, value );
 
-		return INVALID_INDEX;
+		return ( i < nRest ) ? static_cast< I >( iFrom + i ) : INVALID_INDEX;
 	}
 
+	/// @brief Find the last element equal to @p value at or before @p iFrom
+	///        (INVALID_INDEX: the last element).
 	template < typename T, Enable_t< T > = 0 >
-	constexpr I RFind( const T &value ) const noexcept
+	constexpr I RFind( const T &value, const I iFrom = INVALID_INDEX ) const noexcept
 	{
 		const I nCount = Count();
 		const T *p = Base< T >();
@@ -164,11 +168,34 @@ public:
 		if ( !p || nCount == I( 0 ) )
 			return INVALID_INDEX;
 
-		for ( I i = nCount; i > I( 0 ); --i )
-			if ( p[ i - 1 ] == value )
-				return i - 1;
+		const I nSearch = ( iFrom == INVALID_INDEX || iFrom >= nCount ) ? nCount : static_cast< I >( iFrom + 1 );
+		const I i = RFindElement( nSearch, p, value );
 
-		return INVALID_INDEX;
+		return ( i < nSearch ) ? i : INVALID_INDEX;
+	}
+
+	/// @brief Number of elements equal to @p value.
+	template < typename T, Enable_t< T > = 0 >
+	constexpr I CountOf( const T &value ) const noexcept
+	{
+		const T *p = Base< T >();
+
+		return p ? CountElements( Count(), p, value ) : I( 0 );
+	}
+
+	/// @brief  Call @p fnFound( I index ) for every element equal to @p value
+	///         from @p iFrom on, in order.
+	/// @return Number of elements found.
+	template < typename T, class F, Enable_t< T > = 0 >
+	constexpr I FindAll( const T &value, F &&fnFound, const I iFrom = I( 0 ) ) const
+	{
+		const I nCount = Count();
+		const T *p = Base< T >();
+
+		if ( !p || iFrom >= nCount )
+			return I( 0 );
+
+		return FindAllElements( static_cast< I >( nCount - iFrom ), p + iFrom, value, [ & ]( const I i ) { fnFound( static_cast< I >( iFrom + i ) ); } );
 	}
 
 	// --------- slicing / subviews (typed pointers are advanced equally) ----------
@@ -0,0 +1,9 @@
+#ifndef _INCLUDE_BALL_TYPES_META_ISBITWISECOMPARABLE_HPP_
+#	define _INCLUDE_BALL_TYPES_META_ISBITWISECOMPARABLE_HPP_
+
+// Determine whether two T are equal exactly when their bytes are: scalars with one object
+// representation per value (integers, characters, enums, pointers). Floating point (+0/-0,
+// NaN) and class types (user operator==, padding) are compared element by element.
+template < typename T > constexpr bool IS_BITWISE_COMPARABLE = !__is_class( T ) && !__is_union( T ) && __has_unique_object_representations( T );
+
+#endif // !defined( _INCLUDE_BALL_TYPES_META_ISBITWISECOMPARABLE_HPP_ )
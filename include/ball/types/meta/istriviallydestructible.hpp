@@ -0,0 +1,13 @@
+#ifndef _INCLUDE_BALL_TYPES_META_ISTRIVIALLYDESTRUCTIBLE_HPP_
+#	define _INCLUDE_BALL_TYPES_META_ISTRIVIALLYDESTRUCTIBLE_HPP_
+
+// Determine whether destroying a T does nothing, so its destructor need not run. Compilers
+// without the __is_trivially_destructible builtin (GCC before 14) only offer the older
+// __has_trivial_destructor, which Clang deprecates.
+#	if __has_builtin( __is_trivially_destructible )
+template < typename T > constexpr bool IS_TRIVIALLY_DESTRUCTIBLE = __is_trivially_destructible( T );
+#	else
+template < typename T > constexpr bool IS_TRIVIALLY_DESTRUCTIBLE = __has_trivial_destructor( T );
+#	endif
+
+#endif // !defined( _INCLUDE_BALL_TYPES_META_ISTRIVIALLYDESTRUCTIBLE_HPP_ )
@@ -0,0 +1,9 @@
+#ifndef _INCLUDE_BALL_TYPES_META_ISTRIVIALLYRELOCATABLE_HPP_
+#	define _INCLUDE_BALL_TYPES_META_ISTRIVIALLYRELOCATABLE_HPP_
+
+// Determine whether T may be relocated (moved to another address, the source left as raw
+// memory) with a byte copy. Trivially copyable types qualify automatically; specialize to
+// opt in types that only own resources through pointers and never point into themselves.
+template < typename T > constexpr bool IS_TRIVIALLY_RELOCATABLE = __is_trivially_copyable( T );
+
+#endif // !defined( _INCLUDE_BALL_TYPES_META_ISTRIVIALLYRELOCATABLE_HPP_ )
@@ -0,0 +1,233 @@
+#ifndef _INCLUDE_BALL_TYPES_RESERVEDVECTOR_HPP_
+#	define _INCLUDE_BALL_TYPES_RESERVEDVECTOR_HPP_
+
+#	pragma once
+
+#	include "base/arch.h"
+#	include "c/assert.h"
+#	include "c/math.h"
+#	include "memoryaligned.h"
+#	include "meta/number.hpp"
+#	include "memoryview.hpp"
+#	include "vector.hpp"
+
+// ===============================
+// CVectorBase_Reserved (storage is a reserved address range)
+// ===============================
+///-----------------------------------------------------------------------------
+/// @brief Vector storage that never moves: room for MaxCount() elements is
+///        reserved up front (Ball_ReserveAlign) and committed as it grows.
+/// @note
+///   * The reservation is taken on the first growth and costs address space
+///     only; pages are committed (mprotect) in power-of-two steps, so appends
+///     make O(log n) syscalls and never copy or relocate an element.
+///   * Pointers and references to elements stay valid until they are removed
+///     or the storage is released (Purge(), ShrinkToFit() when empty).
+///   * Growing past MaxCount() asserts and leaves the storage as it is; pick
+///     the maximum generously, unused address space is free.
+///-----------------------------------------------------------------------------
+template < class B, typename I, typename T >
+class CVectorBase_Reserved : public B
+{
+public:
+	using Base_t =      B;
+	using Index_t =     I;
+	using Element_t =   T;
+	using Number_t =    MNumber< Index_t >;
+	using Unsigned_t =  typename Number_t::U;
+	using View_t =      Base_t;
+	using ConstView_t = typename Base_t::Const_t;
+
+	using Base_t::Base_t;
+	using Base_t::Count;
+	using Base_t::Data;
+
+	static constexpr bool IS_GROWABLE = false;
+	static constexpr size_t ALIGNED_SIZE = NextPowerOfTwo_Const( 8 * sizeof( Element_t ) );
+	static constexpr I INVALID_INDEX = Number_t::INVALID;
+
+	/// Address space reserved when no maximum is given.
+	static constexpr size_t DEFAULT_RESERVE_SIZE = static_cast< size_t >( 1 ) << 30;
+	static constexpr I DEFAULT_MAX_COUNT = DEFAULT_RESERVE_SIZE / sizeof( T ) < static_cast< size_t >( Number_t::MAX )
+	                                     ? static_cast< I >( DEFAULT_RESERVE_SIZE / sizeof( T ) ) : Number_t::MAX;
+
+	constexpr ~CVectorBase_Reserved() noexcept
+	{
+		T *pElements = Data();
+
+		if ( pElements )
+		{
+			Ball_FreeAlign( pElements );
+		}
+	}
+
+	/// @brief Number of elements the committed pages can hold (0 without storage).
+	constexpr I Capacity() const noexcept { return m_nCapacity; }
+	constexpr size_t CapacitySize() const noexcept { return static_cast< size_t >( Capacity() ) * sizeof( Element_t ); }
+
+	/// @brief Most elements the vector can ever hold.
+	constexpr I MaxCount() const noexcept { return m_nMaxCount; }
+
+	///-----------------------------------------------------------------------------
+	/// @brief Set the maximum the address range is reserved for.
+	/// @return false once the range is reserved (it cannot change then).
+	///-----------------------------------------------------------------------------
+	constexpr bool SetMaxCount( I nMaxCount ) noexcept
+	{
+		if ( Data() )
+			return false;
+
+		m_nMaxCount = nMaxCount;
+
+		return true;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Commit room for at least @p nCount elements (rounded to a power of two).
+	///-----------------------------------------------------------------------------
+	constexpr void Reserve( I nCount )
+	{
+		Set( Count(), EnsureCapacity( nCount ) );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Decommit the pages not needed for Count() elements (see
+	///        Ball_ReallocAlign), or release the whole range when empty.
+	///-----------------------------------------------------------------------------
+	constexpr void ShrinkToFit()
+	{
+		const I nCount = Count();
+		T *pElements = Data();
+
+		if ( !pElements || nCount == m_nCapacity )
+			return;
+
+		if ( !nCount )
+		{
+			Ball_FreeAlign( pElements );
+			pElements = nullptr;
+		}
+		else if ( !Ball_ReallocAlign( pElements, static_cast< size_t >( nCount ) * sizeof( T ), ALIGNED_SIZE ) )
+		{
+			return;
+		}
+
+		m_nCapacity = nCount;
+		Set( nCount, pElements );
+	}
+
+protected:
+	using Base_t::Set;
+
+	///-----------------------------------------------------------------------------
+	/// @brief Ensure the committed pages can hold at least @p nRequestCapacity
+	///        elements (rounded up to a power of two, capped at MaxCount()).
+	/// @note  Reserves the range on first use; the returned pointer never changes
+	///        afterwards. Past MaxCount() (or over a budget's hard limit) it
+	///        asserts and returns the current storage.
+	///-----------------------------------------------------------------------------
+	T *EnsureCapacity( I nRequestCapacity )
+	{
+		T *pElements = Data();
+
+		if ( nRequestCapacity <= m_nCapacity )
+			return pElements;
+
+		BALL_ASSERT_MESSAGE( nRequestCapacity <= m_nMaxCount, "Reserved vector is full" );
+
+		if ( nRequestCapacity > m_nMaxCount )
+			return pElements;
+
+		I nNewCapacity = NextPowerOfTwo( nRequestCapacity );
+
+		if ( nNewCapacity == Number_t::INVALID || nNewCapacity > m_nMaxCount )
+			nNewCapacity = m_nMaxCount;
+
+		ptr_t pBlock = pElements;
+
+		if ( !pBlock )
+		{
+			pBlock = Ball_ReserveAlign( static_cast< size_t >( m_nMaxCount ) * sizeof( T ), ALIGNED_SIZE, 0 );
+			BALL_ASSERT_MESSAGE( pBlock != nullptr, "Failed to reserve address space" );
+
+			if ( !pBlock )
+				return pElements;
+		}
+
+		// Commits in place: the block either keeps its address or stays as it was.
+		if ( !Ball_ReallocAlign( pBlock, static_cast< size_t >( nNewCapacity ) * sizeof( T ), ALIGNED_SIZE ) )
+		{
+			BALL_ASSERT_MESSAGE( false, "Failed to commit reserved pages" );
+
+			if ( !pElements )
+				Ball_FreeAlign( pBlock );
+
+			return pElements;
+		}
+
+		m_nCapacity = nNewCapacity;
+
+		return reinterpret_cast< T * >( pBlock );
+	}
+
+	/// @brief Copy contents from another view (replaces the current elements).
+	CVectorBase_Reserved &CopyFrom( const CMemoryView< I, T > &other )
+	{
+		const I nNewCount = other.Count();
+
+		T *pElements = EnsureCapacity( nNewCount );
+
+		// Past MaxCount() (asserted above) the current elements are kept.
+		if ( nNewCount > Capacity() )
+			return *this;
+
+		if ( nNewCount > 0 )
+		{
+			CopyElements( nNewCount, pElements, other.Data() );
+		}
+
+		Set( nNewCount, pElements );
+
+		return *this;
+	}
+
+	/// @brief Exchange storage (elements, count, capacity and maximum) with @p other.
+	constexpr void Swap( CVectorBase_Reserved &other ) noexcept
+	{
+		Base_t::Swap( other );
+		Math_Swap( m_nCapacity, other.m_nCapacity );
+		Math_Swap( m_nMaxCount, other.m_nMaxCount );
+	}
+
+	/// @brief Take over @p other's reservation.
+	constexpr CVectorBase_Reserved &MoveFrom( CVectorBase_Reserved &&other ) noexcept
+	{
+		if ( this != &other )
+			Swap( other );
+
+		return *this;
+	}
+
+private:
+	I m_nCapacity = 0;
+	I m_nMaxCount = DEFAULT_MAX_COUNT;
+}; // class CVectorBase_Reserved
+
+///-----------------------------------------------------------------------------
+/// @brief Vector with stable element addresses (see CVectorBase_Reserved).
+///-----------------------------------------------------------------------------
+template < typename I, typename T >
+class CReservedVector : public CVectorImpl< CVectorBase_Reserved< CMemoryView< I, T >, I, T >, I, T >
+{
+public:
+	using Base_t = CVectorImpl< CVectorBase_Reserved< CMemoryView< I, T >, I, T >, I, T >;
+
+	explicit CReservedVector( I nMaxCount = Base_t::DEFAULT_MAX_COUNT ) noexcept
+	{
+		Base_t::SetMaxCount( nMaxCount );
+	}
+};
+
+template < typename T > using ReservedVector_t =    CReservedVector< size_t, T >;
+
+#endif // !defined( _INCLUDE_BALL_TYPES_RESERVEDVECTOR_HPP_ )
@@ -0,0 +1,219 @@
+#ifndef _INCLUDE_BALL_TYPES_RINGBUFFER_HPP_
+#	define _INCLUDE_BALL_TYPES_RINGBUFFER_HPP_
+
+#	pragma once
+
+#	include "base/arch.h"
+#	include "c/assert.h"
+#	include "c/file.h"
+#	include "c/math.h"
+#	include "c/mmap.h"
+#	include "elements.hpp"
+#	include "memoryaligned.h"
+#	include "memoryview.hpp"
+#	include "meta/number.hpp"
+#	include "stringview.hpp"
+
+///-----------------------------------------------------------------------------
+/// @brief Circular buffer whose pages are mapped twice back to back, so every
+///        readable or writable window is one contiguous range, however it wraps.
+/// @note
+///   * The storage is a memfd of Capacity() elements (rounded up to whole
+///     pages) mapped MAP_SHARED at [base, base + size) and again right after
+///     it; a write through either mapping shows up in both.
+///   * Producers fill WriteView() and Commit() what they wrote; consumers
+///     parse ReadView()/ReadString() in place and Consume() what they used.
+///   * Not thread-safe; the element size must divide the page size.
+///-----------------------------------------------------------------------------
+template < typename I, typename T >
+class CRingBuffer
+{
+public:
+	using Index_t =     I;
+	using Element_t =   T;
+	using View_t =      CMemoryView< I, T >;
+	using ConstView_t = CMemoryView< I, const T >;
+	using String_t =    CStringView< I, const T >;
+
+	static_assert( __is_trivially_copyable( T ), "CRingBuffer requires trivially copyable elements" );
+	static_assert( ( sizeof( T ) & ( sizeof( T ) - 1 ) ) == 0, "CRingBuffer: element size must be a power of two" );
+
+	constexpr CRingBuffer() noexcept = default;
+	explicit CRingBuffer( I nMinCapacity ) { Create( nMinCapacity ); }
+	~CRingBuffer() noexcept { Destroy(); }
+
+	CRingBuffer( const CRingBuffer & ) = delete;
+	CRingBuffer &operator=( const CRingBuffer & ) = delete;
+
+	CRingBuffer( CRingBuffer &&other ) noexcept { Swap( other ); }
+	CRingBuffer &operator=( CRingBuffer &&other ) noexcept { Swap( other ); return *this; }
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Map an empty buffer of at least @p nMinCapacity elements; destroys
+	///         the previous one.
+	/// @return false when the memfd or either mapping cannot be created.
+	///-----------------------------------------------------------------------------
+	bool Create( I nMinCapacity )
+	{
+		Destroy();
+
+		if ( nMinCapacity <= 0 )
+			return false;
+
+		const size_t nSize = BALL_ROUND_UP( static_cast< size_t >( nMinCapacity ) * sizeof( T ), Ball_PageSize() );
+
+		if ( nSize / sizeof( T ) > static_cast< size_t >( MNumber< I >::MAX ) )
+			return false;
+
+		const int nFD = memfd_create( "ball-ring", BALL_MFD_CLOEXEC );
+
+		if ( nFD < 0 )
+			return false;
+
+		uchar_t *pBase = nullptr;
+
+		if ( ftruncate( nFD, static_cast< long >( nSize ) ) == 0 )
+		{
+			// Reserve both halves first so nothing else can land between them.
+			void *pReserve = mmap( nullptr, 2 * nSize, BALL_PROT_NONE, BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS | BALL_MAP_NORESERVE, -1, 0 );
+
+			if ( pReserve != BALL_MAP_FAILED )
+			{
+				pBase = reinterpret_cast< uchar_t * >( pReserve );
+
+				const int nProt = BALL_PROT_READ | BALL_PROT_WRITE;
+				const int nFlags = BALL_MAP_SHARED | BALL_MAP_FIXED;
+
+				if ( mmap( pBase, nSize, nProt, nFlags, nFD, 0 ) == BALL_MAP_FAILED ||
+				     mmap( pBase + nSize, nSize, nProt, nFlags, nFD, 0 ) == BALL_MAP_FAILED )
+				{
+					( void )munmap( pBase, 2 * nSize );
+					pBase = nullptr;
+				}
+			}
+		}
+
+		// The mappings keep the memfd alive.
+		( void )close( nFD );
+
+		if ( !pBase )
+			return false;
+
+		m_pElements = reinterpret_cast< T * >( pBase );
+		m_nCapacity = static_cast< I >( nSize / sizeof( T ) );
+		m_nHead = 0;
+		m_nCount = 0;
+
+		return true;
+	}
+
+	/// @brief Unmap the buffer (its contents are lost).
+	void Destroy() noexcept
+	{
+		if ( m_pElements )
+			( void )munmap( m_pElements, 2 * static_cast< size_t >( m_nCapacity ) * sizeof( T ) );
+
+		m_pElements = nullptr;
+		m_nCapacity = 0;
+		m_nHead = 0;
+		m_nCount = 0;
+	}
+
+	bool IsValid() const noexcept { return m_pElements != nullptr; }
+
+	constexpr I Capacity() const noexcept { return m_nCapacity; }
+	constexpr I Count() const noexcept { return m_nCount; }
+	constexpr I Space() const noexcept { return m_nCapacity - m_nCount; }
+	constexpr bool Empty() const noexcept { return !m_nCount; }
+	constexpr bool Full() const noexcept { return m_nCount == m_nCapacity; }
+
+	/// @brief The Count() readable elements, oldest first, as one contiguous view.
+	ConstView_t ReadView() const noexcept { return ConstView_t( m_nCount, m_pElements + m_nHead ); }
+	String_t ReadString() const noexcept { return String_t( m_nCount, m_pElements + m_nHead ); }
+
+	/// @brief The Space() free elements after the newest one, as one contiguous view.
+	View_t WriteView() noexcept { return View_t( Space(), m_pElements + Tail() ); }
+
+	/// @brief Publish @p nCount elements written to the start of WriteView().
+	void Commit( I nCount ) noexcept
+	{
+		BALL_ASSERT( nCount <= Space() );
+
+		m_nCount += nCount;
+	}
+
+	/// @brief Drop the @p nCount oldest elements.
+	void Consume( I nCount ) noexcept
+	{
+		BALL_ASSERT( nCount <= m_nCount );
+
+		m_nCount -= nCount;
+		m_nHead = Advance( nCount );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Append up to Space() elements of @p src.
+	/// @return Number of elements copied.
+	///-----------------------------------------------------------------------------
+	I Write( ConstView_t src ) noexcept
+	{
+		const I nCount = src.Count() < Space() ? src.Count() : Space();
+
+		if ( nCount > 0 )
+		{
+			CopyElements( nCount, m_pElements + Tail(), src.Data() );
+			m_nCount += nCount;
+		}
+
+		return nCount;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Move up to Count() of the oldest elements into @p dest.
+	/// @return Number of elements copied.
+	///-----------------------------------------------------------------------------
+	I Read( View_t dest ) noexcept
+	{
+		const I nCount = dest.Count() < m_nCount ? dest.Count() : m_nCount;
+
+		if ( nCount > 0 )
+		{
+			CopyElements( nCount, dest.Data(), m_pElements + m_nHead );
+			Consume( nCount );
+		}
+
+		return nCount;
+	}
+
+	constexpr void Swap( CRingBuffer &other ) noexcept
+	{
+		Math_Swap( m_pElements, other.m_pElements );
+		Math_Swap( m_nCapacity, other.m_nCapacity );
+		Math_Swap( m_nHead, other.m_nHead );
+		Math_Swap( m_nCount, other.m_nCount );
+	}
+
+private:
+	constexpr I Tail() const noexcept { return Advance( m_nCount ); }
+
+	///-----------------------------------------------------------------------------
+	/// @brief Slot @p nOffset (<= m_nCapacity) elements after the head, wrapped.
+	/// @note  Never forms m_nHead + nOffset, which can exceed MNumber< I >::MAX
+	///        when the capacity is more than half of it.
+	///-----------------------------------------------------------------------------
+	constexpr I Advance( I nOffset ) const noexcept
+	{
+		const I nToEnd = m_nCapacity - m_nHead;
+
+		return nOffset >= nToEnd ? static_cast< I >( nOffset - nToEnd ) : static_cast< I >( m_nHead + nOffset );
+	}
+
+	T *m_pElements = nullptr;   ///< First of the two mappings (the second follows it).
+	I  m_nCapacity = 0;
+	I  m_nHead = 0;             ///< Oldest element, always < m_nCapacity.
+	I  m_nCount = 0;
+}; // class CRingBuffer
+
+using RingBuffer_t =                CRingBuffer< size_t, char_t >;
+
+#endif // !defined( _INCLUDE_BALL_TYPES_RINGBUFFER_HPP_ )
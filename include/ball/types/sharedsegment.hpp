@@ -0,0 +1,556 @@
+#ifndef _INCLUDE_BALL_TYPES_SHAREDSEGMENT_HPP_
+#	define _INCLUDE_BALL_TYPES_SHAREDSEGMENT_HPP_
+
+#	pragma once
+
+#	include "base/arch.h"
+#	include "c/assert.h"
+#	include "c/atomic.h"
+#	include "c/file.h"
+#	include "c/math.h"
+#	include "c/mmap.h"
+#	include "allocator.hpp"
+#	include "memoryview.hpp"
+#	include "string.hpp"
+#	include "stringview.hpp"
+#	include "vector.hpp"
+
+///-----------------------------------------------------------------------------
+/// @brief Named POSIX shared memory segment (shm_open) that containers can
+///        allocate from and other processes attach to.
+/// @note
+///   * Everything stored in the segment is addressed by offsets from its
+///     start (each process maps it at its own address): the allocator state
+///     lives in the segment header, and blocks record their distance to it.
+///   * Allocation is a bump pointer like CArena: Free rewinds the most recent
+///     block and Realloc extends it in place; other blocks stay until the
+///     segment is removed. The size is fixed at Create().
+///   * Publish() names a view (offset, size, element size) in a small
+///     directory in the header; readers Find() it and read the elements in
+///     place. Publish once the data is complete and tell readers afterwards.
+///   * One writer at a time; readers need no locking for published data.
+///-----------------------------------------------------------------------------
+class CSharedSegment
+{
+public:
+	static constexpr uint32_t MAGIC =       0x4253484D; // "BSHM" (without null-terminated)
+	static constexpr uint32_t VERSION =     1;
+	static constexpr size_t   MAX_ENTRIES = 32;
+	static constexpr size_t   MAX_NAME =    40;
+
+	///-----------------------------------------------------------------------------
+	/// @brief Header placed right before every block handed out by CSharedAllocator.
+	///-----------------------------------------------------------------------------
+	struct Block_t
+	{
+		uint64_t nBase; ///< Distance back to the segment start, 0 for heap fallback blocks.
+		uint64_t nSize; ///< Usable size; for heap fallback blocks the distance to the heap block start.
+	}; // struct Block_t
+
+	struct Entry_t
+	{
+		char_t   szName[ MAX_NAME ]; ///< Empty for a free slot.
+		uint64_t nOffset;
+		uint64_t nSize;              ///< Bytes.
+		uint64_t nElementSize;
+	}; // struct Entry_t
+
+	struct Header_t
+	{
+		uint32_t nMagic;
+		uint32_t nVersion;
+		uint64_t nSize;     ///< Segment bytes, header included.
+		uint64_t nCursor;   ///< Offset of the first free byte.
+		uint64_t nLast;     ///< Offset of the most recent block (0 when none).
+		Entry_t  aEntries[ MAX_ENTRIES ];
+	}; // struct Header_t
+
+	CSharedSegment() noexcept = default;
+	~CSharedSegment() noexcept { Close(); }
+
+	CSharedSegment( const CSharedSegment & ) = delete;
+	CSharedSegment &operator=( const CSharedSegment & ) = delete;
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Create the segment @p pszName ("/name") of @p nSize bytes and map it
+	///         writable; closes any previous one.
+	/// @return false when it exists already (see Unlink) or cannot be mapped.
+	///-----------------------------------------------------------------------------
+	bool Create( const char *pszName, size_t nSize )
+	{
+		Close();
+
+		nSize = BALL_ROUND_UP( nSize > sizeof( Header_t ) ? nSize : sizeof( Header_t ), Ball_PageSize() );
+
+		const int nFD = shm_open( pszName, BALL_O_RDWR | BALL_O_CREAT | BALL_O_EXCL | BALL_O_CLOEXEC, 0600 );
+
+		if ( nFD < 0 )
+			return false;
+
+		if ( ftruncate( nFD, static_cast< long >( nSize ) ) != 0 || !Map( nFD, nSize, true ) )
+		{
+			( void )close( nFD );
+			( void )shm_unlink( pszName );
+
+			return false;
+		}
+
+		( void )close( nFD );
+
+		Header_t *pHeader = Header();
+
+		__builtin_memset( pHeader, 0, sizeof( Header_t ) );
+		pHeader->nMagic = MAGIC;
+		pHeader->nVersion = VERSION;
+		pHeader->nSize = nSize;
+		pHeader->nCursor = sizeof( Header_t );
+
+		return true;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Attach to the existing segment @p pszName; closes any previous one.
+	/// @param  bWritable Map it writable (to allocate or publish as the writer).
+	/// @return false when it does not exist or is not a segment of this version.
+	///-----------------------------------------------------------------------------
+	bool Open( const char *pszName, bool bWritable = false )
+	{
+		Close();
+
+		const int nFD = shm_open( pszName, ( bWritable ? BALL_O_RDWR : BALL_O_RDONLY ) | BALL_O_CLOEXEC, 0 );
+
+		if ( nFD < 0 )
+			return false;
+
+		const long nFileSize = lseek( nFD, 0, BALL_SEEK_END );
+		const bool bMapped = nFileSize >= static_cast< long >( sizeof( Header_t ) ) && Map( nFD, static_cast< size_t >( nFileSize ), bWritable );
+
+		( void )close( nFD );
+
+		if ( !bMapped )
+			return false;
+
+		const Header_t *pHeader = Header();
+
+		if ( pHeader->nMagic != MAGIC || pHeader->nVersion != VERSION || pHeader->nSize != m_nSize )
+		{
+			Close();
+
+			return false;
+		}
+
+		return true;
+	}
+
+	/// @brief Unmap the segment; it lives on until unlinked and unmapped everywhere.
+	void Close() noexcept
+	{
+		if ( m_pBase )
+		{
+			Register( false );
+			( void )munmap( m_pBase, m_nSize );
+		}
+
+		m_pBase = nullptr;
+		m_nSize = 0;
+		m_bWritable = false;
+	}
+
+	/// @brief Remove the name @p pszName; attached processes keep their mapping.
+	static bool Unlink( const char *pszName ) noexcept { return shm_unlink( pszName ) == 0; }
+
+	bool IsOpen() const noexcept { return m_pBase != nullptr; }
+	bool IsWritable() const noexcept { return m_bWritable; }
+	size_t Size() const noexcept { return m_nSize; }
+
+	/// @brief Bytes left for allocation.
+	size_t Available() const noexcept { return m_pBase ? static_cast< size_t >( Header()->nSize - Header()->nCursor ) : 0; }
+
+	/// @brief Whether [@p pMem, @p pMem + @p nSize) lies inside the mapping.
+	bool Contains( const void *pMem, size_t nSize = 0 ) const noexcept
+	{
+		const uchar_t *p = reinterpret_cast< const uchar_t * >( pMem );
+
+		return m_pBase && p >= m_pBase && p <= m_pBase + m_nSize && nSize <= static_cast< size_t >( m_pBase + m_nSize - p );
+	}
+
+	/// @brief Offset of @p pMem (inside the segment) from its start.
+	uint64_t Offset( const void *pMem ) const noexcept
+	{
+		BALL_ASSERT( Contains( pMem ) );
+
+		return static_cast< uint64_t >( reinterpret_cast< const uchar_t * >( pMem ) - m_pBase );
+	}
+
+	/// @brief Address of @p nOffset in this process' mapping.
+	template < typename T >
+	T *Resolve( uint64_t nOffset ) const noexcept
+	{
+		BALL_ASSERT( nOffset <= m_nSize );
+
+		return reinterpret_cast< T * >( m_pBase + nOffset );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Allocate @p nSize bytes aligned to @p nAligned (at most a page).
+	/// @return Block pointer or nullptr when the segment is full or read-only.
+	///-----------------------------------------------------------------------------
+	ptr_t Alloc( size_t nSize, size_t nAligned ) noexcept
+	{
+		if ( !m_bWritable )
+			return nullptr;
+
+		return Alloc( Header(), nSize, nAligned );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Name @p view (which must live in the segment) for other processes,
+	///         replacing a previous entry of the same name.
+	/// @return false when the name is too long, the directory is full or the view
+	///         is outside the segment.
+	///-----------------------------------------------------------------------------
+	template < typename I, typename T >
+	bool Publish( const char *pszName, const CMemoryView< I, T > &view ) noexcept
+	{
+		const size_t nBytes = static_cast< size_t >( view.Count() ) * sizeof( T );
+		const size_t nNameLength = CStringView< size_t, const char_t >::Length( pszName );
+
+		if ( !m_bWritable || nNameLength >= MAX_NAME || ( nBytes && !Contains( view.Data(), nBytes ) ) )
+			return false;
+
+		Entry_t *pEntry = FindEntry( pszName, nNameLength );
+
+		if ( !pEntry )
+			pEntry = FindEntry( "", 0 );
+
+		if ( !pEntry )
+			return false;
+
+		pEntry->nOffset = nBytes ? Offset( view.Data() ) : 0;
+		pEntry->nSize = nBytes;
+		pEntry->nElementSize = sizeof( T );
+		__builtin_memcpy( pEntry->szName, pszName, nNameLength + 1 );
+
+		return true;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief The view published as @p pszName, read in place; empty when there is
+	///        no such entry or it holds elements of another size.
+	///-----------------------------------------------------------------------------
+	template < typename T >
+	CMemoryView< size_t, const T > Find( const char *pszName ) const noexcept
+	{
+		const Entry_t *pEntry = m_pBase ? FindEntry( pszName, CStringView< size_t, const char_t >::Length( pszName ) ) : nullptr;
+
+		if ( !pEntry || pEntry->nElementSize != sizeof( T ) || pEntry->nOffset + pEntry->nSize > m_nSize )
+			return CMemoryView< size_t, const T >();
+
+		return CMemoryView< size_t, const T >( static_cast< size_t >( pEntry->nSize / sizeof( T ) ), Resolve< const T >( pEntry->nOffset ) );
+	}
+
+	template < typename T = char_t >
+	CStringView< size_t, const T > FindString( const char *pszName ) const noexcept
+	{
+		const CMemoryView< size_t, const T > view = Find< T >( pszName );
+
+		return CStringView< size_t, const T >( view.Count(), view.Data() );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Segment CSharedAllocator draws from on the calling thread.
+	///-----------------------------------------------------------------------------
+	static CSharedSegment *&Current() noexcept
+	{
+		static thread_local CSharedSegment *s_pCurrent = nullptr;
+
+		return s_pCurrent;
+	}
+
+	static Block_t *HeaderOf( ptr_t pMem ) noexcept
+	{
+		return reinterpret_cast< Block_t * >( pMem ) - 1;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Resize a segment block; in place when it is the most recent one and
+	///         still fits, otherwise into a new block holding a copy.
+	/// @return nullptr (the block is kept) when the segment is mapped read-only.
+	///-----------------------------------------------------------------------------
+	static ptr_t Realloc( ptr_t pMem, size_t nSize, size_t nAligned ) noexcept
+	{
+		Block_t *pBlock = HeaderOf( pMem );
+		Header_t *pHeader = SegmentOf( pMem );
+
+		if ( !IsWritable( pHeader ) )
+			return nullptr;
+
+		const uint64_t nOffset = pBlock->nBase;
+
+		if ( nSize <= pBlock->nSize || ( nOffset == pHeader->nLast && nSize <= pHeader->nSize - nOffset ) )
+		{
+			if ( nOffset == pHeader->nLast )
+				pHeader->nCursor = nOffset + nSize;
+
+			pBlock->nSize = nSize;
+
+			return pMem;
+		}
+
+		const size_t nOldSize = static_cast< size_t >( pBlock->nSize );
+		ptr_t pNew = Alloc( pHeader, nSize, nAligned );
+
+		if ( pNew )
+			__builtin_memcpy( pNew, pMem, nOldSize );
+
+		return pNew;
+	}
+
+	/// @brief Rewind the most recent segment block; other blocks (and every block
+	///        of a read-only mapping) are kept.
+	static void Free( ptr_t pMem ) noexcept
+	{
+		Block_t *pBlock = HeaderOf( pMem );
+		Header_t *pHeader = SegmentOf( pMem );
+
+		if ( pBlock->nBase == pHeader->nLast && IsWritable( pHeader ) )
+		{
+			pHeader->nCursor = pBlock->nBase - sizeof( Block_t );
+			pHeader->nLast = 0;
+		}
+	}
+
+private:
+	Header_t *Header() const noexcept { return reinterpret_cast< Header_t * >( m_pBase ); }
+
+	static Header_t *SegmentOf( ptr_t pMem ) noexcept
+	{
+		return reinterpret_cast< Header_t * >( reinterpret_cast< uchar_t * >( pMem ) - HeaderOf( pMem )->nBase );
+	}
+
+	static ptr_t Alloc( Header_t *pHeader, size_t nSize, size_t nAligned ) noexcept
+	{
+		if ( nAligned < alignof( Block_t ) )
+			nAligned = alignof( Block_t );
+
+		// The mapping is page aligned, so offsets keep the alignment in every process.
+		const uint64_t nOffset = BALL_ROUND_UP( pHeader->nCursor + sizeof( Block_t ), static_cast< uint64_t >( nAligned ) );
+
+		if ( nOffset > pHeader->nSize || nSize > pHeader->nSize - nOffset )
+			return nullptr;
+
+		uchar_t *pMem = reinterpret_cast< uchar_t * >( pHeader ) + nOffset;
+		Block_t *pBlock = HeaderOf( pMem );
+
+		pBlock->nBase = nOffset;
+		pBlock->nSize = nSize;
+
+		pHeader->nCursor = nOffset + nSize;
+		pHeader->nLast = nOffset;
+
+		return pMem;
+	}
+
+	Entry_t *FindEntry( const char *pszName, size_t nNameLength ) const noexcept
+	{
+		for ( Entry_t &entry : Header()->aEntries )
+		{
+			if ( !__builtin_memcmp( entry.szName, pszName, nNameLength ) && !entry.szName[ nNameLength ] )
+				return &entry;
+		}
+
+		return nullptr;
+	}
+
+	bool Map( int nFD, size_t nSize, bool bWritable ) noexcept
+	{
+		void *pMap = mmap( nullptr, nSize, bWritable ? BALL_PROT_READ | BALL_PROT_WRITE : BALL_PROT_READ, BALL_MAP_SHARED, nFD, 0 );
+
+		if ( pMap == BALL_MAP_FAILED )
+			return false;
+
+		m_pBase = reinterpret_cast< uchar_t * >( pMap );
+		m_nSize = nSize;
+		m_bWritable = bWritable;
+
+		Register( true );
+
+		return true;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Add this mapping to (or remove it from) the process' list, which
+	///        the static Realloc/Free consult: the header is shared by every
+	///        process, but whether it may be written depends on each mapping.
+	///-----------------------------------------------------------------------------
+	void Register( bool bAdd ) noexcept
+	{
+		Ball_SpinLock( &s_nMappedLock );
+
+		if ( bAdd )
+		{
+			m_pNextMapped = s_pMapped;
+			s_pMapped = this;
+		}
+		else
+		{
+			CSharedSegment **ppLink = &s_pMapped;
+
+			while ( *ppLink && *ppLink != this )
+				ppLink = &( *ppLink )->m_pNextMapped;
+
+			if ( *ppLink )
+				*ppLink = m_pNextMapped;
+
+			m_pNextMapped = nullptr;
+		}
+
+		Ball_SpinUnlock( &s_nMappedLock );
+	}
+
+	/// @brief Whether the mapping of @p pHeader in this process is writable.
+	static bool IsWritable( const Header_t *pHeader ) noexcept
+	{
+		bool bWritable = false;
+
+		Ball_SpinLock( &s_nMappedLock );
+
+		for ( const CSharedSegment *pSegment = s_pMapped; pSegment; pSegment = pSegment->m_pNextMapped )
+		{
+			if ( pSegment->m_pBase == reinterpret_cast< const uchar_t * >( pHeader ) )
+			{
+				bWritable = pSegment->m_bWritable;
+				break;
+			}
+		}
+
+		Ball_SpinUnlock( &s_nMappedLock );
+
+		return bWritable;
+	}
+
+	static inline Ball_SpinLock_t s_nMappedLock = 0;
+	static inline CSharedSegment *s_pMapped = nullptr;
+
+	uchar_t        *m_pBase = nullptr;
+	size_t          m_nSize = 0;
+	bool            m_bWritable = false;
+	CSharedSegment *m_pNextMapped = nullptr;
+}; // class CSharedSegment
+
+///-----------------------------------------------------------------------------
+/// @brief Binds @p segment as CSharedSegment::Current() for the enclosing scope.
+///-----------------------------------------------------------------------------
+class CSharedSegmentScope
+{
+public:
+	explicit CSharedSegmentScope( CSharedSegment &segment ) noexcept : m_pPrevious( CSharedSegment::Current() ) { CSharedSegment::Current() = &segment; }
+	~CSharedSegmentScope() noexcept { CSharedSegment::Current() = m_pPrevious; }
+
+	CSharedSegmentScope( const CSharedSegmentScope & ) = delete;
+	CSharedSegmentScope &operator=( const CSharedSegmentScope & ) = delete;
+
+private:
+	CSharedSegment *m_pPrevious;
+}; // class CSharedSegmentScope
+
+///-----------------------------------------------------------------------------
+/// @brief Allocation entry point drawing from the calling thread's CSharedSegment.
+/// @note  Blocks find their segment through their header, so Free/Realloc do not
+///        depend on the scope still being active, but the segment must stay
+///        mapped while they live. Without a bound segment, requests fall back to
+///        CAllocatorBase (the blocks carry the same header and are freed normally).
+///-----------------------------------------------------------------------------
+class CSharedAllocatorBase
+{
+public:
+	using Block_t = CSharedSegment::Block_t;
+
+	/// No BALL_ALLOC_* policy: blocks are carved out of the segment unpadded.
+	static constexpr uint32_t FLAGS = 0;
+
+	static void *Alloc( size_t nSize, size_t nAligned )
+	{
+		CSharedSegment *pSegment = CSharedSegment::Current();
+
+		if ( pSegment )
+			return pSegment->Alloc( nSize, nAligned );
+
+		const size_t nOffset = nAligned > sizeof( Block_t ) ? nAligned : sizeof( Block_t );
+		uchar_t *pHeap = reinterpret_cast< uchar_t * >( CAllocatorBase::Alloc( nOffset + nSize, nOffset ) );
+
+		if ( !pHeap )
+			return nullptr;
+
+		Block_t *pHeader = CSharedSegment::HeaderOf( pHeap + nOffset );
+
+		pHeader->nBase = 0;
+		pHeader->nSize = nOffset;
+
+		return pHeap + nOffset;
+	}
+
+	static void *Realloc( ptr_t pMem, size_t nSize, size_t nAligned )
+	{
+		if ( !pMem )
+			return Alloc( nSize, nAligned );
+
+		const Block_t *pHeader = CSharedSegment::HeaderOf( pMem );
+
+		if ( pHeader->nBase )
+			return CSharedSegment::Realloc( pMem, nSize, nAligned );
+
+		const size_t nOffset = static_cast< size_t >( pHeader->nSize );
+
+		BALL_ASSERT( nAligned <= nOffset );
+
+		uchar_t *pHeap = reinterpret_cast< uchar_t * >( CAllocatorBase::Realloc( reinterpret_cast< uchar_t * >( pMem ) - nOffset, nOffset + nSize, nOffset ) );
+
+		return pHeap ? pHeap + nOffset : nullptr;
+	}
+
+	static void Free( ptr_t pMem )
+	{
+		if ( !pMem )
+			return;
+
+		const Block_t *pHeader = CSharedSegment::HeaderOf( pMem );
+
+		if ( pHeader->nBase )
+			CSharedSegment::Free( pMem );
+		else
+			CAllocatorBase::Free( reinterpret_cast< uchar_t * >( pMem ) - pHeader->nSize );
+	}
+
+	static size_t Size( ptr_t pMem, size_t nAligned, size_t nOffset = 0 )
+	{
+		const Block_t *pHeader = CSharedSegment::HeaderOf( pMem );
+
+		if ( pHeader->nBase )
+			return static_cast< size_t >( pHeader->nSize );
+
+		return CAllocatorBase::Size( reinterpret_cast< uchar_t * >( pMem ) - pHeader->nSize, nAligned, nOffset ) - static_cast< size_t >( pHeader->nSize );
+	}
+}; // class CSharedAllocatorBase
+
+template < typename I, typename T >
+class CSharedAllocator : public CSharedAllocatorBase
+{
+public:
+	using Base_t = CSharedAllocatorBase;
+
+	static T *Alloc( I nCount, size_t nAligned )
+	{
+		return reinterpret_cast< T * >( Base_t::Alloc( nCount * sizeof( T ), nAligned ) );
+	}
+
+	static T *Realloc( T *pMem, I nCount, size_t nAligned )
+	{
+		return reinterpret_cast< T * >( Base_t::Realloc( pMem, nCount * sizeof( T ), nAligned ) );
+	}
+}; // class CSharedAllocator
+
+template < typename T > using SharedVector_t =      CVector< size_t, T, CSharedAllocator< size_t, T > >;
+using SharedString_t =                              CString< size_t, char_t, CSharedAllocator< size_t, char_t > >;
+
+#endif // !defined( _INCLUDE_BALL_TYPES_SHAREDSEGMENT_HPP_ )
@@ -0,0 +1,227 @@
+#ifndef _INCLUDE_BALL_TYPES_SPARSEARRAY_HPP_
+#	define _INCLUDE_BALL_TYPES_SPARSEARRAY_HPP_
+
+#	pragma once
+
+#	include "base/arch.h"
+#	include "c/assert.h"
+#	include "c/math.h"
+#	include "c/mmap.h"
+#	include "elements.hpp"
+#	include "memoryaligned.h"
+#	include "meta/istriviallydestructible.hpp"
+#	include "xvalue.hpp"
+
+///-----------------------------------------------------------------------------
+/// @brief Array over a huge, sparsely used index space: element @p n lives at
+///        Data() + n, so lookups are O(1) with no hashing or indirection.
+/// @note
+///   * One MAP_NORESERVE mapping holds the elements, an occupancy bit per
+///     element and a live count per page. Nothing is committed up front: the
+///     kernel backs a page on first touch (reads see the shared zero page),
+///     so memory follows the touched index ranges.
+///   * A data page whose last element is removed is returned to the OS
+///     (MADV_DONTNEED) and reads as zeros again.
+///   * sizeof( T ) must be a power of two no larger than a page, so no
+///     element straddles two pages. Not thread-safe.
+///-----------------------------------------------------------------------------
+template < typename I, typename T >
+class CSparseArray
+{
+public:
+	using Index_t =     I;
+	using Element_t =   T;
+
+	static_assert( ( sizeof( T ) & ( sizeof( T ) - 1 ) ) == 0, "CSparseArray: element size must be a power of two" );
+
+	explicit CSparseArray( I nMaxCount ) noexcept
+	{
+		const size_t nPage = Ball_PageSize();
+
+		BALL_ASSERT_MESSAGE( sizeof( T ) <= nPage, "CSparseArray: element larger than a page" );
+
+		if ( !nMaxCount || sizeof( T ) > nPage || static_cast< size_t >( nMaxCount ) > ~static_cast< size_t >( 0 ) / 2 / sizeof( T ) )
+			return;
+
+		const size_t nDataSize = BALL_ROUND_UP( static_cast< size_t >( nMaxCount ) * sizeof( T ), nPage );
+		const size_t nBitmapSize = BALL_ROUND_UP( ( static_cast< size_t >( nMaxCount ) + 63 ) / 64 * sizeof( uint64_t ), nPage );
+		const size_t nCountsSize = BALL_ROUND_UP( nDataSize / nPage * sizeof( uint32_t ), nPage );
+		const size_t nMapLength = nDataSize + nBitmapSize + nCountsSize;
+
+		void *pMap = mmap( nullptr, nMapLength, BALL_PROT_READ | BALL_PROT_WRITE, BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS | BALL_MAP_NORESERVE, -1, 0 );
+
+		BALL_ASSERT_MESSAGE( pMap != BALL_MAP_FAILED, "Failed to reserve sparse array" );
+
+		if ( pMap == BALL_MAP_FAILED )
+			return;
+
+		m_pElements = reinterpret_cast< T * >( pMap );
+		m_pBitmap = reinterpret_cast< uint64_t * >( reinterpret_cast< uchar_t * >( pMap ) + nDataSize );
+		m_pPageCounts = reinterpret_cast< uint32_t * >( reinterpret_cast< uchar_t * >( pMap ) + nDataSize + nBitmapSize );
+		m_nMapLength = nMapLength;
+		m_nMaxCount = nMaxCount;
+		m_nPageShift = static_cast< uint32_t >( __builtin_ctzll( nPage / sizeof( T ) ) );
+	}
+
+	~CSparseArray() noexcept
+	{
+		if ( !m_pElements )
+			return;
+
+		RemoveAll();
+		( void )munmap( m_pElements, m_nMapLength );
+	}
+
+	CSparseArray( const CSparseArray & ) = delete;
+	CSparseArray &operator=( const CSparseArray & ) = delete;
+
+	bool IsValid() const noexcept { return m_pElements != nullptr; }
+
+	/// @brief Indices are 0 .. MaxCount() - 1.
+	constexpr I MaxCount() const noexcept { return m_nMaxCount; }
+
+	/// @brief Number of occupied indices.
+	constexpr I Count() const noexcept { return m_nCount; }
+
+	/// @brief Data pages holding at least one element.
+	constexpr size_t UsedPages() const noexcept { return m_nUsedPages; }
+
+	bool Contains( I nIndex ) const noexcept
+	{
+		return static_cast< size_t >( nIndex ) < static_cast< size_t >( m_nMaxCount ) && ( m_pBitmap[ nIndex / 64 ] >> ( nIndex % 64 ) & 1u );
+	}
+
+	/// @brief Element at @p nIndex, or nullptr when the index is not occupied.
+	T *Find( I nIndex ) noexcept { return Contains( nIndex ) ? m_pElements + nIndex : nullptr; }
+	const T *Find( I nIndex ) const noexcept { return Contains( nIndex ) ? m_pElements + nIndex : nullptr; }
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Store @p value at @p nIndex (constructed, or assigned when occupied).
+	/// @return The element.
+	///-----------------------------------------------------------------------------
+	template < typename U >
+	T &Set( I nIndex, U &&value )
+	{
+		BALL_ASSERT( static_cast< size_t >( nIndex ) < static_cast< size_t >( m_nMaxCount ) );
+
+		T *pElement = m_pElements + nIndex;
+
+		if ( Contains( nIndex ) )
+		{
+			*pElement = Forward< U >( value );
+
+			return *pElement;
+		}
+
+		ConstructElement( pElement, Forward< U >( value ) );
+
+		m_pBitmap[ nIndex / 64 ] |= static_cast< uint64_t >( 1 ) << ( nIndex % 64 );
+		m_nCount++;
+
+		if ( !m_pPageCounts[ nIndex >> m_nPageShift ]++ )
+			m_nUsedPages++;
+
+		return *pElement;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Destroy the element at @p nIndex; an emptied page goes back to the OS.
+	/// @return false when the index was not occupied.
+	///-----------------------------------------------------------------------------
+	bool Remove( I nIndex ) noexcept
+	{
+		if ( !Contains( nIndex ) )
+			return false;
+
+		DestructElement( m_pElements + nIndex );
+
+		m_pBitmap[ nIndex / 64 ] &= ~( static_cast< uint64_t >( 1 ) << ( nIndex % 64 ) );
+		m_nCount--;
+
+		const size_t nPage = static_cast< size_t >( nIndex >> m_nPageShift );
+
+		if ( !--m_pPageCounts[ nPage ] )
+			ReleasePage( nPage );
+
+		return true;
+	}
+
+	/// @brief Remove every element; all data pages go back to the OS.
+	void RemoveAll() noexcept
+	{
+		if constexpr ( !IS_TRIVIALLY_DESTRUCTIBLE< T > )
+			ForEach( []( I, T &element ) { DestructElement( &element ); } );
+
+		if ( m_pElements && m_nCount )
+		{
+			// The bitmap and page counts are zero again too.
+			( void )madvise( m_pElements, m_nMapLength, BALL_MADV_DONTNEED );
+		}
+
+		m_nCount = 0;
+		m_nUsedPages = 0;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Call @p fn( index, element ) for every element in index order;
+	///        skips unused pages, so the cost follows UsedPages().
+	///-----------------------------------------------------------------------------
+	template < class F >
+	void ForEach( F &&fn )
+	{
+		if ( !m_nCount )
+			return;
+
+		const size_t nPerPage = static_cast< size_t >( 1 ) << m_nPageShift;
+		const size_t nPages = ( static_cast< size_t >( m_nMaxCount ) + nPerPage - 1 ) >> m_nPageShift;
+
+		for ( size_t nPage = 0; nPage < nPages; nPage++ )
+		{
+			if ( !m_pPageCounts[ nPage ] )
+				continue;
+
+			const size_t nBegin = nPage << m_nPageShift;
+			const size_t nEnd = nBegin + nPerPage < static_cast< size_t >( m_nMaxCount ) ? nBegin + nPerPage : static_cast< size_t >( m_nMaxCount );
+
+			for ( size_t nWord = nBegin / 64; nWord * 64 < nEnd; nWord++ )
+			{
+				uint64_t nBits = m_pBitmap[ nWord ];
+
+				while ( nBits )
+				{
+					const size_t nIndex = nWord * 64 + static_cast< size_t >( __builtin_ctzll( nBits ) );
+
+					nBits &= nBits - 1;
+
+					// Pages smaller than 64 elements share a bitmap word.
+					if ( nIndex >= nBegin && nIndex < nEnd )
+						fn( static_cast< I >( nIndex ), m_pElements[ nIndex ] );
+				}
+			}
+		}
+	}
+
+private:
+	void ReleasePage( size_t nPage ) noexcept
+	{
+		const size_t nPageSize = sizeof( T ) << m_nPageShift;
+
+		( void )madvise( reinterpret_cast< uchar_t * >( m_pElements ) + nPage * nPageSize, nPageSize, BALL_MADV_DONTNEED );
+
+		m_nUsedPages--;
+	}
+
+	T        *m_pElements = nullptr;
+	uint64_t *m_pBitmap = nullptr;      ///< One occupancy bit per index.
+	uint32_t *m_pPageCounts = nullptr;  ///< Live elements per data page.
+	size_t    m_nMapLength = 0;
+	size_t    m_nUsedPages = 0;
+	I         m_nMaxCount = 0;
+	I         m_nCount = 0;
+	uint32_t  m_nPageShift = 0;         ///< log2 of elements per page.
+}; // class CSparseArray
+
+template < typename T > using SparseArray_t =       CSparseArray< size_t, T >;
+template < typename T > using SparseArray32_t =     CSparseArray< uint32_t, T >;
+
+#endif // !defined( _INCLUDE_BALL_TYPES_SPARSEARRAY_HPP_ )
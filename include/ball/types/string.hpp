@@ -399,31 +399,32 @@ public:
 	}
 };
 
-template < typename I, typename T, I N > class CBufferString;
+template < typename I, typename T, I N, class A, class G > class CBufferString;
 
-template < typename I = size_t, typename T = char >
-class CString : public CStringImpl< CVectorBase< CStringView< I, T >, I, T >, I, T >
+template < typename I = size_t, typename T = char, class A = CAllocator< I, T >, class G = CGrowPowerOfTwo >
+class CString : public CStringImpl< CVectorBase< CStringView< I, T >, I, T, A, G >, I, T >
 {
 public:
-	using Base_t = CStringImpl< CVectorBase< CStringView< I, T >, I, T >, I, T >;
+	using Base_t = CStringImpl< CVectorBase< CStringView< I, T >, I, T, A, G >, I, T >;
 	using Base_t::Base_t;
 
-	template < I N >
-	CString( const CBufferString< I, T, N > &other ) :
+	template < I N, class A2, class G2 >
+	CString( const CBufferString< I, T, N, A2, G2 > &other ) :
 		Base_t()
 	{
 		Base_t::CopyFrom( other.View() );
 	}
 };
 
-template < typename I, typename T, I N >
-class CBufferString : public CStringImpl< CVectorBase_Growable< CStringView< I, T >, I, T, N >, I, T >
+template < typename I, typename T, I N, class A = CAllocator< I, T >, class G = CGrowPowerOfTwo >
+class CBufferString : public CStringImpl< CVectorBase_Growable< CStringView< I, T >, I, T, N, A, G >, I, T >
 {
 public:
-	using Base_t = CStringImpl< CVectorBase_Growable< CStringView< I, T >, I, T, N >, I, T >;
+	using Base_t = CStringImpl< CVectorBase_Growable< CStringView< I, T >, I, T, N, A, G >, I, T >;
 	using Base_t::Base_t;
 
-	CBufferString( const CString< I, T > &other ) :
+	template < class A2, class G2 >
+	CBufferString( const CString< I, T, A2, G2 > &other ) :
 		Base_t()
 	{
 		Base_t::CopyFrom( other.View() );
@@ -460,6 +461,9 @@ using UTF32String16_t = CString< uint16_t, char32_t >;
 using UTF32String32_t = CString< uint32_t, char32_t >;
 using UTF32String64_t = CString< uint64_t, char32_t >;
 
+using PaddedString_t =  CString< size_t, char_t, CAllocator< size_t, char_t, BALL_ALLOC_PADDED > >;
+using ResourceString_t = CString< size_t, char_t, CResourceAllocator< size_t, char_t > >;
+
 template < size_t N >   using BufferString_t =           CBufferString< size_t, char_t, N >;
 template < uint8_t N >  using BufferString8_t =          CBufferString< uint8_t, char_t, N >;
 template < uint16_t N > using BufferString16_t =         CBufferString< uint16_t, char_t, N >;
@@ -125,16 +125,16 @@ public:
 			: CStringView( Length() - nCount, String() );
 	}
 
-	/// @brief constexpr memcmp implementation.
+	/// @brief constexpr memcmp implementation (characters ordered as T).
+	/// @note  The equal prefix is skipped by the vector kernels (MismatchElements).
 	static constexpr int Compare( const T *pLeft, const T *pRight, I nLength ) noexcept
 	{
-		for ( I i = 0; i < nLength; ++i )
-		{
-			if ( pLeft[ i ] < pRight[ i ] ) return -1;
-			if ( pLeft[ i ] > pRight[ i ] ) return  1;
-		}
+		const I i = MismatchElements( nLength, pLeft, pRight );
+
+		if ( i == nLength )
+			return 0;
 
-		return 0;
+		return ( pLeft[ i ] < pRight[ i ] ) ? -1 : 1;
 	}
 
 	constexpr int8_t Compare( CStringView rhs ) const noexcept
@@ -158,7 +158,7 @@ public:
 	{
 		const I n = Length();
 
-		return ( n == rhs.Length() ) && ( n == I( 0 ) || Compare( String(), rhs.String(), n ) == 0 );
+		return ( n == rhs.Length() ) && ( n == I( 0 ) || MismatchElements( n, String(), rhs.String() ) == n );
 	}
 };
 
@@ -9,6 +9,8 @@
 #	include "c/memoryaligned.h"
 #	include "meta/number.hpp"
 #	include "allocator.hpp"
+#	include "growth.hpp"
+#	include "memoryresource.hpp"
 #	include "memoryview.hpp"
 #	include "bits.hpp"
 #	include "math.hpp"
@@ -17,7 +19,7 @@
 // ===============================
 // CVectorBase (now derives from CMemoryView)
 // ===============================
-template < class B, typename I, typename T, class A = CAllocator< I, T > >
+template < class B, typename I, typename T, class A = CAllocator< I, T >, class G = CGrowPowerOfTwo >
 class CVectorBase : public B
 {
 public:
@@ -25,6 +27,7 @@ public:
 	using Index_t =     I;
 	using Element_t =   T;
 	using Allocator_t = A;
+	using Growth_t =    G;
 	using Number_t =    MNumber< Index_t >;
 	using Unsigned_t =  typename Number_t::U;
 	using View_t =      Base_t;
@@ -38,6 +41,9 @@ public:
 	static constexpr size_t ALIGNED_SIZE = NextPowerOfTwo_Const( 8 * sizeof( Element_t ) );
 	static constexpr I INVALID_INDEX = Number_t::INVALID;
 
+	/// Storage is followed by BALL_ALLOC_PADDING readable bytes (a BALL_ALLOC_PADDED allocator).
+	static constexpr bool IS_PADDED = ( Allocator_t::FLAGS & BALL_ALLOC_PADDED ) != 0;
+
 	/// @brief Default / external ctor. Does not assume ownership semantics beyond this instance.
 	constexpr ~CVectorBase() noexcept
 	{
@@ -45,7 +51,7 @@ public:
 
 		if ( pElements )
 		{
-			Allocator_t::Free( pElements );
+			m_Allocator.Free( pElements );
 		}
 	}
 
@@ -53,43 +59,182 @@ public:
 	// Basic queries / accessors.
 	// ---------------------------
 
-	/// @warning This returns next power-of-two of Count(), not a tracked internal capacity.
-	constexpr I Capacity() const noexcept { return NextPowerOfTwo( Count() ); }
+	/// @brief Number of elements the heap block can hold (0 without storage).
+	constexpr I Capacity() const noexcept { return m_nCapacity; }
 	constexpr size_t CapacitySize() const noexcept { return static_cast< size_t >( Capacity() ) * sizeof( Element_t ); }
 
+	/// @brief Allocator the heap block comes from (empty for the static allocators).
+	constexpr Allocator_t &Allocator() noexcept { return m_Allocator; }
+	constexpr const Allocator_t &Allocator() const noexcept { return m_Allocator; }
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Allocate from @p allocator (e.g. a CResourceAllocator bound to
+	///         another resource) from now on.
+	/// @return false while the vector owns a heap block, which has to go back
+	///         to the allocator it came from.
+	///-----------------------------------------------------------------------------
+	constexpr bool SetAllocator( const Allocator_t &allocator ) noexcept
+	{
+		if ( m_nCapacity )
+			return false;
+
+		m_Allocator = allocator;
+
+		return true;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief The elements as a CPaddedView: SIMD kernels may read a whole vector
+	///        past Count() without faulting.
+	///-----------------------------------------------------------------------------
+	constexpr CPaddedView< I, const T > PaddedView() const noexcept
+	{
+		static_assert( IS_PADDED, "PaddedView() requires a BALL_ALLOC_PADDED allocator" );
+
+		return CPaddedView< I, const T >( Count(), Data() );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Make room for at least @p nCount elements (rounded by Growth_t)
+	///        so that appending up to it does not touch the allocator.
+	///-----------------------------------------------------------------------------
+	constexpr void Reserve( I nCount )
+	{
+		Set( Count(), EnsureCapacity( nCount ) );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Reserve(), then optionally fault in the spare capacity (see
+	///        Ball_MemPopulate) so later appends do not take page faults.
+	///-----------------------------------------------------------------------------
+	constexpr void Reserve( I nCount, bool bPopulate )
+	{
+		Reserve( nCount );
+
+		if ( bPopulate && Capacity() > Count() )
+			Ball_MemPopulate( Data() + Count(), CapacitySize() - Base_t::Size() );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Shrink the heap block to exactly Count() elements (free it when empty).
+	///-----------------------------------------------------------------------------
+	constexpr void ShrinkToFit()
+	{
+		const I nCount = Count();
+		T *pElements = Data();
+
+		if ( !pElements || nCount == m_nCapacity )
+			return;
+
+		if ( !nCount )
+		{
+			m_Allocator.Free( pElements );
+			pElements = nullptr;
+		}
+		else
+		{
+			pElements = ReallocElements( pElements, nCount, ALIGNED_SIZE );
+			BALL_ASSERT_MESSAGE( pElements != nullptr, "Failed to reallocate elements" );
+
+			if ( !pElements )
+				return;
+		}
+
+		m_nCapacity = nCount;
+		Set( nCount, pElements );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief  Give each of the @p nCount vectors at @p pVectors (empty, without
+	///         storage) room for pCapacities[ n ] elements, all carved out of one
+	///         allocation (AllocMany of their allocator) instead of one each.
+	/// @return false, leaving the vectors as they were, when it cannot be made or
+	///         a capacity does not fit Index_t.
+	/// @note   The capacities are taken as given; Growth_t rounds from the first
+	///         regrowth on, when a vector outgrowing its block moves into a block
+	///         of its own. Growable vectors, whose empty storage is their inline
+	///         buffer, are not supported.
+	///-----------------------------------------------------------------------------
+	template < class V >
+	static bool ReserveMany( V *pVectors, const size_t *pCapacities, size_t nCount )
+	{
+		static_assert( !V::IS_GROWABLE, "ReserveMany() requires vectors without an inline buffer" );
+		static_assert( requires( Allocator_t &allocator, T **ppBlocks ) { allocator.AllocMany( ppBlocks, pCapacities, nCount, ALIGNED_SIZE ); },
+			"ReserveMany() requires an allocator with AllocMany (e.g. CAllocator)" );
+
+		if ( !nCount )
+			return true;
+
+		for ( size_t n = 0; n < nCount; n++ )
+		{
+			if ( pCapacities[ n ] > static_cast< size_t >( Number_t::MAX ) )
+				return false;
+		}
+
+		T **ppBlocks = reinterpret_cast< T ** >( CAllocatorBase::Alloc( nCount * sizeof( T * ), alignof( T * ) ) );
+
+		if ( !ppBlocks )
+			return false;
+
+		CVectorBase &first = pVectors[ 0 ];
+		const bool bAllocated = first.m_Allocator.AllocMany( ppBlocks, pCapacities, nCount, ALIGNED_SIZE );
+
+		if ( bAllocated )
+		{
+			for ( size_t n = 0; n < nCount; n++ )
+			{
+				CVectorBase &vec = pVectors[ n ];
+
+				BALL_ASSERT( !vec.Data() );
+
+				if ( !ppBlocks[ n ] )
+					continue;
+
+				vec.m_Allocator = first.m_Allocator;
+				vec.m_nCapacity = static_cast< I >( pCapacities[ n ] );
+				vec.Set( 0, ppBlocks[ n ] );
+			}
+		}
+
+		CAllocatorBase::Free( ppBlocks );
+
+		return bAllocated;
+	}
+
 protected:
 	using Base_t::Set;
 
 	///-----------------------------------------------------------------------------
 	/// @brief Ensure the backing heap storage can hold at least @p nRequestCapacity
-	///        elements (rounded up to a power of two).
+	///        elements (rounded up by the growth policy).
 	///
 	/// Behavior overview:
-	///   - Rounds @p nRequestCapacity to the next power of two via NextPowerOfTwo().
-	///   - Grows only (never shrinks heap capacity). If the rounded capacity is
-	///     <= current derived capacity (see below), it is a no-op.
-	///   - Uses Allocator_t::Realloc() when storage already exists; otherwise
-	///     Allocator_t::Alloc() to create a new heap block.
+	///   - No-op (a single compare) while @p nRequestCapacity <= Capacity().
+	///   - Rounds @p nRequestCapacity up via Growth_t::Capacity() (the next power
+	///     of two with the default CGrowPowerOfTwo, see growth.hpp).
+	///   - Grows only (never shrinks heap capacity; see ShrinkToFit()).
+	///   - Uses ReallocElements() when storage already exists; otherwise
+	///     Allocator().Alloc() to create a new heap block.
 	///
 	/// Important notes and invariants:
-	///   - Capacity() here is *derived from Count()* (next power of two) rather
-	///     than being tracked as a dedicated member. This class assumes callers
-	///     will not rely on a stored capacity field.
+	///   - Capacity() is the stored element capacity of the current heap block,
+	///     updated here whenever the allocator hands out a new block, so a run of
+	///     appends costs O(log n) allocator calls.
 	///   - NUM_ALIGNED/ALIGNED_SIZE act as allocator hints for bucket/alignment.
 	///     The allocator is expected to understand ALIGNED_SIZE as a preferred
 	///     alignment/size class for amortized growth.
-	///   - On overflow of power-of-two computation, NextPowerOfTwo() yields
+	///   - When no capacity can be represented, Growth_t::Capacity() yields
 	///     Number_t::INVALID; we assert and bail defensively.
-	///   - No element moves/copies occur here; this function is *purely about
-	///     reserving heap memory*. The caller is responsible for updating
+	///   - No element moves/copies occur here beyond relocating the live ones
+	///     into a new block; this function is *purely about reserving heap memory*. The caller is responsible for updating
 	///     the vector’s internal state (e.g., Set) and for constructing
 	///     or moving elements if required elsewhere.
 	///   - Not thread-safe. External synchronization is required for concurrent use.
 	///
 	/// Complexity:
 	///   - O(1) when no allocation occurs.
-	///   - O(1) expected for Alloc/Realloc (allocator-dependent); element
-	///     relocation, if any, is an allocator concern and not performed here.
+	///   - O(1) expected for Alloc/Realloc (allocator-dependent); O(n) when the
+	///     elements are not trivially relocatable (see ReallocElements()).
 	///
 	/// Safety:
 	///   - At call sites is preserved by policy; we assert
@@ -101,18 +246,20 @@ protected:
 	///-----------------------------------------------------------------------------
 	constexpr T *EnsureCapacity( I nRequestCapacity )
 	{
-		// Normalize request: round up to next power of two.
-		nRequestCapacity = NextPowerOfTwo( nRequestCapacity );
-
 		// Current heap pointer (may be null if nothing allocated yet).
 		T *pElements = Data();
 
-		// Guard against overflow in power-of-two computation.
+		// Fast path: the current block is large enough.
+		if ( nRequestCapacity <= m_nCapacity )
+			return pElements;
+
+		// Normalize request: round up by the growth policy.
+		nRequestCapacity = Growth_t::template Capacity< I >( m_nCapacity, nRequestCapacity, I( 0 ), sizeof( T ) );
+
+		// Guard against overflow in the capacity computation.
 		BALL_ASSERT_MESSAGE( nRequestCapacity != Number_t::INVALID, "Capacity overflow!" );
 
-		// If overflow detected or the requested (rounded) capacity is not greater
-		// than the current derived capacity, nothing to do.
-		if ( nRequestCapacity == Number_t::INVALID || nRequestCapacity < Capacity() )
+		if ( nRequestCapacity == Number_t::INVALID )
 			return pElements;
 
 		// Grow path:
@@ -120,17 +267,20 @@ protected:
 		// - Otherwise, allocate a fresh block.
 		if ( pElements )
 		{
-			// Re-bucket to the new power-of-two capacity. ALIGNED_SIZE is a hint.
-			pElements = Allocator_t::Realloc( pElements, nRequestCapacity, ALIGNED_SIZE );
+			// Re-bucket to the new capacity. ALIGNED_SIZE is a hint.
+			pElements = ReallocElements( pElements, nRequestCapacity, ALIGNED_SIZE );
 			BALL_ASSERT_MESSAGE( pElements != nullptr, "Failed to reallocate elements" );
 		}
 		else
 		{
-			// First-time allocation to the requested power-of-two capacity.
-			pElements = Allocator_t::Alloc( nRequestCapacity, ALIGNED_SIZE );
+			// First-time allocation to the rounded capacity.
+			pElements = m_Allocator.Alloc( nRequestCapacity, ALIGNED_SIZE );
 			BALL_ASSERT_MESSAGE( pElements != nullptr, "Failed to allocate elements" );
 		}
 
+		if ( pElements )
+			m_nCapacity = nRequestCapacity;
+
 		// Note: We intentionally do not call Set() here; the caller controls
 		// when to commit the new pointer/size relationship to Base_t.
 		return pElements;
@@ -153,17 +303,75 @@ protected:
 		return *this;
 	}
 
-	using Base_t::MoveFrom;
+	/// @brief Exchange storage (elements, count, capacity and allocator) with @p other.
+	constexpr void Swap( CVectorBase &other ) noexcept
+	{
+		Base_t::Swap( other );
+		Math_Swap( m_nCapacity, other.m_nCapacity );
+		Math_Swap( m_Allocator, other.m_Allocator );
+	}
+
+	constexpr CVectorBase &MoveFrom( CVectorBase &&other ) noexcept
+	{
+		if ( this != &other )
+			Swap( other );
+
+		return *this;
+	}
+
+	/// @brief Adopt the elements of a plain view; its extent is all that is known.
+	constexpr CVectorBase &MoveFrom( View_t &&other ) noexcept
+	{
+		Base_t::MoveFrom( Move( other ) );
+		m_nCapacity = Count();
+
+		return *this;
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Resize heap block @p pElements holding the Count() live elements.
+	/// @note  Allocator().Realloc may move the block bytewise (mremap/memcpy), which
+	///        is only valid for IS_TRIVIALLY_RELOCATABLE elements; anything else gets
+	///        a new block and a move construction + destruction per element.
+	/// @return The new block, or nullptr (the old block is then left untouched).
+	///-----------------------------------------------------------------------------
+	constexpr T *ReallocElements( T *pElements, I nNewCapacity, size_t nAligned )
+	{
+		if constexpr ( IS_TRIVIALLY_RELOCATABLE< T > )
+		{
+			return m_Allocator.Realloc( pElements, nNewCapacity, nAligned );
+		}
+		else
+		{
+			T *pNewElements = m_Allocator.Alloc( nNewCapacity, nAligned );
+
+			if ( pNewElements )
+			{
+				RelocateElements( Count(), pNewElements, pElements );
+				m_Allocator.Free( pElements );
+			}
+
+			return pNewElements;
+		}
+	}
+
+	/// @brief Used by CVectorBase_Growable when it moves between fixed and heap storage.
+	constexpr void SetCapacity( I nCapacity ) noexcept { m_nCapacity = nCapacity; }
+
+private:
+	I m_nCapacity = 0;
+	[[ no_unique_address ]] Allocator_t m_Allocator;
 };
 
-template < class B, typename I, typename T, I N, class A = CAllocator< I, T > >
-class CVectorBase_Growable : public CVectorBase< B, I, T, A >
+template < class B, typename I, typename T, I N, class A = CAllocator< I, T >, class G = CGrowPowerOfTwo >
+class CVectorBase_Growable : public CVectorBase< B, I, T, A, G >
 {
 public:
-	using Base_t =      CVectorBase< B, I, T, A >;
+	using Base_t =      CVectorBase< B, I, T, A, G >;
 	using Index_t =     Base_t::Index_t;
 	using Element_t =   Base_t::Element_t;
 	using Allocator_t = Base_t::Allocator_t;
+	using Growth_t =    Base_t::Growth_t;
 	using Number_t =    Base_t::Number_t;
 	using Unsigned_t =  Base_t::Unsigned_t;
 	using View_t =      Base_t::View_t;
@@ -177,19 +385,19 @@ public:
 	static constexpr size_t ALIGNED_SIZE = NextPowerOfTwo_Const( N * sizeof( Element_t ) );
 	static constexpr I INVALID_INDEX = Number_t::INVALID;
 
-	constexpr CVectorBase_Growable() noexcept : Base_t( 0, reinterpret_cast< Element_t * >( &m_FixedElements ) ) {}
+	constexpr CVectorBase_Growable() noexcept : Base_t( 0, FixedData() ) {}
 	constexpr ~CVectorBase_Growable() noexcept
 	{
 		if ( IsOverflow() )
 		{
-			Allocator_t::Free( Base_t::Data() );
+			Base_t::Allocator().Free( Base_t::Data() );
 		}
 
 		Base_t::Set( 0, nullptr );
 	}
 
-	/// @warning This returns next power-of-two of Count(), not a tracked internal capacity.
-	constexpr I Capacity() const noexcept { return NextPowerOfTwo< I, N >( Count() ); }
+	/// @brief Elements the current storage can hold: the heap block when overflowed, N otherwise.
+	constexpr I Capacity() const noexcept { return IsOverflow() ? Base_t::Capacity() : FixedCount(); }
 	constexpr size_t CapacitySize() const noexcept { return static_cast< size_t >( Capacity() ) * sizeof( Element_t ); }
 
 	constexpr I FixedCount() const noexcept { return static_cast< I >( N ); }
@@ -199,31 +407,74 @@ public:
 	constexpr size_t FixedCapacitySize() const noexcept { return FixedCapacity() * sizeof( Element_t ); }
 
 	constexpr bool IsOverflow( I nCount ) const noexcept { return nCount > I( FixedCount() ); }
-	constexpr bool IsOverflow() const noexcept { return IsOverflow( Count() ); }
+
+	/// @brief Whether the elements live in a heap block rather than the inline buffer.
+	constexpr bool IsOverflow() const noexcept { return Base_t::Capacity() != 0; }
+
+	constexpr void Reserve( I nCount )
+	{
+		Set( Count(), EnsureCapacity( nCount ) );
+	}
+
+	constexpr void Reserve( I nCount, bool bPopulate )
+	{
+		Reserve( nCount );
+
+		if ( bPopulate && IsOverflow() && Capacity() > Count() )
+			Ball_MemPopulate( Data() + Count(), CapacitySize() - Size() );
+	}
+
+	///-----------------------------------------------------------------------------
+	/// @brief Move the elements back into the inline buffer when they fit there,
+	///        otherwise shrink the heap block to exactly Count() elements.
+	///-----------------------------------------------------------------------------
+	constexpr void ShrinkToFit()
+	{
+		if ( !IsOverflow() )
+			return;
+
+		const I nCount = Count();
+
+		if ( !IsOverflow( nCount ) )
+		{
+			MoveToFixed( Data() );
+
+			return;
+		}
+
+		if ( nCount == Base_t::Capacity() )
+			return;
+
+		T *pElements = Base_t::ReallocElements( Data(), nCount, ALIGNED_SIZE );
+
+		BALL_ASSERT_MESSAGE( pElements != nullptr, "Failed to reallocate elements (growable)" );
+
+		if ( !pElements )
+			return;
+
+		Base_t::SetCapacity( nCount );
+		Set( nCount, pElements );
+	}
 
 protected:
 	///-----------------------------------------------------------------------------
 	/// @brief Ensure underlying storage can hold at least @p nRequestCapacity elements.
 	///
-	/// This grows or shrinks the backing storage depending on two conditions:
-	///   1) Whether the requested capacity exceeds the fixed inline buffer (N).
-	///   2) Whether the vector is currently "overflowed" (i.e., backed by heap memory).
+	/// Storage is either the fixed inline buffer (N elements) or a heap block whose
+	/// element capacity is tracked by the base (Base_t::Capacity(), 0 while inline).
 	///
 	/// Growth policy:
-	///   - When @p nRequestCapacity > FixedCount() the capacity is rounded up to the
-	///     next power of two ( >= N ) via NextPowerOfTwo< I, N >(). This ensures amortized
-	///     O(1) append behavior and reduces the number of reallocations.
+	///   - No-op (a single compare) while @p nRequestCapacity <= Capacity().
+	///   - Otherwise the capacity ( >= N ) comes from Growth_t::Capacity(), by
+	///     default the next power of two. Geometric policies keep appends amortized
+	///     O(1) with O(log n) allocator calls for a run of appends.
 	///
 	/// Shrink policy:
-	///   - This function never shrinks heap capacity to a smaller heap capacity.
-	///     However, if the request fits into the fixed inline storage and the vector
-	///     is currently overflowed, it migrates back to the fixed buffer and frees
-	///     the heap block (MoveToFixed()).
+	///   - Never shrinks, and never migrates back to the inline buffer on its own:
+	///     doing so on every Remove/RemoveAll around the N boundary would bounce the
+	///     elements between buffers. ShrinkToFit() does both explicitly.
 	///
 	/// Invariants and notes:
-	///   - Capacity() here is computed from Count() (next power of two); there is no
-	///     separately tracked "capacity" member. We rely on the allocator's returned
-	///     block being >= the computed next power-of-two when growing.
 	///   - NUM_ALIGNED/ALIGNED_SIZE act as allocator hints (alignment/bucket size).
 	///     For heap allocations/reallocations we pass ALIGNED_SIZE to let the allocator
 	///     choose a bucket aligned to a power-of-two number of elements.
@@ -234,14 +485,11 @@ protected:
 	///     throw, but will assert on allocation failure in debug builds).
 	///
 	/// Complexity:
-	///   - O(1) when no migration occurs.
-	///   - O(n) element moves when switching between fixed and heap storage (via MoveToHeap /
-	///     MoveToFixed) or when the allocator has to reallocate.
+	///   - O(1) when no allocation occurs.
+	///   - O(n) element moves when switching from fixed to heap storage (via MoveToHeap)
+	///     or when the allocator has to reallocate.
 	///
 	/// @param nRequestCapacity Minimum number of elements the storage must be able to hold.
-	///                         May be >= Count() when growing; can be < Count() if the caller
-	///                         only wants to ensure it still fits in fixed storage (no removal
-	///                         of elements is performed here).
 	/// @return New base pointer to elements (may be different from previous Data()).
 	///-----------------------------------------------------------------------------
 	constexpr T *EnsureCapacity( const I nRequestCapacity )
@@ -249,82 +497,108 @@ protected:
 		// Current base pointer; may point to the fixed inline buffer or to heap.
 		T *pElements = Data();
 
-		// Case A: The request exceeds the fixed inline storage (N).
-		if ( IsOverflow( nRequestCapacity ) )
-		{
-			// Compute the next power-of-two capacity (>= nRequestCapacity and >= N).
-			const I nNewCapacity = NextPowerOfTwo< I, N >( nRequestCapacity );
+		if ( nRequestCapacity <= Capacity() )
+			return pElements;
 
-			// If the power-of-two computation overflowed, abort in debug builds.
-			BALL_ASSERT_MESSAGE( nNewCapacity != Number_t::INVALID, "Capacity overflow!" );
+		// Compute the new capacity (>= nRequestCapacity and >= N).
+		const I nNewCapacity = Growth_t::template Capacity< I >( Capacity(), nRequestCapacity, static_cast< I >( N ), sizeof( T ) );
 
-			// Defensive bail-out: if computation failed or the proposed capacity would be
-			// smaller than our current (derived) capacity, do nothing.
-			// Note: We never shrink heap capacity here; shrinking is only done by migrating
-			// back to fixed storage (see Case B below).
-			if ( nNewCapacity == Number_t::INVALID || nNewCapacity < Capacity() )
-				return pElements;
+		// If the capacity computation overflowed, abort in debug builds.
+		BALL_ASSERT_MESSAGE( nNewCapacity != Number_t::INVALID, "Capacity overflow!" );
 
-			// Subcase A1: Already on heap — grow in place if possible.
-			if ( IsOverflow() )
-			{
-				// Try to re-bucket the allocation to the new power-of-two capacity.
-				// ALIGNED_SIZE is used as an allocator hint (alignment/bucket size).
-				pElements = Allocator_t::Realloc( pElements, nNewCapacity, ALIGNED_SIZE );
+		if ( nNewCapacity == Number_t::INVALID )
+			return pElements;
 
-				// If allocation fails, pElements would be nullptr; we assert in debug.
-				// In release builds, downstream code must not dereference nullptr.
-				BALL_ASSERT_MESSAGE( pElements != nullptr, "Failed to reallocate elements (growable)" );
-			}
-			// Subcase A2: Currently using the fixed inline buffer — migrate to heap.
-			else
-			{
-				// Allocate a new heap block with the requested power-of-two capacity.
-				pElements = Allocator_t::Alloc( nNewCapacity, ALIGNED_SIZE );
-				BALL_ASSERT_MESSAGE( pElements != nullptr, "Failed to allocate elements (growable)" );
+		// Already on heap: grow in place if possible.
+		if ( IsOverflow() )
+		{
+			// Try to re-bucket the allocation to the new capacity.
+			// ALIGNED_SIZE is used as an allocator hint (alignment/bucket size).
+			T *pNewElements = Base_t::ReallocElements( pElements, nNewCapacity, ALIGNED_SIZE );
 
-				// Move/copy existing elements from the fixed buffer into the new heap block
-				// and update the base pointer inside Base_t. This is O(n).
-				MoveToHeap( pElements );
-			}
+			// If allocation fails, we assert in debug and keep the old block.
+			BALL_ASSERT_MESSAGE( pNewElements != nullptr, "Failed to reallocate elements (growable)" );
+
+			if ( !pNewElements )
+				return pElements;
+
+			pElements = pNewElements;
 		}
-		// Case B: The request fits into the fixed inline storage.
-		else if ( IsOverflow() )
+		// Currently using the fixed inline buffer: migrate to heap.
+		else
 		{
-			// We are currently on heap but the required capacity fits inline.
-			// Migrate elements back to the fixed buffer and free the heap block.
-			// This reduces memory footprint; complexity is O(n).
-			MoveToFixed( pElements );
-			// After MoveToFixed, Data() now points to the fixed buffer; keep returning
-			// the (updated) pElements for convenience/consistency with callers.
+			// Allocate a new heap block with the new capacity.
+			pElements = Base_t::Allocator().Alloc( nNewCapacity, ALIGNED_SIZE );
+			BALL_ASSERT_MESSAGE( pElements != nullptr, "Failed to allocate elements (growable)" );
+
+			if ( !pElements )
+				return Data();
+
+			// Relocate existing elements from the fixed buffer into the new heap block.
+			// One memmove for trivially relocatable elements, O(n) moves otherwise.
+			MoveToHeap( pElements );
 		}
 
+		Base_t::SetCapacity( nNewCapacity );
+
 		// Return the (possibly updated) base pointer for the caller to continue working with.
 		return pElements;
 	}
 
 	using Base_t::Set;
 
-	constexpr void MoveToFixed( const T *pElements )
+	///-----------------------------------------------------------------------------
+	/// @brief Relocate the elements of heap block @p pElements into the inline
+	///        buffer, free the block and point the view at the inline buffer.
+	/// @pre   Count() <= N.
+	///-----------------------------------------------------------------------------
+	constexpr void MoveToFixed( T *pElements )
 	{
 		BALL_ASSERT( pElements != nullptr );
-		CopyElements( FixedCount(), reinterpret_cast< T * >( &m_FixedElements ), pElements );
+		BALL_ASSERT( !IsOverflow( Count() ) );
+
+		const I nCount = Count();
+
+		RelocateElements( nCount, FixedData(), pElements );
+		Base_t::Allocator().Free( pElements );
+
+		Base_t::SetCapacity( 0 );
+		Set( nCount, FixedData() );
 	}
 
 	constexpr void MoveToHeap( T *pElements )
 	{
 		BALL_ASSERT( pElements != nullptr );
-		CopyElements( FixedCount(), pElements, reinterpret_cast< const T * >( &m_FixedElements ) );
+		RelocateElements( Count(), pElements, FixedData() );
 	}
 
 	constexpr void Swap( CVectorBase_Growable &other ) noexcept
 	{
-		Base_t::Swap( other.View() );
+		const bool bOverflow = IsOverflow();
+		const bool bOtherOverflow = other.IsOverflow();
 
-		if ( !IsOverflow() )
-		{
-			Math_Swap( m_FixedElements, other.m_FixedElements );
-		}
+		// Only the live inline elements are objects: swap the common prefix and
+		// relocate the rest into the other (raw) buffer.
+		const I nFixed = bOverflow ? I( 0 ) : Count();
+		const I nOtherFixed = bOtherOverflow ? I( 0 ) : other.Count();
+		const I nCommon = nFixed < nOtherFixed ? nFixed : nOtherFixed;
+
+		for ( I n = 0; n < nCommon; n++ )
+			Math_Swap( FixedData()[ n ], other.FixedData()[ n ] );
+
+		if ( nFixed > nCommon )
+			RelocateElements( nFixed - nCommon, other.FixedData() + nCommon, FixedData() + nCommon );
+		else if ( nOtherFixed > nCommon )
+			RelocateElements( nOtherFixed - nCommon, FixedData() + nCommon, other.FixedData() + nCommon );
+
+		Base_t::Swap( other );
+
+		// Inline storage is swapped by value; re-point views that referred to it.
+		if ( !bOverflow )
+			other.Set( other.Count(), other.FixedData() );
+
+		if ( !bOtherOverflow )
+			Set( Count(), FixedData() );
 	}
 
 	constexpr CVectorBase_Growable &CopyFrom( ConstView_t &other ) noexcept
@@ -346,8 +620,15 @@ protected:
 		return *this;
 	}
 
+	constexpr T *FixedData() noexcept { return reinterpret_cast< T * >( &m_FixedElements ); }
+
 private:
-	T m_FixedElements[ N ];
+	// Raw inline storage: only the first Count() slots hold live elements (while
+	// not overflowed), so the member must not construct/destroy all N of them.
+	union
+	{
+		T m_FixedElements[ N ];
+	};
 }; // class CVectorBase_Growable
 
 template < class B, typename I, typename T >
@@ -484,8 +765,8 @@ public:
 
 	template < I N > constexpr I AddToTail( const I nCount, const T ( &arrElements )[ N ] ) { return Insert( Count(), nCount, arrElements ); }
 	template < I N > constexpr I AddToTail( const I nCount, T ( &&arrElements )[ N ] ) { return Insert( Count(), nCount, Move( arrElements ) ); }
-	constexpr I AddToTail( const T &element ) { return Insert( Count(), element ); }
-	constexpr I AddToTail( T &&element ) { return Insert( Count(), Move( element ) ); }
+	constexpr I AddToTail( const T &element ) { return AppendElement( element ); }
+	constexpr I AddToTail( T &&element ) { return AppendElement( Move( element ) ); }
 	constexpr I AddToTail( ConstView_t v ) { return Insert( Count(), v ); }
 	template < typename ...Ts > constexpr I AddMultipleToTail( Ts &&...args ) { return InsertMultiple( Count(), Forward< Ts >( args )... ); }
 
@@ -498,18 +779,19 @@ public:
 
 		T *pData = Data();
 
-		DestructElement( &pData[ nIndex ] );
-		ShiftElements( &pData[ nIndex ], &pData[ nIndex + n ], &pData[ nCount ] );
-		Grow( -n );
+		// The removed slots become raw memory, so the tail is relocated over them.
+		DestructElements( &pData[ nIndex ], &pData[ nIndex + n ] );
+		RelocateElements( nCount - nIndex - n, &pData[ nIndex ], &pData[ nIndex + n ] );
+		Base_t::Set( nCount - n, pData );
 
 		return nIndex;
 	}
 
 	/// @brief Replace [index, index + len) with src (shifts tail if needed).
-	constexpr I ReplaceRange( const I nIndex, ConstView_t src )
+	constexpr I ReplaceRange( I nIndex, ConstView_t src )
 	{
 		I nCount = Count();
-		I nViewCount = src.Length();
+		I nViewCount = src.Count();
 
 		BALL_ASSERT( 0 <= nIndex && nIndex <= nCount );
 
@@ -520,42 +802,80 @@ public:
 
 		const I nTailStart = nIndex + nViewCount;
 		const I nTailCount = nCount - nTailStart;
-		const I nInsertCount  = src.Length();
+		const I nInsertCount  = src.Count();
 		const I nNewCount  = nCount - nViewCount + nInsertCount;
 
 		T *pElements = EnsureCapacity( nNewCount );
+		const T *pSrc = src.Data();
+
+		// The replaced slots become raw memory; the tail is relocated past the
+		// inserted segment (overlap-safe either way, into raw slots past Count()
+		// as well).
+		DestructElements( pElements + nIndex, pElements + nTailStart );
 
-		// Move tail if sizes differ.
 		if ( nTailCount > 0 && ( nInsertCount != nViewCount ) )
 		{
-			CopyElements( nTailCount, pElements + nIndex + nInsertCount, pElements + nTailStart );
+			RelocateElements( nTailCount, pElements + nIndex + nInsertCount, pElements + nTailStart );
 		}
 
-		// Copy inserted segment.
-		if ( nInsertCount > 0 )
+		// Copy-construct the inserted segment.
+		for ( I n = 0; n < nInsertCount; n++ )
 		{
-			CopyElements( nInsertCount, pElements + nIndex, src.Data() );
+			ConstructElement( &pElements[ nIndex + n ], pSrc[ n ] );
 		}
 
-		Set( nNewCount, pElements );
+		Base_t::Set( nNewCount, pElements );
 
 		return nIndex;
 	}
 
 	void RemoveAll()
 	{
-		for ( auto &it : *this )
-			DestructElement( &it );
-
+		// SetCount() destroys the elements.
 		SetCount( 0 );
 	}
 
+	///-----------------------------------------------------------------------------
+	/// @brief Give back the storage not needed for Count() elements: the heap block
+	///        is shrunk (mmap-backed blocks return their trailing pages to the OS)
+	///        or freed when empty; buffer vectors move back to the inline buffer.
+	///-----------------------------------------------------------------------------
+	void Compact()
+	{
+		Base_t::ShrinkToFit();
+	}
+
+	/// @brief Remove all elements and release the storage (RemoveAll() keeps it).
 	void Purge()
 	{
 		RemoveAll();
+		Compact();
 	}
 
 protected:
+	///-----------------------------------------------------------------------------
+	/// @brief Append one element; constructs in place without touching the
+	///        allocator while Count() < Capacity().
+	/// @return The new element count (same as Insert( Count(), ... )).
+	///-----------------------------------------------------------------------------
+	template < typename U >
+	constexpr I AppendElement( U &&element )
+	{
+		const I nCount = Count();
+
+		if ( nCount < Base_t::Capacity() )
+		{
+			T *pData = Data();
+
+			ConstructElement( &pData[ nCount ], Forward< U >( element ) );
+			Base_t::Set( nCount + 1, pData );
+
+			return nCount + 1;
+		}
+
+		return Insert( nCount, Forward< U >( element ) );
+	}
+
 	///-----------------------------------------------------------------------------
 	/// @brief Ensure space for inserting @p nAddCount elements at position @p nIndex,
 	///        grow storage if needed, shift the tail to the right, and commit size.
@@ -564,7 +884,8 @@ protected:
 	///    which rounds up to next power-of-two and Alloc/Reallocs if needed.
 	///  - If the underlying pointer changes after EnsureCapacity(), commits it via Set()
 	///    while preserving the old element count.
-	///  - Shifts the existing suffix [nIndex, nOld) right by nAddCount slots.
+	///  - Relocates the existing suffix [nIndex, nOld) right by nAddCount slots,
+	///    leaving the gap as raw memory.
 	///  - Updates the logical element count to @p nOld + @p nAddCount.
 	///  - Returns a writable pointer to the first slot where caller should place data.
 	/// @note No element construction is performed here; caller must write/construct
@@ -585,7 +906,7 @@ protected:
 		// 2) Make a hole: shift the suffix [nIndex, nOldCount) to the right.
 		if ( nIndex < nOldCount )
 		{
-			ShiftElements( &pData[ nIndex + nAddCount ], &pData[ nIndex ], &pData[ nOldCount ] );
+			RelocateElements( nOldCount - nIndex, &pData[ nIndex + nAddCount ], &pData[ nIndex ] );
 		}
 
 		// 3) Commit the new logical size; the gap [nIndex, nIndex + nAddCount)
@@ -610,22 +931,22 @@ protected:
 	}
 }; // class CVectorImpl
 
-template < typename I, typename T, I N, class A > class CBufferVector;
+template < typename I, typename T, I N, class A, class G > class CBufferVector;
 
-template < typename I, typename T, class A = CAllocator< I, T > >
-class CVector : public CVectorImpl< CVectorBase< CMemoryView< I, T >, I, T, A >, I, T >
+template < typename I, typename T, class A = CAllocator< I, T >, class G = CGrowPowerOfTwo >
+class CVector : public CVectorImpl< CVectorBase< CMemoryView< I, T >, I, T, A, G >, I, T >
 {
 public:
-	using Base_t = CVectorImpl< CVectorBase< CMemoryView< I, T >, I, T, A >, I, T >;
+	using Base_t = CVectorImpl< CVectorBase< CMemoryView< I, T >, I, T, A, G >, I, T >;
 	using Base_t::Base_t;
 
 	template < I N >
-	CVector( const CBufferVector< I, T, N, A > &other ) :
+	CVector( const CBufferVector< I, T, N, A, G > &other ) :
 		Base_t( other.View() )
 	{
 	}
 
-	template < I N > CVector &operator=( const CBufferVector< I, T, N, A > &other )
+	template < I N > CVector &operator=( const CBufferVector< I, T, N, A, G > &other )
 	{
 		Base_t::operator=( other.View() );
 
@@ -633,19 +954,19 @@ public:
 	}
 };
 
-template < typename I, typename T, I N, class A = CAllocator< I, T > >
-class CBufferVector : public CVectorImpl< CVectorBase_Growable< CMemoryView< I, T >, I, T, N, A >, I, T >
+template < typename I, typename T, I N, class A = CAllocator< I, T >, class G = CGrowPowerOfTwo >
+class CBufferVector : public CVectorImpl< CVectorBase_Growable< CMemoryView< I, T >, I, T, N, A, G >, I, T >
 {
 public:
-	using Base_t = CVectorImpl< CVectorBase_Growable< CMemoryView< I, T >, I, T, N, A >, I, T >;
+	using Base_t = CVectorImpl< CVectorBase_Growable< CMemoryView< I, T >, I, T, N, A, G >, I, T >;
 	using Base_t::Base_t;
 
-	CBufferVector( const CVector< I, T, A > &other ) :
+	CBufferVector( const CVector< I, T, A, G > &other ) :
 		Base_t( other.View() )
 	{
 	}
 
-	CBufferVector &operator=( const CVector< I, T, A > &other )
+	CBufferVector &operator=( const CVector< I, T, A, G > &other )
 	{
 		Base_t::operator=( other.View() );
 
@@ -659,6 +980,13 @@ template < typename T > using Vector16_t =          CVector< uint16_t, T >;
 template < typename T > using Vector32_t =          CVector< uint32_t, T >;
 template < typename T > using Vector64_t =          CVector< uint64_t, T >;
 
+template < typename T > using HugePageVector_t =    CVector< size_t, T, CAllocator< size_t, T, BALL_ALLOC_HUGEPAGE > >;
+template < typename T > using PopulatedVector_t =   CVector< size_t, T, CAllocator< size_t, T, BALL_ALLOC_POPULATE > >;
+template < typename T > using PaddedVector_t =      CVector< size_t, T, CAllocator< size_t, T, BALL_ALLOC_PADDED > >;
+template < typename T > using ResourceVector_t =    CVector< size_t, T, CResourceAllocator< size_t, T > >;
+template < typename T > using CompactVector_t =     CVector< size_t, T, CAllocator< size_t, T >, CGrowOneAndHalf >;
+template < typename T > using PagedVector_t =       CVector< size_t, T, CAllocator< size_t, T >, CGrowPages<> >;
+
 template < typename T, size_t N > using BufferVector_t =            CBufferVector< size_t, T, N >;
 template < typename T, uint8_t N > using BufferVector8_t =          CBufferVector< uint8_t, T, N >;
 template < typename T, uint16_t N > using BufferVector16_t =        CBufferVector< uint16_t, T, N >;
@@ -0,0 +1,113 @@
+///-----------------------------------------------------------------------------
+/// Replacement of the global operator new/delete family with the Ball heap.
+///
+/// Linked in through the optional ball-new target, so objects allocated with
+/// new share the allocator (and the statistics) of the Ball containers:
+///   * Requests up to BALL_SLAB_MAX_SIZE/BALL_SLAB_MAX_ALIGN come from the
+///     per-thread slab bins (Ball_SlabCacheAlloc), larger ones are mapped
+///     (Ball_AllocAlign); delete tells them apart with Ball_SlabOwns.
+///   * Sized deletes ignore the size: a small request whose slab allocation
+///     failed lives in a mapping.
+///
+/// This is the one translation unit that includes <new>: the replaced
+/// signatures are spelled with std::align_val_t/std::nothrow_t, and failure
+/// has to follow the standard (new_handler loop, std::bad_alloc).
+///-----------------------------------------------------------------------------
+
+#include <new>
+
+#include <ball/types/base/arch.h>
+#include <ball/types/base/fixed.h>
+#include <ball/types/memoryaligned.h>
+#include <ball/types/memoryslab.h>
+
+static inline void *Ball_NewTry( size_t nSize, size_t nAlign ) noexcept
+{
+	if ( !nSize )
+		nSize = 1;
+
+	if ( nAlign < sizeof( ptr_t ) )
+		nAlign = sizeof( ptr_t );
+
+	if ( BALL_SLAB_IS_SMALL( nSize, nAlign ) )
+	{
+		ptr_t pMem = Ball_SlabCacheAlloc( nSize, nAlign );
+
+		if ( pMem )
+			return pMem;
+	}
+
+	return Ball_AllocAlign( nSize, nAlign );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Allocate, calling the installed new_handler until it succeeds.
+/// @note  Throws std::bad_alloc once no handler is left; the nothrow forms
+///        turn that (or a throwing handler) into nullptr.
+///-----------------------------------------------------------------------------
+static void *Ball_New( size_t nSize, size_t nAlign )
+{
+	for ( ;; )
+	{
+		void *pMem = Ball_NewTry( nSize, nAlign );
+
+		if ( pMem )
+			return pMem;
+
+		std::new_handler pfnHandler = std::get_new_handler();
+
+		if ( !pfnHandler )
+			throw std::bad_alloc();
+
+		pfnHandler();
+	}
+}
+
+static void *Ball_NewNoThrow( size_t nSize, size_t nAlign ) noexcept
+{
+	try
+	{
+		return Ball_New( nSize, nAlign );
+	}
+	catch ( ... )
+	{
+		return nullptr;
+	}
+}
+
+static inline void Ball_Delete( void *pMem ) noexcept
+{
+	if ( !pMem )
+		return;
+
+	if ( Ball_SlabOwns( pMem ) )
+		Ball_SlabFree( pMem );
+	else
+		Ball_FreeAlign( pMem );
+}
+
+static constexpr size_t BALL_NEW_ALIGN = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+void *operator new( size_t nSize ) { return Ball_New( nSize, BALL_NEW_ALIGN ); }
+void *operator new[]( size_t nSize ) { return Ball_New( nSize, BALL_NEW_ALIGN ); }
+void *operator new( size_t nSize, const std::nothrow_t & ) noexcept { return Ball_NewNoThrow( nSize, BALL_NEW_ALIGN ); }
+void *operator new[]( size_t nSize, const std::nothrow_t & ) noexcept { return Ball_NewNoThrow( nSize, BALL_NEW_ALIGN ); }
+
+void *operator new( size_t nSize, std::align_val_t nAlign ) { return Ball_New( nSize, static_cast< size_t >( nAlign ) ); }
+void *operator new[]( size_t nSize, std::align_val_t nAlign ) { return Ball_New( nSize, static_cast< size_t >( nAlign ) ); }
+void *operator new( size_t nSize, std::align_val_t nAlign, const std::nothrow_t & ) noexcept { return Ball_NewNoThrow( nSize, static_cast< size_t >( nAlign ) ); }
+void *operator new[]( size_t nSize, std::align_val_t nAlign, const std::nothrow_t & ) noexcept { return Ball_NewNoThrow( nSize, static_cast< size_t >( nAlign ) ); }
+
+void operator delete( void *pMem ) noexcept { Ball_Delete( pMem ); }
+void operator delete[]( void *pMem ) noexcept { Ball_Delete( pMem ); }
+void operator delete( void *pMem, const std::nothrow_t & ) noexcept { Ball_Delete( pMem ); }
+void operator delete[]( void *pMem, const std::nothrow_t & ) noexcept { Ball_Delete( pMem ); }
+void operator delete( void *pMem, size_t ) noexcept { Ball_Delete( pMem ); }
+void operator delete[]( void *pMem, size_t ) noexcept { Ball_Delete( pMem ); }
+
+void operator delete( void *pMem, std::align_val_t ) noexcept { Ball_Delete( pMem ); }
+void operator delete[]( void *pMem, std::align_val_t ) noexcept { Ball_Delete( pMem ); }
+void operator delete( void *pMem, std::align_val_t, const std::nothrow_t & ) noexcept { Ball_Delete( pMem ); }
+void operator delete[]( void *pMem, std::align_val_t, const std::nothrow_t & ) noexcept { Ball_Delete( pMem ); }
+void operator delete( void *pMem, size_t, std::align_val_t ) noexcept { Ball_Delete( pMem ); }
+void operator delete[]( void *pMem, size_t, std::align_val_t ) noexcept { Ball_Delete( pMem ); }
@@ -0,0 +1,66 @@
+#ifdef BALL_ENABLE_MODULES
+import Ball.New;
+import Ball.Types;
+#else // !defined( BALL_ENABLE_MODULES )
+#	include <ball/new.hpp>
+#	include <ball/types.hpp>
+#endif // defined( BALL_ENABLE_MODULES )
+
+using namespace Ball::Types;
+
+// Extern C section.
+extern "C"
+{
+	int puts( const char *pszTextNoNextLine );
+};
+
+struct alignas( 256 ) CAligned
+{
+	uchar_t m_aData[ 256 ];
+};
+
+// Returns the number of failed checks.
+int TestGlobalNew()
+{
+	int nFailed = 0;
+
+	// Small objects come from the slab bins.
+	int *pValue = new int( 42 );
+
+	nFailed += !Ball_SlabOwns( pValue ) || *pValue != 42;
+	delete pValue;
+
+	// Over-aligned ones too, at their alignment.
+	CAligned *pAligned = new CAligned;
+
+	nFailed += !Ball_SlabOwns( pAligned );
+	nFailed += reinterpret_cast< uintptr_t >( pAligned ) % alignof( CAligned ) != 0;
+	delete pAligned;
+
+	// Large arrays are mapped and show up in the statistics.
+	const Ball_MemStats_t before = CAllocatorBase::Stats();
+
+	uchar_t *pBuffer = new uchar_t[ 1 << 20 ];
+
+	nFailed += Ball_SlabOwns( pBuffer ) || Ball_MemSize( pBuffer, 16, 0 ) != ( 1 << 20 );
+	delete[] pBuffer;
+
+	const Ball_MemStats_t after = CAllocatorBase::Stats();
+
+	nFailed += after.nAllocCalls - before.nAllocCalls != 1;
+	nFailed += after.nFreeCalls - before.nFreeCalls != 1;
+
+	return nFailed;
+}
+
+int main()
+{
+	if ( TestGlobalNew() )
+	{
+		puts( "Global operator new checks failed" );
+
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,421 @@
+#ifdef BALL_ENABLE_MODULES
+import Ball.New;
+import Ball.Types;
+#else // !defined( BALL_ENABLE_MODULES )
+#	include <ball/new.hpp>
+#	include <ball/types.hpp>
+#endif // defined( BALL_ENABLE_MODULES )
+
+using namespace Ball::Types;
+
+struct Ball_TimeSpec_t
+{
+	long nSeconds;
+	long nNanoseconds;
+};
+
+// Extern C section.
+extern "C"
+{
+	int puts( const char *pszTextNoNextLine );
+	int clock_gettime( int nClock, Ball_TimeSpec_t *pTime );
+};
+
+static constexpr int    CLOCK_MONOTONIC = 1;
+static constexpr size_t ROUNDS = 5;
+static constexpr size_t BYTES = 64u << 20;
+static constexpr size_t PAGE = 4096;
+
+static llong_t NowNs()
+{
+	Ball_TimeSpec_t now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+
+	return static_cast< llong_t >( now.nSeconds ) * 1'000'000'000ll + now.nNanoseconds;
+}
+
+struct Sample_t
+{
+	llong_t nSetupNs;
+	llong_t nFillNs;
+};
+
+///-----------------------------------------------------------------------------
+/// @brief Reserve BYTES of uint64_t (prefaulted or not), then time the first
+///        write pass over them; keeps the best of ROUNDS.
+///-----------------------------------------------------------------------------
+template < class V >
+static Sample_t FirstTouch( bool bPopulate )
+{
+	Sample_t best { -1, -1 };
+
+	for ( size_t r = 0; r < ROUNDS; r++ )
+	{
+		// Fresh mappings every round: nothing may be resident yet.
+		CAllocatorBase::Trim();
+
+		V vec;
+
+		const size_t nCount = BYTES / sizeof( uint64_t );
+		const llong_t nSetupStart = NowNs();
+
+		vec.Reserve( nCount, bPopulate );
+
+		const llong_t nFillStart = NowNs();
+
+		for ( size_t n = 0; n < nCount; n++ )
+			vec.AddToTail( n );
+
+		const llong_t nEnd = NowNs();
+
+		if ( best.nFillNs < 0 || nEnd - nFillStart < best.nFillNs )
+			best = { nFillStart - nSetupStart, nEnd - nFillStart };
+	}
+
+	return best;
+}
+
+static void Report( const char *pszName, const Sample_t &sample )
+{
+	BufferString_t< 256 > sLine;
+
+	sLine.AppendMultiple( pszName, ": setup ", sample.nSetupNs / 1000, " us, first pass ", sample.nFillNs / 1000,
+	                      " us (", sample.nFillNs / static_cast< llong_t >( BYTES / PAGE ), " ns/page)" );
+	sLine.AddToTail( '\0' );
+
+	puts( sLine.String() );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Time moving @p nBytes of uint64_t up by one element and back, as an
+///        Insert/Remove at the head does; returns the best of ROUNDS per move.
+///-----------------------------------------------------------------------------
+template < class F >
+static llong_t ShiftTail( size_t nBytes, F &&fnShift )
+{
+	static constexpr size_t REPEAT = 16;
+
+	const size_t nCount = nBytes / sizeof( uint64_t );
+
+	Vector_t< uint64_t > vec;
+
+	for ( size_t n = 0; n <= nCount; n++ )
+		vec.AddToTail( n );
+
+	llong_t nBest = -1;
+
+	for ( size_t r = 0; r < ROUNDS; r++ )
+	{
+		const llong_t nStart = NowNs();
+
+		for ( size_t i = 0; i < REPEAT; i++ )
+		{
+			fnShift( vec.Data() + 1, vec.Data(), nCount );
+			fnShift( vec.Data(), vec.Data() + 1, nCount );
+		}
+
+		const llong_t nTime = ( NowNs() - nStart ) / static_cast< llong_t >( 2 * REPEAT );
+
+		if ( nBest < 0 || nTime < nBest )
+			nBest = nTime;
+	}
+
+	return nBest;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Time CVector::Insert at the head and Remove of it over @p nBytes of
+///        uint64_t (each relocates the whole tail); returns the best of ROUNDS
+///        per call.
+///-----------------------------------------------------------------------------
+static llong_t InsertRemoveHead( size_t nBytes )
+{
+	static constexpr size_t REPEAT = 16;
+
+	Vector_t< uint64_t > vec;
+
+	for ( size_t n = 0; n < nBytes / sizeof( uint64_t ); n++ )
+		vec.AddToTail( n );
+
+	llong_t nBest = -1;
+
+	for ( size_t r = 0; r < ROUNDS; r++ )
+	{
+		const llong_t nStart = NowNs();
+
+		for ( size_t i = 0; i < REPEAT; i++ )
+		{
+			vec.AddToHead( i );
+			vec.Remove( 0 );
+		}
+
+		const llong_t nTime = ( NowNs() - nStart ) / static_cast< llong_t >( 2 * REPEAT );
+
+		if ( nBest < 0 || nTime < nBest )
+			nBest = nTime;
+	}
+
+	return nBest;
+}
+
+static void ReportBandwidth( const char *pszName, size_t nBytes, llong_t nNs )
+{
+	BufferString_t< 256 > sLine;
+
+	sLine.AppendMultiple( pszName, " ", nBytes >> 10, " KiB: ", nNs, " ns (", static_cast< llong_t >( nBytes ) * 1000 / ( nNs > 0 ? nNs : 1 ), " MB/s)" );
+	sLine.AddToTail( '\0' );
+
+	puts( sLine.String() );
+}
+
+static void BenchmarkShift()
+{
+	static constexpr size_t SIZES[] = { 4u << 10, 64u << 10, 1u << 20, 16u << 20 };
+	static constexpr const char *KERNELS[] = { "libc memmove    ", "SSE2 kernel     ", "AVX2 kernel     ", "AVX-512 kernel  " };
+
+	const uint32_t nDefault = Ball_MemCopyKernel();
+
+	for ( const size_t nBytes : SIZES )
+	{
+		// The per-element loops CopyElements/CopyElementsFromEnd used to run.
+		ReportBandwidth( "element loop    ", nBytes, ShiftTail( nBytes, []( uint64_t *pDest, const uint64_t *pSrc, size_t nCount )
+		{
+			if ( pDest < pSrc )
+			{
+				for ( size_t n = 0; n < nCount; ++n )
+					pDest[ n ] = pSrc[ n ];
+			}
+			else
+			{
+				for ( size_t n = nCount; n-- > 0; )
+					pDest[ n ] = pSrc[ n ];
+			}
+		} ) );
+
+		for ( uint32_t nKernel = BALL_MEMCOPY_SYSTEM; nKernel <= nDefault; nKernel++ )
+		{
+			Ball_MemCopySetKernel( nKernel );
+			ReportBandwidth( KERNELS[ nKernel ], nBytes, ShiftTail( nBytes, []( uint64_t *pDest, const uint64_t *pSrc, size_t nCount )
+			{
+				ShiftElements( pDest, pSrc, pSrc + nCount );
+			} ) );
+			ReportBandwidth( "  Insert/Remove ", nBytes, InsertRemoveHead( nBytes ) );
+		}
+
+		Ball_MemCopySetKernel( nDefault );
+	}
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Time Ball_MemCopy of @p nBytes between two buffers under the given
+///        Ball_MemCopyTune settings; returns the best of ROUNDS, in ns.
+///-----------------------------------------------------------------------------
+static llong_t LargeCopy( size_t nBytes, size_t nLargeSize, uint32_t nThreads )
+{
+	uchar_t *pSrc = static_cast< uchar_t * >( CAllocatorBase::Alloc( nBytes, 64 ) );
+	uchar_t *pDest = static_cast< uchar_t * >( CAllocatorBase::Alloc( nBytes, 64 ) );
+
+	// Fault both buffers in first: only the copy is timed.
+	for ( size_t n = 0; n < nBytes; n += PAGE )
+		pSrc[ n ] = pDest[ n ] = static_cast< uchar_t >( n );
+
+	Ball_MemCopyTune( nLargeSize, nThreads );
+
+	llong_t nBest = -1;
+
+	for ( size_t r = 0; r < ROUNDS; r++ )
+	{
+		const llong_t nStart = NowNs();
+
+		Ball_MemCopy( pDest, pSrc, nBytes );
+
+		const llong_t nTime = NowNs() - nStart;
+
+		if ( nBest < 0 || nTime < nBest )
+			nBest = nTime;
+	}
+
+	CAllocatorBase::Free( pSrc );
+	CAllocatorBase::Free( pDest );
+
+	return nBest;
+}
+
+static void BenchmarkLargeCopy()
+{
+	static constexpr size_t SIZES[] = { 4u << 20, 16u << 20, 64u << 20, 256u << 20 };
+	static constexpr size_t CACHED = ~static_cast< size_t >( 0 );
+
+	size_t nLargeSize;
+	uint32_t nThreads;
+
+	Ball_MemCopyTuning( &nLargeSize, &nThreads );
+
+	for ( const size_t nBytes : SIZES )
+	{
+		ReportBandwidth( "cached copy     ", nBytes, LargeCopy( nBytes, CACHED, 1 ) );
+		ReportBandwidth( "streamed, 1 thr ", nBytes, LargeCopy( nBytes, 0, 1 ) );
+		ReportBandwidth( "streamed, 2 thr ", nBytes, LargeCopy( nBytes, 0, 2 ) );
+		ReportBandwidth( "streamed, 4 thr ", nBytes, LargeCopy( nBytes, 0, 4 ) );
+	}
+
+	Ball_MemCopyTune( nLargeSize, nThreads );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Time comparing two equal strings of @p nBytes (the worst case: the
+///        whole length is scanned); returns the best of ROUNDS, in ns.
+///-----------------------------------------------------------------------------
+template < class F >
+static llong_t CompareEqual( size_t nBytes, F &&fnCompare )
+{
+	static constexpr size_t REPEAT = 16;
+
+	String_t sLeft, sRight;
+
+	for ( size_t n = 0; n < nBytes; n++ )
+	{
+		sLeft.AddToTail( static_cast< char_t >( 'a' + n % 26 ) );
+		sRight.AddToTail( static_cast< char_t >( 'a' + n % 26 ) );
+	}
+
+	llong_t nBest = -1;
+	size_t nEqual = 0;
+
+	for ( size_t r = 0; r < ROUNDS; r++ )
+	{
+		const llong_t nStart = NowNs();
+
+		for ( size_t i = 0; i < REPEAT; i++ )
+			nEqual += fnCompare( StringView_t( sLeft.Length(), sLeft.String() ), StringView_t( sRight.Length(), sRight.String() ) );
+
+		const llong_t nTime = ( NowNs() - nStart ) / static_cast< llong_t >( REPEAT );
+
+		if ( nBest < 0 || nTime < nBest )
+			nBest = nTime;
+	}
+
+	return nEqual == ROUNDS * REPEAT ? nBest : -1;
+}
+
+static void BenchmarkCompare()
+{
+	static constexpr size_t SIZES[] = { 4u << 10, 64u << 10, 1u << 20 };
+	static constexpr const char *KERNELS[] = { "word kernel     ", "SSE2 kernel     ", "AVX2 kernel     ", "AVX-512 kernel  " };
+
+	const uint32_t nDefault = Ball_MemCopyKernel();
+
+	for ( const size_t nBytes : SIZES )
+	{
+		// The per-character loop CStringView::Equals used to run.
+		ReportBandwidth( "element loop    ", nBytes, CompareEqual( nBytes, []( StringView_t sLeft, StringView_t sRight )
+		{
+			const char_t *pLeft = sLeft.String(), *pRight = sRight.String();
+			size_t n = 0;
+
+			while ( n < sLeft.Length() && pLeft[ n ] == pRight[ n ] )
+				n++;
+
+			return n == sLeft.Length() && n == sRight.Length();
+		} ) );
+
+		for ( uint32_t nKernel = BALL_MEMCOPY_SYSTEM; nKernel <= nDefault; nKernel++ )
+		{
+			Ball_MemCopySetKernel( nKernel );
+			ReportBandwidth( KERNELS[ nKernel ], nBytes, CompareEqual( nBytes, []( StringView_t sLeft, StringView_t sRight )
+			{
+				return sLeft.Equals( sRight );
+			} ) );
+		}
+
+		Ball_MemCopySetKernel( nDefault );
+	}
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Time a scan of @p nBytes of text ('a'..'z' repeated, '!' last) that
+///        must return @p nExpected; returns the best of ROUNDS, in ns.
+///-----------------------------------------------------------------------------
+template < class F >
+static llong_t SearchText( size_t nBytes, size_t nExpected, F &&fnSearch )
+{
+	String_t sText;
+
+	for ( size_t n = 0; n + 1 < nBytes; n++ )
+		sText.AddToTail( static_cast< char_t >( 'a' + n % 26 ) );
+
+	sText.AddToTail( '!' );
+
+	const StringView_t sView( sText.Length(), sText.String() );
+
+	llong_t nBest = -1;
+	bool_t bCorrect = true;
+
+	for ( size_t r = 0; r < ROUNDS; r++ )
+	{
+		const llong_t nStart = NowNs();
+
+		bCorrect &= fnSearch( sView ) == nExpected;
+
+		const llong_t nTime = NowNs() - nStart;
+
+		if ( nBest < 0 || nTime < nBest )
+			nBest = nTime;
+	}
+
+	return bCorrect ? nBest : -1;
+}
+
+static void BenchmarkFind()
+{
+	static constexpr size_t SIZES[] = { 64u << 10, 1u << 20, 16u << 20 };
+	static constexpr const char *KERNELS[] = { "element kernel  ", "SSE2 kernel     ", "AVX2 kernel     ", "AVX-512 kernel  " };
+
+	const uint32_t nDefault = Ball_MemCopyKernel();
+
+	for ( const size_t nBytes : SIZES )
+	{
+		// The per-element loop CMemoryViewBase::Find used to run.
+		ReportBandwidth( "element loop    ", nBytes, SearchText( nBytes, nBytes - 1, []( StringView_t sText )
+		{
+			const char_t *pText = sText.String();
+			size_t n = 0;
+
+			while ( n < sText.Length() && pText[ n ] != '!' )
+				n++;
+
+			return n;
+		} ) );
+
+		for ( uint32_t nKernel = BALL_MEMCOPY_SYSTEM; nKernel <= nDefault; nKernel++ )
+		{
+			Ball_MemCopySetKernel( nKernel );
+			ReportBandwidth( KERNELS[ nKernel ], nBytes, SearchText( nBytes, nBytes - 1, []( StringView_t sText )
+			{
+				return sText.Find( '!' );
+			} ) );
+		}
+
+		Ball_MemCopySetKernel( nDefault );
+
+		ReportBandwidth( "count, default  ", nBytes, SearchText( nBytes, ( nBytes + 24 ) / 26, []( StringView_t sText )
+		{
+			return sText.CountOf( 'a' );
+		} ) );
+	}
+}
+
+int main()
+{
+	Report( "lazy            ", FirstTouch< Vector_t< uint64_t > >( false ) );
+	Report( "Reserve populate", FirstTouch< Vector_t< uint64_t > >( true ) );
+	Report( "POPULATE policy ", FirstTouch< PopulatedVector_t< uint64_t > >( false ) );
+
+	BenchmarkShift();
+	BenchmarkLargeCopy();
+	BenchmarkCompare();
+	BenchmarkFind();
+
+	return 0;
+}
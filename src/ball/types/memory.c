@@ -1,52 +1,967 @@
 #include <ball/types/base/arch.h>
 #include <ball/types/base/fixed.h>
 #include <ball/types/c/assert.h>
+#include <ball/types/c/atomic.h>
 #include <ball/types/c/mmap.h>
 #include <ball/types/c/memory.h>
 #include <ball/types/c/math.h>
+#include <ball/types/c/thread.h>
+#include <ball/types/c/time.h>
+#include <ball/types/memoryaligned.h>
+#include <ball/types/memorycopy.h>
+#include <ball/types/memorybudget.h>
+#include <ball/types/memoryslab.h>
+#include <ball/types/memorystats.h>
 
 #define BALL_MAGIC 0x42414C4C // "BALL" (without null-terminated)
 
+#define BALL_ALLOC_HUGETLB_ 0x80000000u // Internal: mapping comes from the hugetlb pool.
+#define BALL_ALLOC_BATCH_   0x40000000u // Internal: block carved out of a Ball_AllocBatch mapping.
+
+#define BALL_MEMCACHE_BUCKETS     32                      // log2( pages ) buckets.
+#define BALL_MEMCACHE_MAX_BYTES   ( ( size_t )64u << 20 ) // Bytes retained at most.
+#define BALL_MEMCACHE_MAX_ENTRY   ( BALL_MEMCACHE_MAX_BYTES / 4 )
+#define BALL_MEMCACHE_MAX_AGE_NS  1000000000ll            // Retained mappings older than this are released.
+
+#define BALL_MEMSHRINK_MIN_BYTES  ( ( size_t )1u << 20 )      // Trailing slack below this is kept for regrowth.
+#define BALL_MEMSHRINK_MIN_RATIO  4                           // ... and below 1/N of the kept length.
+
+///-----------------------------------------------------------------------------
+/// @brief Header placed immediately before the user pointer inside the same VMA.
+/// @note  Lives in the same mapping as the user memory (no separate allocation).
+///-----------------------------------------------------------------------------
+struct Ball_AlignedHeader_t
+{
+	ptr_t    pRaw;          ///< Mapping base address (after head trim).
+	size_t   nSize;         ///< Logical size requested by the user.
+	size_t   nMapLength;    ///< Full mapping length to pass to munmap/mremap.
+	uint32_t nMagic;        ///< Signature to validate that the pointer is ours.
+	uint32_t nFlags;        ///< BALL_ALLOC_* flags the block was allocated with.
+	struct Ball_MemBudget_t *pBudget; ///< Budget charged with nMapLength (or BALL_NULL).
+	size_t   nReserveLength; ///< Ball_ReserveAlign: whole reserved range, of which nMapLength is committed (0 otherwise).
+}; // struct Ball_AlignedHeader_t
+
+///-----------------------------------------------------------------------------
+/// @brief Start of a Ball_AllocBatch mapping; its blocks point here with pRaw.
+/// @note  Batch blocks keep the regular header, with nMapLength measured from
+///        this header to the end of the block's slot, so in-place reallocs stay
+///        inside the slot. The mapping is released with its last block.
+///-----------------------------------------------------------------------------
+struct Ball_BatchHeader_t
+{
+	size_t   nMapLength;    ///< Whole mapping length.
+	uint64_t nLive;         ///< Blocks not freed yet (atomic).
+	struct Ball_MemBudget_t *pBudget; ///< Budget charged with nMapLength (or BALL_NULL).
+}; // struct Ball_BatchHeader_t
+
+///-----------------------------------------------------------------------------
+/// @brief  Block size for a request of @p nSize bytes: BALL_ALLOC_PADDED blocks
+///         carry BALL_ALLOC_PADDING more, which counts toward their nSize.
+/// @return 0 when the padded size does not fit a size_t.
+///-----------------------------------------------------------------------------
+static inline size_t Ball_PadSize( size_t nSize, uint32_t nFlags )
+{
+	if ( !( nFlags & BALL_ALLOC_PADDED ) )
+		return nSize;
+
+	return nSize <= ~( size_t )0u - BALL_ALLOC_PADDING ? nSize + BALL_ALLOC_PADDING : 0u;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Returns system page size (falls back to 4096 on failure).
+/// @note  Cached page size is not necessary here; sysconf is cheap enough,
+///        and this helper is rarely on a hot path.
+///-----------------------------------------------------------------------------
+size_t Ball_PageSize( void )
+{
+	long_t nPageSize = sysconf( BALL_SC_PAGESIZE );
+
+	return ( nPageSize > 0 ) ? ( size_t )nPageSize : 4096u;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Convert a user pointer back to our header (with validation).
+/// @return Pointer to header or BALL_NULL if invalid.
+/// @note   Precondition: @p user must be a pointer returned by Ball_AllocAlign.
+///-----------------------------------------------------------------------------
+static inline struct Ball_AlignedHeader_t *Ball_HeaderFromUser( ptr_t pUser )
+{
+	if ( !pUser )
+		return BALL_NULL;
+
+	struct Ball_AlignedHeader_t *h = ( ( struct Ball_AlignedHeader_t * )pUser ) - 1;
+
+	if ( h->nMagic != BALL_MAGIC )
+		return BALL_NULL;
+
+	return h;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Per-thread counters, linked into a process-wide list on first use.
+/// @note  Only the owner thread writes its counters (relaxed load + store, no
+///        RMW); readers sum all live records plus those of exited threads.
+///-----------------------------------------------------------------------------
+struct Ball_MemThreadStats_t
+{
+	struct Ball_MemStats_t        Stats;    ///< nMappedBytes/nPeakMappedBytes unused here.
+	struct Ball_MemThreadStats_t *pNext;
+	struct Ball_MemThreadStats_t *pPrev;
+	bool_t                        bListed;
+	bool_t                        bUnlisted; ///< Never listed again: counts go to Retired.
+}; // struct Ball_MemThreadStats_t
+
+#define BALL_MEMSTATS_COUNTERS ( sizeof( struct Ball_MemStats_t ) / sizeof( uint64_t ) )
+
+static struct
+{
+	Ball_SpinLock_t               nLock;        ///< Guards the list, the key and Retired.
+	bool_t                        bKeyTried;
+	bool_t                        bKeyReady;
+	Ball_ThreadKey_t              nKey;         ///< Thread-exit hook folding a record into Retired.
+	struct Ball_MemThreadStats_t *pThreads;     ///< Records of live threads.
+	struct Ball_MemStats_t        Retired;      ///< Sum over exited threads.
+	uint64_t                      nMappedBytes;
+	uint64_t                      nPeakMappedBytes;
+} s_MemStats;
+
+static _Thread_local struct Ball_MemThreadStats_t s_MemThreadStats;
+
+static void Ball_MemStatsDetach( void *pArgument )
+{
+	struct Ball_MemThreadStats_t *pThread = ( struct Ball_MemThreadStats_t * )pArgument;
+	const uint64_t *pCounters = ( const uint64_t * )&pThread->Stats;
+	uint64_t *pRetired = ( uint64_t * )&s_MemStats.Retired;
+
+	Ball_SpinLock( &s_MemStats.nLock );
+
+	for ( size_t n = 0; n < BALL_MEMSTATS_COUNTERS; n++ )
+		pRetired[ n ] += pCounters[ n ];
+
+	if ( pThread->pPrev )
+		pThread->pPrev->pNext = pThread->pNext;
+	else
+		s_MemStats.pThreads = pThread->pNext;
+
+	if ( pThread->pNext )
+		pThread->pNext->pPrev = pThread->pPrev;
+
+	Ball_SpinUnlock( &s_MemStats.nLock );
+
+	// Later updates from this thread's destructors must not relink the record:
+	// nothing would unlink it once the thread's storage is gone.
+	__builtin_memset( pThread, 0, sizeof( *pThread ) );
+	pThread->bUnlisted = 1;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  List the calling thread's record @p pThread on its first update.
+/// @return BALL_NULL when the record cannot be listed: without a thread-exit key
+///         it would stay linked after the thread exits, and after
+///         Ball_MemStatsDetach nothing would unlink it again.
+///-----------------------------------------------------------------------------
+static struct Ball_MemStats_t *Ball_MemThreadStatsList( struct Ball_MemThreadStats_t *pThread )
+{
+	if ( pThread->bUnlisted )
+		return BALL_NULL;
+
+	Ball_SpinLock( &s_MemStats.nLock );
+
+	if ( !s_MemStats.bKeyTried )
+	{
+		s_MemStats.bKeyTried = 1;
+		s_MemStats.bKeyReady = pthread_key_create( &s_MemStats.nKey, Ball_MemStatsDetach ) == 0;
+	}
+
+	if ( !s_MemStats.bKeyReady )
+	{
+		Ball_SpinUnlock( &s_MemStats.nLock );
+		pThread->bUnlisted = 1;
+
+		return BALL_NULL;
+	}
+
+	pThread->pPrev = BALL_NULL;
+	pThread->pNext = s_MemStats.pThreads;
+
+	if ( pThread->pNext )
+		pThread->pNext->pPrev = pThread;
+
+	s_MemStats.pThreads = pThread;
+	pThread->bListed = 1;
+
+	Ball_SpinUnlock( &s_MemStats.nLock );
+
+	( void )pthread_setspecific( s_MemStats.nKey, pThread );
+
+	return &pThread->Stats;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Calling thread's counters (registered lazily, see
+///         Ball_MemThreadStatsList); a TLS load on the hot path.
+///-----------------------------------------------------------------------------
+static inline struct Ball_MemStats_t *Ball_MemThreadStats( void )
+{
+	struct Ball_MemThreadStats_t *pThread = &s_MemThreadStats;
+
+	return pThread->bListed ? &pThread->Stats : Ball_MemThreadStatsList( pThread );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Add @p nValue to the counter at byte @p nOffset of the calling
+///        thread's record, or straight to Retired (under the lock) when the
+///        thread has none.
+///-----------------------------------------------------------------------------
+static inline void Ball_MemStatAdd( size_t nOffset, uint64_t nValue )
+{
+	struct Ball_MemStats_t *pStats = Ball_MemThreadStats();
+
+	if ( pStats )
+	{
+		uint64_t *pCounter = ( uint64_t * )( ( uchar_t * )pStats + nOffset );
+
+		BALL_ATOMIC_STORE( pCounter, BALL_ATOMIC_LOAD( pCounter, BALL_ATOMIC_RELAXED ) + nValue, BALL_ATOMIC_RELAXED );
+	}
+	else
+	{
+		Ball_SpinLock( &s_MemStats.nLock );
+		*( uint64_t * )( ( uchar_t * )&s_MemStats.Retired + nOffset ) += nValue;
+		Ball_SpinUnlock( &s_MemStats.nLock );
+	}
+}
+
+#define BALL_MEMSTAT_ADD( field, value ) Ball_MemStatAdd( __builtin_offsetof( struct Ball_MemStats_t, field ), ( uint64_t )( value ) )
+
+static inline void Ball_MemStatMapped( size_t nAdd, size_t nSub )
+{
+	const uint64_t nMapped = BALL_ATOMIC_ADD( &s_MemStats.nMappedBytes, ( uint64_t )nAdd - ( uint64_t )nSub, BALL_ATOMIC_RELAXED );
+	uint64_t nPeak = BALL_ATOMIC_LOAD( &s_MemStats.nPeakMappedBytes, BALL_ATOMIC_RELAXED );
+
+	while ( nMapped > nPeak && !BALL_ATOMIC_CAS( &s_MemStats.nPeakMappedBytes, &nPeak, nMapped, BALL_ATOMIC_RELAXED ) )
+		;
+}
+
+static inline ptr_t Ball_SysMap( size_t nLength, int nProt, int nFlags )
+{
+	BALL_MEMSTAT_ADD( nMapCalls, 1 );
+
+	return mmap( BALL_NULL, nLength, nProt, nFlags, -1, 0 );
+}
+
+static inline void Ball_SysUnmap( ptr_t pMem, size_t nLength )
+{
+	BALL_MEMSTAT_ADD( nUnmapCalls, 1 );
+
+	( void )munmap( pMem, nLength );
+}
+
+static inline ptr_t Ball_SysRemap( ptr_t pOld, size_t nOldLength, size_t nNewLength, int nFlags, ptr_t pTarget )
+{
+	BALL_MEMSTAT_ADD( nRemapCalls, 1 );
+
+	return mremap( pOld, nOldLength, nNewLength, nFlags, pTarget );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Freed mapping kept for reuse; written over the start of the mapping.
+/// @note  Entries sit in a bucket list (by log2 of the length in pages) and in
+///        one age list (newest first) used for eviction.
+///-----------------------------------------------------------------------------
+struct Ball_CachedMap_t
+{
+	struct Ball_CachedMap_t *pNext;     ///< Bucket list.
+	struct Ball_CachedMap_t *pPrev;
+	struct Ball_CachedMap_t *pOlder;    ///< Age list.
+	struct Ball_CachedMap_t *pNewer;
+	size_t                   nLength;   ///< Mapping length.
+	uint32_t                 nFlags;    ///< Flags of the block that was freed (incl. internal ones).
+	uint32_t                 nBucket;
+	long long                nTime;     ///< Monotonic time of the free, in nanoseconds.
+}; // struct Ball_CachedMap_t
+
+///-----------------------------------------------------------------------------
+/// @brief Retained-mapping cache: freed mappings wait here (still committed)
+///        so that hot sizes are served without mmap/munmap and page faults.
+///-----------------------------------------------------------------------------
+static struct
+{
+	Ball_SpinLock_t          nLock;
+	size_t                   nBytes;                                  ///< Sum of cached lengths.
+	struct Ball_CachedMap_t *apBuckets[ BALL_MEMCACHE_BUCKETS ];
+	struct Ball_CachedMap_t *pNewest;
+	struct Ball_CachedMap_t *pOldest;
+} s_MemCache;
+
+static inline long long Ball_MonotonicNs( void )
+{
+	struct Ball_TimeSpec_t time;
+
+	if ( clock_gettime( BALL_CLOCK_MONOTONIC_COARSE, &time ) != 0 )
+		return 0;
+
+	return ( long long )time.nSeconds * 1000000000ll + time.nNanoseconds;
+}
+
+static inline uint32_t Ball_MemCacheBucket( size_t nLength )
+{
+	const unsigned long long nPages = ( unsigned long long )( nLength / Ball_PageSize() );
+	const uint32_t nBucket = nPages ? ( uint32_t )( 63 - __builtin_clzll( nPages ) ) : 0u;
+
+	return nBucket < BALL_MEMCACHE_BUCKETS ? nBucket : BALL_MEMCACHE_BUCKETS - 1;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Unlink @p pEntry from both lists. Caller holds the cache lock.
+///-----------------------------------------------------------------------------
+static void Ball_MemCacheUnlink( struct Ball_CachedMap_t *pEntry )
+{
+	if ( pEntry->pPrev )
+		pEntry->pPrev->pNext = pEntry->pNext;
+	else
+		s_MemCache.apBuckets[ pEntry->nBucket ] = pEntry->pNext;
+
+	if ( pEntry->pNext )
+		pEntry->pNext->pPrev = pEntry->pPrev;
+
+	if ( pEntry->pNewer )
+		pEntry->pNewer->pOlder = pEntry->pOlder;
+	else
+		s_MemCache.pNewest = pEntry->pOlder;
+
+	if ( pEntry->pOlder )
+		pEntry->pOlder->pNewer = pEntry->pNewer;
+	else
+		s_MemCache.pOldest = pEntry->pNewer;
+
+	BALL_ATOMIC_STORE( &s_MemCache.nBytes, s_MemCache.nBytes - pEntry->nLength, BALL_ATOMIC_RELAXED );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Detach the oldest entries until at most @p nMaxBytes stay cached and
+///        none is older than the age cap. Caller holds the cache lock.
+/// @return List (linked by pNext) of detached entries to unmap after unlocking.
+///-----------------------------------------------------------------------------
+static struct Ball_CachedMap_t *Ball_MemCacheEvict( size_t nMaxBytes, long long nNow )
+{
+	struct Ball_CachedMap_t *pEvicted = BALL_NULL;
+
+	while ( s_MemCache.pOldest && ( s_MemCache.nBytes > nMaxBytes || nNow - s_MemCache.pOldest->nTime > BALL_MEMCACHE_MAX_AGE_NS ) )
+	{
+		struct Ball_CachedMap_t *pEntry = s_MemCache.pOldest;
+
+		Ball_MemCacheUnlink( pEntry );
+
+		pEntry->pNext = pEvicted;
+		pEvicted = pEntry;
+	}
+
+	return pEvicted;
+}
+
+static size_t Ball_MemCacheRelease( struct Ball_CachedMap_t *pEvicted )
+{
+	size_t nReleased = 0;
+
+	while ( pEvicted )
+	{
+		struct Ball_CachedMap_t *pNext = pEvicted->pNext;
+
+		nReleased += pEvicted->nLength;
+		Ball_SysUnmap( pEvicted, pEvicted->nLength );
+
+		pEvicted = pNext;
+	}
+
+	return nReleased;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Take a cached mapping able to hold @p nSize bytes at @p nAlign.
+/// @param  bHuge Request needs a 2 MiB aligned base (huge page path).
+/// @return Mapping base (length/flags in *pLength/*pFlags) or BALL_NULL.
+/// @note   Only mappings allocated with the same public flags and at most twice
+///         the needed length are reused, so the cache never inflates blocks.
+///-----------------------------------------------------------------------------
+static ptr_t Ball_MemCacheTake( size_t nSize, size_t nAlign, uint32_t nFlags, bool_t bHuge, size_t *pLength, uint32_t *pFlags )
+{
+	const size_t nNeed = BALL_ROUND_UP( sizeof( struct Ball_AlignedHeader_t ), nAlign ) + nSize;
+
+	if ( nNeed < nSize || !BALL_ATOMIC_LOAD( &s_MemCache.nBytes, BALL_ATOMIC_RELAXED ) )
+		return BALL_NULL;
+
+	const uint32_t nFirst = Ball_MemCacheBucket( nNeed );
+	struct Ball_CachedMap_t *pFound = BALL_NULL;
+
+	Ball_SpinLock( &s_MemCache.nLock );
+
+	for ( uint32_t nBucket = nFirst; nBucket < BALL_MEMCACHE_BUCKETS && nBucket <= nFirst + 1 && !pFound; nBucket++ )
+	{
+		for ( struct Ball_CachedMap_t *pEntry = s_MemCache.apBuckets[ nBucket ]; pEntry; pEntry = pEntry->pNext )
+		{
+			const uintptr_t pBase = ( uintptr_t )pEntry;
+			const uintptr_t pUser = BALL_ROUND_UP( pBase + sizeof( struct Ball_AlignedHeader_t ), nAlign );
+
+			if ( ( pEntry->nFlags & ~BALL_ALLOC_HUGETLB_ ) != nFlags || pEntry->nLength / 2 > nNeed )
+				continue;
+
+			if ( pUser + nSize > pBase + pEntry->nLength || pUser + nSize < pUser )
+				continue;
+
+			if ( bHuge && ( pBase & ( BALL_HUGEPAGE_SIZE - 1 ) ) )
+				continue;
+
+			pFound = pEntry;
+			break;
+		}
+	}
+
+	if ( pFound )
+		Ball_MemCacheUnlink( pFound );
+
+	Ball_SpinUnlock( &s_MemCache.nLock );
+
+	if ( !pFound )
+		return BALL_NULL;
+
+	*pLength = pFound->nLength;
+	*pFlags  = pFound->nFlags;
+
+	return ( ptr_t )pFound;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Retain a freed mapping instead of unmapping it.
+/// @return Non-zero when the cache took ownership of the mapping.
+///-----------------------------------------------------------------------------
+static bool_t Ball_MemCachePut( ptr_t pBase, size_t nLength, uint32_t nFlags )
+{
+	if ( nLength > BALL_MEMCACHE_MAX_ENTRY )
+		return 0;
+
+	struct Ball_CachedMap_t *pEntry = ( struct Ball_CachedMap_t * )pBase;
+	const long long nNow = Ball_MonotonicNs();
+
+	pEntry->nLength = nLength;
+	pEntry->nFlags  = nFlags;
+	pEntry->nBucket = Ball_MemCacheBucket( nLength );
+	pEntry->nTime   = nNow;
+
+	Ball_SpinLock( &s_MemCache.nLock );
+
+	pEntry->pPrev  = BALL_NULL;
+	pEntry->pNext  = s_MemCache.apBuckets[ pEntry->nBucket ];
+	pEntry->pNewer = BALL_NULL;
+	pEntry->pOlder = s_MemCache.pNewest;
+
+	if ( pEntry->pNext )
+		pEntry->pNext->pPrev = pEntry;
+
+	if ( pEntry->pOlder )
+		pEntry->pOlder->pNewer = pEntry;
+	else
+		s_MemCache.pOldest = pEntry;
+
+	s_MemCache.apBuckets[ pEntry->nBucket ] = pEntry;
+	s_MemCache.pNewest = pEntry;
+
+	BALL_ATOMIC_STORE( &s_MemCache.nBytes, s_MemCache.nBytes + nLength, BALL_ATOMIC_RELAXED );
+
+	struct Ball_CachedMap_t *pEvicted = Ball_MemCacheEvict( BALL_MEMCACHE_MAX_BYTES, nNow );
+
+	Ball_SpinUnlock( &s_MemCache.nLock );
+
+	( void )Ball_MemCacheRelease( pEvicted );
+
+	return 1;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Release retained mappings.
+/// @param  nMaxBytes Bytes allowed to stay cached (0 empties the cache);
+///         entries past the age cap are released regardless.
+/// @return Bytes returned to the kernel.
+///-----------------------------------------------------------------------------
+size_t Ball_MemCacheTrim( size_t nMaxBytes )
+{
+	Ball_SpinLock( &s_MemCache.nLock );
+
+	struct Ball_CachedMap_t *pEvicted = Ball_MemCacheEvict( nMaxBytes, Ball_MonotonicNs() );
+
+	Ball_SpinUnlock( &s_MemCache.nLock );
+
+	return Ball_MemCacheRelease( pEvicted );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Count a slab block of class @p nClass handed out (@p bAlloc) or
+///        returned, into the same per-thread records as the mmap path.
+/// @note  One counter per call; live bytes are derived on read.
+///-----------------------------------------------------------------------------
+void Ball_MemStatSlab( uint32_t nClass, bool_t bAlloc )
+{
+	struct Ball_MemStats_t *pStats = Ball_MemThreadStats();
+
+	if ( pStats )
+	{
+		uint64_t *pCalls = bAlloc ? &pStats->aSlabAllocs[ nClass ] : &pStats->aSlabFrees[ nClass ];
+
+		BALL_ATOMIC_STORE( pCalls, BALL_ATOMIC_LOAD( pCalls, BALL_ATOMIC_RELAXED ) + 1u, BALL_ATOMIC_RELAXED );
+	}
+	else
+	{
+		Ball_SpinLock( &s_MemStats.nLock );
+		( bAlloc ? s_MemStats.Retired.aSlabAllocs : s_MemStats.Retired.aSlabFrees )[ nClass ]++;
+		Ball_SpinUnlock( &s_MemStats.nLock );
+	}
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Snapshot the counters of the Ball_*Align layer and the slab heap.
+/// @param  pStats Receives per-thread counters summed over all threads (live
+///         and exited) plus the process-wide mapped byte gauges.
+///-----------------------------------------------------------------------------
+void Ball_MemStats( struct Ball_MemStats_t *pStats )
+{
+	uint64_t *pOut = ( uint64_t * )pStats;
+
+	Ball_SpinLock( &s_MemStats.nLock );
+
+	__builtin_memcpy( pStats, &s_MemStats.Retired, sizeof( *pStats ) );
+
+	for ( struct Ball_MemThreadStats_t *pThread = s_MemStats.pThreads; pThread; pThread = pThread->pNext )
+	{
+		const uint64_t *pCounters = ( const uint64_t * )&pThread->Stats;
+
+		for ( size_t n = 0; n < BALL_MEMSTATS_COUNTERS; n++ )
+			pOut[ n ] += BALL_ATOMIC_LOAD( &pCounters[ n ], BALL_ATOMIC_RELAXED );
+	}
+
+	Ball_SpinUnlock( &s_MemStats.nLock );
+
+	pStats->nMappedBytes     = BALL_ATOMIC_LOAD( &s_MemStats.nMappedBytes, BALL_ATOMIC_RELAXED );
+	pStats->nPeakMappedBytes = BALL_ATOMIC_LOAD( &s_MemStats.nPeakMappedBytes, BALL_ATOMIC_RELAXED );
+	pStats->nCachedBytes     = BALL_ATOMIC_LOAD( &s_MemCache.nBytes, BALL_ATOMIC_RELAXED );
+
+	// A snapshot racing other threads may count a free before its alloc.
+	for ( uint32_t nClass = 0; nClass < BALL_MEMSTATS_SLAB_CLASSES; nClass++ )
+	{
+		const uint64_t nLive = pStats->aSlabAllocs[ nClass ] - pStats->aSlabFrees[ nClass ];
+
+		pStats->aSlabLiveBytes[ nClass ] = ( int64_t )nLive > 0 ? nLive * Ball_SlabClassSize( nClass ) : 0u;
+	}
+}
+
+static _Thread_local struct Ball_MemBudget_t *s_pMemBudget;
+
+///-----------------------------------------------------------------------------
+/// @brief  Set up a budget (see Ball_MemBudget_t) below @p pParent (or at the top).
+///-----------------------------------------------------------------------------
+void Ball_MemBudgetInit( struct Ball_MemBudget_t *pBudget, const char *pszName, struct Ball_MemBudget_t *pParent, uint64_t nSoftLimit, uint64_t nHardLimit )
+{
+	__builtin_memset( pBudget, 0, sizeof( *pBudget ) );
+
+	pBudget->pszName    = pszName;
+	pBudget->pParent    = pParent;
+	pBudget->nSoftLimit = nSoftLimit;
+	pBudget->nHardLimit = nHardLimit;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Register @p pHook to run when @p pBudget crosses its soft limit.
+/// @note   Lock-free push; safe while other threads allocate against the budget.
+///-----------------------------------------------------------------------------
+void Ball_MemBudgetAddHook( struct Ball_MemBudget_t *pBudget, struct Ball_MemPressureHook_t *pHook )
+{
+	struct Ball_MemPressureHook_t *pHead = BALL_ATOMIC_LOAD( &pBudget->pHooks, BALL_ATOMIC_RELAXED );
+
+	do
+	{
+		pHook->pNext = pHead;
+	}
+	while ( !BALL_ATOMIC_CAS( &pBudget->pHooks, &pHead, pHook, BALL_ATOMIC_RELEASE ) );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Make @p pBudget (BALL_NULL: none) the one the calling thread's new
+///         mappings are charged to.
+/// @return The previous budget, to be restored when the scope ends.
+///-----------------------------------------------------------------------------
+struct Ball_MemBudget_t *Ball_MemBudgetSwap( struct Ball_MemBudget_t *pBudget )
+{
+	struct Ball_MemBudget_t *pPrevious = s_pMemBudget;
+
+	s_pMemBudget = pBudget;
+
+	return pPrevious;
+}
+
+static void Ball_MemBudgetCredit( struct Ball_MemBudget_t *pBudget, size_t nBytes )
+{
+	for ( ; pBudget; pBudget = pBudget->pParent )
+		BALL_ATOMIC_SUB( &pBudget->nUsed, ( uint64_t )nBytes, BALL_ATOMIC_RELAXED );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Charge @p nBytes to @p pBudget and its ancestors.
+/// @return false (nothing charged) when a hard limit would be exceeded.
+/// @note   Pressure hooks of the budgets whose soft limit this charge crossed
+///         run after the charge is final, with no lock held, so they may free
+///         (or allocate) themselves.
+///-----------------------------------------------------------------------------
+static bool_t Ball_MemBudgetCharge( struct Ball_MemBudget_t *pBudget, size_t nBytes )
+{
+	uint64_t nCrossed = 0; // Bit n: the budget n levels up crossed its soft limit.
+	uint32_t nLevel = 0;
+
+	for ( struct Ball_MemBudget_t *pLevel = pBudget; pLevel; pLevel = pLevel->pParent, nLevel++ )
+	{
+		const uint64_t nUsed = BALL_ATOMIC_ADD( &pLevel->nUsed, ( uint64_t )nBytes, BALL_ATOMIC_RELAXED );
+
+		if ( pLevel->nHardLimit && nUsed > pLevel->nHardLimit )
+		{
+			for ( struct Ball_MemBudget_t *pUndo = pBudget; ; pUndo = pUndo->pParent )
+			{
+				BALL_ATOMIC_SUB( &pUndo->nUsed, ( uint64_t )nBytes, BALL_ATOMIC_RELAXED );
+
+				if ( pUndo == pLevel )
+					break;
+			}
+
+			BALL_ATOMIC_ADD( &pLevel->nDenied, 1, BALL_ATOMIC_RELAXED );
+
+			return 0;
+		}
+
+		if ( pLevel->nSoftLimit && nUsed > pLevel->nSoftLimit && nUsed - nBytes <= pLevel->nSoftLimit && nLevel < 64 )
+			nCrossed |= 1ull << nLevel;
+
+		uint64_t nPeak = BALL_ATOMIC_LOAD( &pLevel->nPeak, BALL_ATOMIC_RELAXED );
+
+		while ( nPeak < nUsed && !BALL_ATOMIC_CAS( &pLevel->nPeak, &nPeak, nUsed, BALL_ATOMIC_RELAXED ) )
+			;
+	}
+
+	nLevel = 0;
+
+	for ( struct Ball_MemBudget_t *pLevel = pBudget; nCrossed; pLevel = pLevel->pParent, nLevel++ )
+	{
+		if ( !( nCrossed & ( 1ull << nLevel ) ) )
+			continue;
+
+		nCrossed &= ~( 1ull << nLevel );
+
+		for ( struct Ball_MemPressureHook_t *pHook = BALL_ATOMIC_LOAD( &pLevel->pHooks, BALL_ATOMIC_ACQUIRE ); pHook; pHook = pHook->pNext )
+			pHook->pfnPressure( pLevel, pHook->pContext );
+	}
+
+	return 1;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Fault in the pages spanning [pMem, pMem + nSize) for writing now, so
+///         first writes on a hot path do not take page faults.
+/// @note   MADV_POPULATE_WRITE (Linux 5.14+) does it in one call; older kernels
+///         get a read + write back of one byte per page, which keeps contents.
+///         Works on any memory the caller owns (slab blocks included).
+///-----------------------------------------------------------------------------
+void Ball_MemPopulate( ptr_t pMem, size_t nSize )
+{
+	if ( !pMem || !nSize )
+		return;
+
+	const size_t    nPage  = Ball_PageSize();
+	const uintptr_t pBegin = BALL_ROUND_DOWN( ( uintptr_t )pMem, nPage );
+	const uintptr_t pEnd   = BALL_ROUND_UP( ( uintptr_t )pMem + nSize, nPage );
+
+	BALL_MEMSTAT_ADD( nPopulateBytes, pEnd - pBegin );
+
+	if ( madvise( ( ptr_t )pBegin, ( size_t )( pEnd - pBegin ), BALL_MADV_POPULATE_WRITE ) == 0 )
+		return;
+
+	const uintptr_t pLast = ( uintptr_t )pMem + nSize;
+
+	for ( uintptr_t pTouch = ( uintptr_t )pMem; pTouch < pLast; pTouch = BALL_ROUND_DOWN( pTouch, nPage ) + nPage )
+	{
+		volatile uchar_t *pByte = ( volatile uchar_t * )pTouch;
+
+		*pByte = *pByte;
+	}
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Charge a new mapping to @p pBudget and write the header of its block
+///         right before @p pUser.
+/// @param  nReserveLength Whole range of a Ball_ReserveAlign block (0 otherwise);
+///         only its committed @p nMapLength prefix is charged.
+/// @return @p pUser, or BALL_NULL (mapping released) over the budget's hard limit.
+///-----------------------------------------------------------------------------
+static ptr_t Ball_InitBlock( ptr_t pRaw, size_t nMapLength, ptr_t pUser, size_t nSize, uint32_t nFlags, struct Ball_MemBudget_t *pBudget, size_t nReserveLength )
+{
+	if ( !Ball_MemBudgetCharge( pBudget, nMapLength ) )
+	{
+		Ball_SysUnmap( pRaw, nReserveLength ? nReserveLength : nMapLength );
+
+		return BALL_NULL;
+	}
+
+	struct Ball_AlignedHeader_t *pHeader = ( ( struct Ball_AlignedHeader_t * )pUser ) - 1;
+
+	pHeader->pRaw       = pRaw;
+	pHeader->nSize      = nSize;
+	pHeader->nMapLength = nMapLength;
+	pHeader->nMagic     = BALL_MAGIC;
+	pHeader->nFlags     = nFlags;
+	pHeader->pBudget    = pBudget;
+	pHeader->nReserveLength = nReserveLength;
+
+	Ball_MemStatMapped( nMapLength, 0 );
+
+	if ( nFlags & BALL_ALLOC_POPULATE )
+		Ball_MemPopulate( pRaw, nMapLength );
+
+	return pUser;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Map @p nLength bytes starting at a multiple of @p nAlign (> page).
+/// @return Mapping base or BALL_NULL on failure.
+/// @note   Overmaps by @p nAlign and trims head/tail with munmap.
+///-----------------------------------------------------------------------------
+static ptr_t Ball_MapAligned( size_t nLength, size_t nAlign, int nProt, int nFlags )
+{
+	const size_t nMapLenInitial = nLength + nAlign;
+
+	ptr_t pMapInitial = Ball_SysMap( nMapLenInitial, nProt, BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS | nFlags );
+
+	if ( pMapInitial == BALL_MAP_FAILED )
+		return BALL_NULL;
+
+	const uintptr_t pData      = ( uintptr_t )pMapInitial;
+	const uintptr_t pKeepStart = BALL_ROUND_UP( pData, nAlign );
+	const uintptr_t pKeepEnd   = pKeepStart + nLength;
+	const uintptr_t pMapEnd    = pData + nMapLenInitial;
+
+	if ( pKeepStart > pData )
+		Ball_SysUnmap( ( void * )pData, ( size_t )( pKeepStart - pData ) );
+
+	if ( pKeepEnd < pMapEnd )
+		Ball_SysUnmap( ( void * )pKeepEnd, ( size_t )( pMapEnd - pKeepEnd ) );
+
+	return ( ptr_t )pKeepStart;
+}
+
 ///-----------------------------------------------------------------------------
-/// @brief Header placed immediately before the user pointer inside the same VMA.
-/// @note  Lives in the same mapping as the user memory (no separate allocation).
+/// @brief  Huge page variant of Ball_AllocAlign.
+/// @note
+///   * The mapping (not the user pointer) is 2 MiB aligned; the header sits at
+///     its start and user data follows at the first @p nAlign boundary.
+///   * Tries the hugetlb pool first (MAP_HUGETLB, length rounded to 2 MiB).
+///     Without reserved huge pages it falls back to a 2 MiB aligned regular
+///     mapping marked MADV_HUGEPAGE, so THP can back it.
 ///-----------------------------------------------------------------------------
-struct Ball_AlignedHeader_t
+static ptr_t Ball_AllocHuge( size_t nSize, size_t nAlign, uint32_t nFlags, struct Ball_MemBudget_t *pBudget )
 {
-	ptr_t    pRaw;          ///< Mapping base address (after head trim).
-	size_t   nSize;         ///< Logical size requested by the user.
-	size_t   nMapLength;    ///< Full mapping length to pass to munmap/mremap.
-	uint32_t nMagic;        ///< Signature to validate that the pointer is ours.
-}; // struct Ball_AlignedHeader_t
+	const size_t nOffset     = BALL_ROUND_UP( sizeof( struct Ball_AlignedHeader_t ), nAlign );
+	const size_t nHugeLength = BALL_ROUND_UP( nOffset + nSize, BALL_HUGEPAGE_SIZE );
+
+	size_t nMapLength = nHugeLength;
+	ptr_t  pBase      = Ball_SysMap( nHugeLength, BALL_PROT_READ | BALL_PROT_WRITE,
+	                                 BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS | BALL_MAP_HUGETLB | BALL_MAP_HUGE_2MB );
+
+	if ( pBase != BALL_MAP_FAILED )
+	{
+		nFlags |= BALL_ALLOC_HUGETLB_;
+	}
+	else
+	{
+		nMapLength = BALL_ROUND_UP( nOffset + nSize, Ball_PageSize() );
+		pBase      = Ball_MapAligned( nMapLength, BALL_HUGEPAGE_SIZE, BALL_PROT_READ | BALL_PROT_WRITE, 0 );
+
+		BALL_ASSERT_IF_MESSAGE( !pBase, "Huge page map failed" )
+		{
+			return BALL_NULL;
+		}
+
+		( void )madvise( pBase, nMapLength, BALL_MADV_HUGEPAGE );
+	}
+
+	return Ball_InitBlock( pBase, nMapLength, ( ptr_t )( ( uintptr_t )pBase + nOffset ), nSize, nFlags, pBudget, 0 );
+}
 
 ///-----------------------------------------------------------------------------
-/// @brief Returns system page size (falls back to 4096 on failure).
-/// @note  Cached page size is not necessary here; sysconf is cheap enough,
-///        and this helper is rarely on a hot path.
+/// @brief Return the whole pages of @p pHeader's mapping past @p pNeedEnd to the
+///        OS once the slack is worth it (see BALL_MEMSHRINK_*).
+/// @note
+///   * Partial munmap rather than madvise( MADV_DONTNEED/MADV_FREE ): the
+///     mapping has to be regrown by mremap anyway, and the mapped byte gauges
+///     then match what is resident.
+///   * The thresholds give hysteresis, so a block that shrinks and grows by a
+///     few elements around a page boundary does not trade syscalls.
+///   * hugetlb mappings can only be cut at huge page boundaries.
+///   * Reserved ranges (Ball_ReserveAlign) must keep their address space, so
+///     the slack is decommitted instead: a fresh PROT_NONE mapping over it
+///     drops the pages and the commit charge in one call.
 ///-----------------------------------------------------------------------------
-static inline size_t Ball_PageSize( void )
+static void Ball_ReleaseSlack( struct Ball_AlignedHeader_t *pHeader, uintptr_t pNeedEnd )
 {
-	long_t nPageSize = sysconf( BALL_SC_PAGESIZE );
+	if ( pHeader->nFlags & BALL_ALLOC_BATCH_ )
+		return;
 
-	return ( nPageSize > 0 ) ? ( size_t )nPageSize : 4096u;
+	const size_t    nGranule = ( pHeader->nFlags & BALL_ALLOC_HUGETLB_ ) ? BALL_HUGEPAGE_SIZE : Ball_PageSize();
+	const uintptr_t pBase    = ( uintptr_t )pHeader->pRaw;
+	const uintptr_t pMapEnd  = pBase + pHeader->nMapLength;
+	const uintptr_t pKeepEnd = BALL_ROUND_UP( pNeedEnd, nGranule );
+
+	if ( pKeepEnd >= pMapEnd )
+		return;
+
+	const size_t nSlack      = ( size_t )( pMapEnd - pKeepEnd );
+	const size_t nKeepLength = ( size_t )( pKeepEnd - pBase );
+
+	if ( nSlack < BALL_MEMSHRINK_MIN_BYTES || nSlack < nKeepLength / BALL_MEMSHRINK_MIN_RATIO )
+		return;
+
+	if ( !pHeader->nReserveLength )
+	{
+		Ball_SysUnmap( ( ptr_t )pKeepEnd, nSlack );
+	}
+	else if ( mmap( ( ptr_t )pKeepEnd, nSlack, BALL_PROT_NONE, BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS | BALL_MAP_NORESERVE | BALL_MAP_FIXED, -1, 0 ) == BALL_MAP_FAILED )
+	{
+		return;
+	}
+
+	pHeader->nMapLength = nKeepLength;
+
+	BALL_MEMSTAT_ADD( nShrinkCalls, 1 );
+	BALL_MEMSTAT_ADD( nShrinkBytes, nSlack );
+	Ball_MemStatMapped( 0, nSlack );
+	Ball_MemBudgetCredit( pHeader->pBudget, nSlack );
 }
 
 ///-----------------------------------------------------------------------------
-/// @brief Convert a user pointer back to our header (with validation).
-/// @return Pointer to header or BALL_NULL if invalid.
-/// @note   Precondition: @p user must be a pointer returned by Ball_AllocAlign.
+/// @brief Drop one block of a Ball_AllocBatch mapping; the last one unmaps it.
 ///-----------------------------------------------------------------------------
-static inline struct Ball_AlignedHeader_t *Ball_HeaderFromUser( ptr_t pUser )
+static void Ball_BatchRelease( struct Ball_BatchHeader_t *pBatch )
 {
-	if ( !pUser )
+	if ( BALL_ATOMIC_SUB( &pBatch->nLive, 1, BALL_ATOMIC_ACQ_REL ) )
+		return;
+
+	Ball_MemStatMapped( 0, pBatch->nMapLength );
+	Ball_MemBudgetCredit( pBatch->pBudget, pBatch->nMapLength );
+	Ball_SysUnmap( pBatch, pBatch->nMapLength );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Commit the pages a reserved block needs to hold @p nNewSize bytes.
+/// @return The unchanged user pointer, or BALL_NULL when @p nNewSize does not fit
+///         the reserved range, the budget's hard limit is hit or mprotect fails
+///         (the block is then left as it was).
+///-----------------------------------------------------------------------------
+static ptr_t Ball_CommitReserved( struct Ball_AlignedHeader_t *pHeader, size_t nNewSize )
+{
+	const uintptr_t pUser       = ( uintptr_t )( pHeader + 1 );
+	const uintptr_t pBase       = ( uintptr_t )pHeader->pRaw;
+	const uintptr_t pReserveEnd = pBase + pHeader->nReserveLength;
+
+	if ( nNewSize > ( size_t )( pReserveEnd - pUser ) )
 		return BALL_NULL;
 
-	struct Ball_AlignedHeader_t *h = ( ( struct Ball_AlignedHeader_t * )pUser ) - 1;
+	const uintptr_t pCommitEnd = pBase + pHeader->nMapLength;
+	const uintptr_t pNeedEnd   = BALL_ROUND_UP( pUser + nNewSize, Ball_PageSize() );
+	const size_t    nGrow      = ( size_t )( pNeedEnd - pCommitEnd );
 
-	if ( h->nMagic != BALL_MAGIC )
+	if ( !Ball_MemBudgetCharge( pHeader->pBudget, nGrow ) )
 		return BALL_NULL;
 
-	return h;
+	BALL_MEMSTAT_ADD( nCommitCalls, 1 );
+
+	if ( mprotect( ( ptr_t )pCommitEnd, nGrow, BALL_PROT_READ | BALL_PROT_WRITE ) != 0 )
+	{
+		Ball_MemBudgetCredit( pHeader->pBudget, nGrow );
+
+		return BALL_NULL;
+	}
+
+	pHeader->nSize       = nNewSize;
+	pHeader->nMapLength += nGrow;
+
+	Ball_MemStatMapped( nGrow, 0 );
+
+	if ( pHeader->nFlags & BALL_ALLOC_POPULATE )
+		Ball_MemPopulate( ( ptr_t )pCommitEnd, nGrow );
+
+	return ( ptr_t )pUser;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Reserve address space for a block that can grow to @p nMaxSize bytes
+///         without ever moving.
+/// @param  nMaxSize Largest logical size the block will be resized to.
+/// @param  nAlign   Alignment (power of two, >= sizeof( ptr_t )).
+/// @param  nFlags   BALL_ALLOC_* flags (BALL_ALLOC_HUGEPAGE is ignored).
+/// @return User pointer of an empty block (Ball_MemSize() == 0) or BALL_NULL.
+/// @note
+///   * The range is mapped PROT_NONE + MAP_NORESERVE, so it costs neither
+///     memory nor commit charge; only the header page is accessible at first.
+///   * Ball_ReallocAlign commits (mprotect) or decommits whole pages in place
+///     and fails rather than move past @p nMaxSize, so pointers into the block
+///     stay valid for its lifetime. Release it with Ball_FreeAlign.
+///   * Only committed pages count as mapped (Ball_MemStats) and are charged
+///     to the calling thread's budget.
+///-----------------------------------------------------------------------------
+ptr_t Ball_ReserveAlign( size_t nMaxSize, size_t nAlign, uint32_t nFlags )
+{
+	if ( !nMaxSize )
+		return BALL_NULL;
+
+	if ( !BALL_IS_POW2( nAlign ) || nAlign < sizeof( ptr_t ) )
+		return BALL_NULL;
+
+	const size_t nPage   = Ball_PageSize();
+	const size_t nOffset = BALL_ROUND_UP( sizeof( struct Ball_AlignedHeader_t ), nAlign );
+
+	nFlags &= ~( BALL_ALLOC_HUGEPAGE | BALL_ALLOC_HUGETLB_ );
+	nMaxSize = Ball_PadSize( nMaxSize, nFlags );
+
+	if ( !nMaxSize || nMaxSize > ~( size_t )0u - nOffset - nPage )
+		return BALL_NULL;
+
+	BALL_MEMSTAT_ADD( nAllocCalls, 1 );
+	BALL_MEMSTAT_ADD( aSizeHistogram[ 63 - __builtin_clzll( ( unsigned long long )nMaxSize ) ], 1 );
+
+	const size_t nReserveLength = BALL_ROUND_UP( nOffset + nMaxSize, nPage );
+	const size_t nCommitLength  = BALL_ROUND_UP( nOffset, nPage );
+
+	ptr_t pBase;
+
+	if ( nAlign > nPage )
+	{
+		pBase = Ball_MapAligned( nReserveLength, nAlign, BALL_PROT_NONE, BALL_MAP_NORESERVE );
+	}
+	else
+	{
+		pBase = Ball_SysMap( nReserveLength, BALL_PROT_NONE, BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS | BALL_MAP_NORESERVE );
+
+		if ( pBase == BALL_MAP_FAILED )
+			pBase = BALL_NULL;
+	}
+
+	BALL_ASSERT_IF_MESSAGE( !pBase, "Address space reservation failed" )
+	{
+		return BALL_NULL;
+	}
+
+	if ( mprotect( pBase, nCommitLength, BALL_PROT_READ | BALL_PROT_WRITE ) != 0 )
+	{
+		Ball_SysUnmap( pBase, nReserveLength );
+
+		return BALL_NULL;
+	}
+
+	BALL_MEMSTAT_ADD( nCommitCalls, 1 );
+
+	return Ball_InitBlock( pBase, nCommitLength, ( ptr_t )( ( uintptr_t )pBase + nOffset ), 0, nFlags, s_pMemBudget, nReserveLength );
 }
 
 ///-----------------------------------------------------------------------------
@@ -61,6 +976,14 @@ static inline struct Ball_AlignedHeader_t *Ball_HeaderFromUser( ptr_t pUser )
 ///   * No guard pages are used; caller can add them explicitly if needed.
 ///-----------------------------------------------------------------------------
 ptr_t Ball_AllocAlign( size_t nSize, size_t nAlign )
+{
+	return Ball_AllocAlignEx( nSize, nAlign, 0 );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Ball_AllocAlignEx charging @p pBudget rather than the thread's budget.
+///-----------------------------------------------------------------------------
+static ptr_t Ball_AllocAlignIn( size_t nSize, size_t nAlign, uint32_t nFlags, struct Ball_MemBudget_t *pBudget )
 {
 	if ( !nSize )
 		return BALL_NULL;
@@ -68,14 +991,37 @@ ptr_t Ball_AllocAlign( size_t nSize, size_t nAlign )
 	if ( !BALL_IS_POW2( nAlign ) || nAlign < sizeof( ptr_t ) )
 		return BALL_NULL;
 
+	nFlags &= ~( BALL_ALLOC_HUGETLB_ | BALL_ALLOC_BATCH_ );
+
+	BALL_MEMSTAT_ADD( nAllocCalls, 1 );
+	BALL_MEMSTAT_ADD( aSizeHistogram[ 63 - __builtin_clzll( ( unsigned long long )nSize ) ], 1 );
+
+	const bool_t bHuge = ( nFlags & BALL_ALLOC_HUGEPAGE ) && nAlign <= BALL_HUGEPAGE_SIZE &&
+	                     nSize >= BALL_HUGEPAGE_SIZE - BALL_ROUND_UP( sizeof( struct Ball_AlignedHeader_t ), nAlign );
+
+	// Recently freed mapping of a fitting length: no syscall, no fresh page faults.
+	size_t   nCachedLength;
+	uint32_t nCachedFlags;
+	ptr_t    pCached = Ball_MemCacheTake( nSize, nAlign, nFlags, bHuge, &nCachedLength, &nCachedFlags );
+
+	if ( pCached )
+	{
+		BALL_MEMSTAT_ADD( nCacheHits, 1 );
+
+		const uintptr_t pUser = BALL_ROUND_UP( ( uintptr_t )pCached + sizeof( struct Ball_AlignedHeader_t ), nAlign );
+
+		return Ball_InitBlock( pCached, nCachedLength, ( ptr_t )pUser, nSize, nCachedFlags, pBudget, 0 );
+	}
+
+	if ( bHuge )
+		return Ball_AllocHuge( nSize, nAlign, nFlags, pBudget );
+
 	const size_t nPage            = Ball_PageSize();
 	const size_t nNeed            = nSize + nAlign + sizeof( struct Ball_AlignedHeader_t );
 	const size_t nMapLenInitial   = BALL_ROUND_UP( nNeed, nPage );
 
 	// Initial overmap: we will trim extra head/tail pages later.
-	ptr_t pMapInitial = mmap( BALL_NULL, nMapLenInitial,
-	                          BALL_PROT_READ | BALL_PROT_WRITE,
-	                          BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS, -1, 0 );
+	ptr_t pMapInitial = Ball_SysMap( nMapLenInitial, BALL_PROT_READ | BALL_PROT_WRITE, BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS );
 
 	BALL_ASSERT_IF_MESSAGE( pMapInitial == BALL_MAP_FAILED, "Initial map failed" )
 	{
@@ -97,7 +1043,7 @@ ptr_t Ball_AllocAlign( size_t nSize, size_t nAlign )
 	{
 		const size_t nHeadLength = ( size_t )( pKeepStart - pData );
 
-		( void )munmap( ( void * )pData, nHeadLength );
+		Ball_SysUnmap( ( void * )pData, nHeadLength );
 	}
 
 	// Trim tail.
@@ -105,28 +1051,154 @@ ptr_t Ball_AllocAlign( size_t nSize, size_t nAlign )
 	{
 		const size_t nTailLength = ( size_t )( pMapEnd - pKeepEnd );
 
-		( void )munmap( ( void * )pKeepEnd, nTailLength );
+		Ball_SysUnmap( ( void * )pKeepEnd, nTailLength );
 	}
 
-	ptr_t   pRaw        = ( ptr_t )pKeepStart;
-	size_t  nMapLength  = ( size_t )( pKeepEnd - pKeepStart );
-	ptr_t   pUser       = ( ptr_t )pCandUser;
+	return Ball_InitBlock( ( ptr_t )pKeepStart, ( size_t )( pKeepEnd - pKeepStart ), ( ptr_t )pCandUser, nSize, nFlags, pBudget, 0 );
+}
 
-	// Initialize header located right before the aligned user pointer.
-	struct Ball_AlignedHeader_t *pHeader = ( ( struct Ball_AlignedHeader_t * )pUser ) - 1;
+///-----------------------------------------------------------------------------
+/// @brief  Ball_AllocAlign with BALL_ALLOC_* flags.
+/// @note   Flags are stored in the header, so Ball_ReallocAlign keeps honoring
+///         them. BALL_ALLOC_HUGEPAGE only takes effect for mappings of at least
+///         BALL_HUGEPAGE_SIZE; smaller ones switch over once they grow.
+///         The mapping is charged to the calling thread's budget (see
+///         Ball_MemBudgetSwap), and BALL_NULL is returned over its hard limit.
+///-----------------------------------------------------------------------------
+ptr_t Ball_AllocAlignEx( size_t nSize, size_t nAlign, uint32_t nFlags )
+{
+	if ( !nSize )
+		return BALL_NULL;
 
-	pHeader->pRaw       = pRaw;
-	pHeader->nSize      = nSize;
-	pHeader->nMapLength = nMapLength;
-	pHeader->nMagic     = BALL_MAGIC;
+	return Ball_AllocAlignIn( Ball_PadSize( nSize, nFlags ), nAlign, nFlags, s_pMemBudget );
+}
 
-	return pUser;
+///-----------------------------------------------------------------------------
+/// @brief  Allocate @p nCount blocks out of one mapping (one mmap for all).
+/// @param  ppBlocks Receives the blocks; BALL_NULL for empty ones.
+/// @param  pCounts  Block n holds pCounts[ n ] * @p nUnit bytes.
+/// @param  nAlign   Alignment of every block (same constraints as in alloc).
+/// @param  nFlags   BALL_ALLOC_* flags (BALL_ALLOC_HUGEPAGE is ignored).
+/// @return false (and no blocks) on failure.
+/// @note
+///   * Blocks are regular Ball_*Align blocks: each is freed, resized and
+///     sized on its own. A block grows in place up to the next one and is
+///     moved out beyond that.
+///   * The mapping is charged to the calling thread's budget as a whole and
+///     released, in one munmap, once its last block is freed.
+///-----------------------------------------------------------------------------
+bool_t Ball_AllocBatch( ptr_t *ppBlocks, const size_t *pCounts, size_t nCount, size_t nUnit, size_t nAlign, uint32_t nFlags )
+{
+	if ( !BALL_IS_POW2( nAlign ) || nAlign < sizeof( ptr_t ) )
+		return 0;
+
+	nFlags &= ~( BALL_ALLOC_HUGEPAGE | BALL_ALLOC_HUGETLB_ );
+
+	// First pass: block offsets from the mapping start, kept in ppBlocks.
+	const size_t nRoom   = ( ~( size_t )0u >> 1 ) - nAlign - sizeof( struct Ball_AlignedHeader_t ) - BALL_ALLOC_PADDING;
+	size_t       nCursor = sizeof( struct Ball_BatchHeader_t );
+	size_t       nBlocks = 0;
+
+	for ( size_t n = 0; n < nCount; n++ )
+	{
+		ppBlocks[ n ] = BALL_NULL;
+
+		if ( !pCounts[ n ] )
+			continue;
+
+		if ( nCursor > nRoom || ( nUnit && pCounts[ n ] > ( nRoom - nCursor ) / nUnit ) )
+		{
+			__builtin_memset( ppBlocks, 0, n * sizeof( ptr_t ) );
+
+			return 0;
+		}
+
+		const size_t nOffset = BALL_ROUND_UP( nCursor + sizeof( struct Ball_AlignedHeader_t ), nAlign );
+
+		ppBlocks[ n ] = ( ptr_t )nOffset;
+		nCursor       = nOffset + Ball_PadSize( pCounts[ n ] * nUnit, nFlags );
+		nBlocks++;
+	}
+
+	if ( !nBlocks )
+		return 1;
+
+	const size_t nPage      = Ball_PageSize();
+	const size_t nMapLength = BALL_ROUND_UP( nCursor, nPage );
+
+	ptr_t pBase;
+
+	if ( nAlign > nPage )
+	{
+		pBase = Ball_MapAligned( nMapLength, nAlign, BALL_PROT_READ | BALL_PROT_WRITE, 0 );
+	}
+	else
+	{
+		pBase = Ball_SysMap( nMapLength, BALL_PROT_READ | BALL_PROT_WRITE, BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS );
+
+		if ( pBase == BALL_MAP_FAILED )
+			pBase = BALL_NULL;
+	}
+
+	if ( pBase && !Ball_MemBudgetCharge( s_pMemBudget, nMapLength ) )
+	{
+		Ball_SysUnmap( pBase, nMapLength );
+		pBase = BALL_NULL;
+	}
+
+	if ( !pBase )
+	{
+		__builtin_memset( ppBlocks, 0, nCount * sizeof( ptr_t ) );
+
+		return 0;
+	}
+
+	struct Ball_BatchHeader_t *pBatch = ( struct Ball_BatchHeader_t * )pBase;
+
+	pBatch->nMapLength = nMapLength;
+	pBatch->nLive      = nBlocks;
+	pBatch->pBudget    = s_pMemBudget;
+
+	// Second pass, from the end: each slot reaches up to the next block's header.
+	size_t nSlotEnd = nMapLength;
+
+	for ( size_t n = nCount; n-- > 0; )
+	{
+		if ( !ppBlocks[ n ] )
+			continue;
+
+		const size_t nOffset = ( size_t )ppBlocks[ n ];
+		struct Ball_AlignedHeader_t *pHeader = ( struct Ball_AlignedHeader_t * )( ( uintptr_t )pBase + nOffset ) - 1;
+
+		pHeader->pRaw           = pBase;
+		pHeader->nSize          = Ball_PadSize( pCounts[ n ] * nUnit, nFlags );
+		pHeader->nMapLength     = nSlotEnd;
+		pHeader->nMagic         = BALL_MAGIC;
+		pHeader->nFlags         = nFlags | BALL_ALLOC_BATCH_;
+		pHeader->pBudget        = pBatch->pBudget;
+		pHeader->nReserveLength = 0;
+
+		ppBlocks[ n ] = ( ptr_t )( pHeader + 1 );
+		nSlotEnd      = nOffset - sizeof( struct Ball_AlignedHeader_t );
+	}
+
+	BALL_MEMSTAT_ADD( nBatchCalls, 1 );
+	BALL_MEMSTAT_ADD( nBatchBlocks, nBlocks );
+	Ball_MemStatMapped( nMapLength, 0 );
+
+	if ( nFlags & BALL_ALLOC_POPULATE )
+		Ball_MemPopulate( pBase, nMapLength );
+
+	return 1;
 }
 
 ///-----------------------------------------------------------------------------
 /// @brief  Free memory allocated by Ball_AllocAlign.
 /// @param  pMem User pointer previously returned by Ball_AllocAlign.
 /// @note   Safe to call with invalid/foreign pointer: function will no-op.
+///         Mappings up to BALL_MEMCACHE_MAX_ENTRY are retained for reuse (see
+///         Ball_MemCacheTrim) rather than unmapped right away; reserved ranges
+///         are always unmapped. A Ball_AllocBatch mapping goes with its last block.
 ///-----------------------------------------------------------------------------
 void Ball_FreeAlign( ptr_t pMem )
 {
@@ -135,8 +1207,52 @@ void Ball_FreeAlign( ptr_t pMem )
 	if ( !pHeader )
 		return;
 
+	BALL_MEMSTAT_ADD( nFreeCalls, 1 );
+
+	if ( pHeader->nFlags & BALL_ALLOC_BATCH_ )
+	{
+		pHeader->nMagic = 0;
+		Ball_BatchRelease( ( struct Ball_BatchHeader_t * )pHeader->pRaw );
+
+		return;
+	}
+
+	Ball_MemStatMapped( 0, pHeader->nMapLength );
+	Ball_MemBudgetCredit( pHeader->pBudget, pHeader->nMapLength );
+
 	pHeader->nMagic = 0; // Poison signature to minimize accidental reuse.
-	( void )munmap( pHeader->pRaw, pHeader->nMapLength );
+
+	if ( pHeader->nReserveLength )
+		Ball_SysUnmap( pHeader->pRaw, pHeader->nReserveLength );
+	else if ( !Ball_MemCachePut( pHeader->pRaw, pHeader->nMapLength, pHeader->nFlags ) )
+		Ball_SysUnmap( pHeader->pRaw, pHeader->nMapLength );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Realloc fallback: allocate a new aligned block, copy the data, and
+///         free the old one. The new block is charged to the old block's budget.
+///-----------------------------------------------------------------------------
+static ptr_t Ball_ReallocCopy( struct Ball_AlignedHeader_t *pHeader, size_t nNewSize, size_t nAlign )
+{
+	ptr_t pMem = ( ptr_t )( pHeader + 1 );
+	ptr_t pNew = Ball_AllocAlignIn( nNewSize, nAlign, pHeader->nFlags, pHeader->pBudget );
+
+	BALL_ASSERT_IF_MESSAGE( !pNew, "Failed to allocate new memory during reallocation" )
+	{
+		return BALL_NULL;
+	}
+
+	const size_t nToCopy = ( pHeader->nSize < nNewSize ) ? pHeader->nSize : nNewSize;
+
+	if ( nToCopy )
+		Ball_MemCopy( pNew, pMem, nToCopy );
+
+	BALL_MEMSTAT_ADD( nReallocCopy, 1 );
+	BALL_MEMSTAT_ADD( nReallocCopyBytes, nToCopy );
+
+	Ball_FreeAlign( pMem );
+
+	return pNew;
 }
 
 ///-----------------------------------------------------------------------------
@@ -148,8 +1264,17 @@ void Ball_FreeAlign( ptr_t pMem )
 /// @note
 ///   * Fast path: try mremap( MREMAP_MAYMOVE ) to resize the *whole* VMA while
 ///     preserving the user pointer offset (delta) from the VMA base.
-///   * Fallback: allocate a new aligned block, memcpy( min( old, new ) ), free old.
-///   * On shrink, mremap may return the same base; on grow it may move.
+///   * Fallback: allocate a new aligned block, Ball_MemCopy( min( old, new ) )
+///     (streamed and threaded when large, see Ball_MemCopyTune), free old.
+///   * On shrink, whole trailing pages are unmapped once the slack passes the
+///     BALL_MEMSHRINK_* thresholds; on grow mremap may move the mapping.
+///   * BALL_ALLOC_HUGEPAGE blocks keep a 2 MiB aligned base: they grow in place
+///     or move into a 2 MiB aligned reservation (MREMAP_FIXED). hugetlb-backed
+///     and not yet aligned (small) blocks go through the fallback instead.
+///   * Ball_ReserveAlign blocks never move: growth commits more of the reserved
+///     range (see Ball_CommitReserved), and BALL_NULL is returned past its end.
+///   * Ball_AllocBatch blocks grow in place up to the next block, then move.
+///   * BALL_ALLOC_PADDED blocks stay BALL_ALLOC_PADDING bytes longer than asked.
 ///-----------------------------------------------------------------------------
 ptr_t Ball_ReallocAlign( ptr_t pMem, size_t nNewSize, size_t nAlign )
 {
@@ -175,6 +1300,14 @@ ptr_t Ball_ReallocAlign( ptr_t pMem, size_t nNewSize, size_t nAlign )
 		return BALL_NULL;
 	}
 
+	BALL_MEMSTAT_ADD( nReallocCalls, 1 );
+
+	// Padded blocks keep their padding through every resize.
+	nNewSize = Ball_PadSize( nNewSize, pHeader->nFlags );
+
+	if ( !nNewSize )
+		return BALL_NULL;
+
 	const uintptr_t pOldBase = ( uintptr_t )pHeader->pRaw;     // Base address of the current mapping (VMA)
 	const uintptr_t pUserPtr = ( uintptr_t )pMem;              // User-visible pointer
 	const size_t    nOldLen  = pHeader->nMapLength;            // Current mapping size in bytes
@@ -198,11 +1331,22 @@ ptr_t Ball_ReallocAlign( ptr_t pMem, size_t nNewSize, size_t nAlign )
 			// Simply update the logical size and return the same pointer.
 			pHeader->nSize = nNewSize;
 
-			// Physical map length remains unchanged.
+			BALL_MEMSTAT_ADD( nReallocInPlace, 1 );
+
+			// Physical map length remains unchanged unless enough pages fell free.
+			Ball_ReleaseSlack( pHeader, pNeedEnd );
+
 			return ( ptr_t )pUserPtr;
 		}
 	}
 
+	if ( pHeader->nReserveLength )
+		return Ball_CommitReserved( pHeader, nNewSize );
+
+	// A batch block cannot leave its slot without moving.
+	if ( pHeader->nFlags & BALL_ALLOC_BATCH_ )
+		return Ball_ReallocCopy( pHeader, nNewSize, nAlign );
+
 	//-----------------------------------------------------------------------------
 	// Attempt to resize the entire mapping in-place using mremap().
 	// If expansion fails, mremap() may return BALL_MAP_FAILED.
@@ -210,13 +1354,50 @@ ptr_t Ball_ReallocAlign( ptr_t pMem, size_t nNewSize, size_t nAlign )
 	const size_t    nPage        = Ball_PageSize();
 	const uintptr_t pDelta       = pUserPtr - pOldBase; // Offset of the user pointer within the mapping.
 
-	// Compute the new desired mapping range [pKeepStart .. pKeepEnd),
-	// aligned to full pages, that covers both header and user data.
-	const uintptr_t pKeepStart   = BALL_ROUND_DOWN( pHeaderStart, nPage );
+	// Compute the new desired mapping range [pOldBase .. pKeepEnd), aligned to
+	// full pages, that covers both header and user data (the base is kept, so a
+	// huge page mapping with data past its first page keeps that offset too).
 	const uintptr_t pKeepEnd     = BALL_ROUND_UP( pUserPtr + ( uintptr_t )nNewSize, nPage );
-	const size_t    nNewLength   = ( size_t )( pKeepEnd - pKeepStart );
+	const size_t    nNewLength   = ( size_t )( pKeepEnd - pOldBase );
+	const uint32_t  nFlags       = pHeader->nFlags;
+	struct Ball_MemBudget_t *pBudget = pHeader->pBudget;
+
+	// Growth is charged up front; a hard limit fails the realloc, keeping the block.
+	if ( nNewLength > nOldLen && !Ball_MemBudgetCharge( pBudget, nNewLength - nOldLen ) )
+		return BALL_NULL;
+
+	void *pNewBase = BALL_MAP_FAILED;
+
+	if ( !( nFlags & BALL_ALLOC_HUGEPAGE ) )
+	{
+		pNewBase = Ball_SysRemap( ( void * )pOldBase, nOldLen, nNewLength, BALL_MREMAP_MAYMOVE, BALL_NULL );
+	}
+	else if ( !( nFlags & BALL_ALLOC_HUGETLB_ ) && !( pOldBase & ( BALL_HUGEPAGE_SIZE - 1 ) ) )
+	{
+		pNewBase = Ball_SysRemap( ( void * )pOldBase, nOldLen, nNewLength, 0, BALL_NULL );
+
+		if ( pNewBase == BALL_MAP_FAILED )
+		{
+			// Reserve an aligned destination; MREMAP_FIXED replaces the reservation.
+			ptr_t pTarget = Ball_MapAligned( nNewLength, BALL_HUGEPAGE_SIZE, BALL_PROT_NONE, BALL_MAP_NORESERVE );
+
+			if ( pTarget )
+			{
+				pNewBase = Ball_SysRemap( ( void * )pOldBase, nOldLen, nNewLength, BALL_MREMAP_MAYMOVE | BALL_MREMAP_FIXED, pTarget );
+
+				if ( pNewBase == BALL_MAP_FAILED )
+					Ball_SysUnmap( pTarget, nNewLength );
+			}
+		}
 
-	void *pNewBase = mremap( ( void * )pOldBase, nOldLen, nNewLength, BALL_MREMAP_MAYMOVE );
+		if ( pNewBase != BALL_MAP_FAILED )
+			( void )madvise( pNewBase, nNewLength, BALL_MADV_HUGEPAGE );
+	}
+	else if ( !( nFlags & BALL_ALLOC_HUGETLB_ ) && nNewSize < BALL_HUGEPAGE_SIZE - ( pUserPtr - pHeaderStart ) )
+	{
+		// Still below the huge page threshold.
+		pNewBase = Ball_SysRemap( ( void * )pOldBase, nOldLen, nNewLength, BALL_MREMAP_MAYMOVE, BALL_NULL );
+	}
 
 	if ( pNewBase != BALL_MAP_FAILED )
 	{
@@ -228,28 +1409,26 @@ ptr_t Ball_ReallocAlign( ptr_t pMem, size_t nNewSize, size_t nAlign )
 		pNewHeader->nSize       = nNewSize;
 		pNewHeader->nMapLength  = nNewLength;
 		pNewHeader->nMagic      = BALL_MAGIC;
+		pNewHeader->nFlags      = nFlags;
+		pNewHeader->pBudget     = pBudget;
+		pNewHeader->nReserveLength = 0;
 
-		return pNewUser;
-	}
-
-	//-----------------------------------------------------------------------------
-	// Fallback: allocate a new aligned block, copy the data, and free the old one.
-	//-----------------------------------------------------------------------------
-	ptr_t pNew = Ball_AllocAlign( nNewSize, nAlign );
+		BALL_MEMSTAT_ADD( nReallocRemap, 1 );
+		Ball_MemStatMapped( nNewLength, nOldLen );
 
-	BALL_ASSERT_IF_MESSAGE( !pNew, "Failed to allocate new memory during reallocation" )
-	{
-		return BALL_NULL;
-	}
+		if ( nNewLength < nOldLen )
+			Ball_MemBudgetCredit( pBudget, nOldLen - nNewLength );
 
-	const size_t nToCopy = ( pHeader->nSize < nNewSize ) ? pHeader->nSize : nNewSize;
+		if ( ( nFlags & BALL_ALLOC_POPULATE ) && nNewLength > nOldLen )
+			Ball_MemPopulate( ( ptr_t )( pNewBaseU + nOldLen ), nNewLength - nOldLen );
 
-	if ( nToCopy )
-		__builtin_memcpy( pNew, pMem, nToCopy );
+		return pNewUser;
+	}
 
-	Ball_FreeAlign( pMem );
+	if ( nNewLength > nOldLen )
+		Ball_MemBudgetCredit( pBudget, nNewLength - nOldLen );
 
-	return pNew;
+	return Ball_ReallocCopy( pHeader, nNewSize, nAlign );
 }
 
 ///-----------------------------------------------------------------------------
@@ -265,3 +1444,19 @@ size_t Ball_MemSize( ptr_t pMem, size_t nAlign, size_t nOffset )
 
 	return pHeader ? pHeader->nSize : 0u;
 }
+
+///-----------------------------------------------------------------------------
+/// @brief  Return the bytes usable at a user pointer: up to the end of its
+///         (committed) mapping, or of its slot for Ball_AllocBatch blocks.
+/// @note   At least Ball_MemSize; the rest is page (or huge page) round-up.
+///         Alignment/offset parameters are ignored, as in Ball_MemSize.
+///-----------------------------------------------------------------------------
+size_t Ball_MemUsableSize( ptr_t pMem, size_t nAlign, size_t nOffset )
+{
+	( void )nAlign;
+	( void )nOffset;
+
+	struct Ball_AlignedHeader_t *pHeader = Ball_HeaderFromUser( pMem );
+
+	return pHeader ? ( size_t )( ( uintptr_t )pHeader->pRaw + pHeader->nMapLength - ( uintptr_t )pMem ) : 0u;
+}
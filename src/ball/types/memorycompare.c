@@ -0,0 +1,141 @@
+#include <ball/types/base/arch.h>
+#include <ball/types/base/fixed.h>
+#include <ball/types/memorycompare.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#	define BALL_MEMCOMPARE_X86 1
+#endif
+
+#define BALL_MEMCOMPARE_KERNELS 4
+
+typedef uint64_t Ball_MemCmpWord_t __attribute__(( aligned( 1 ), may_alias ));
+
+typedef size_t ( *Ball_MemMismatchFn_t )( const uchar_t *pLeft, const uchar_t *pRight, size_t nSize );
+
+///-----------------------------------------------------------------------------
+/// @brief BALL_MEMCOPY_SYSTEM (and the narrowest vector case): 8-byte words,
+///        then bytes within the first differing word. Endian-neutral.
+///-----------------------------------------------------------------------------
+static size_t Ball_MemMismatchWord( const uchar_t *pLeft, const uchar_t *pRight, size_t nSize )
+{
+	size_t n = 0;
+
+	while ( n + 8 <= nSize && *( const Ball_MemCmpWord_t * )( pLeft + n ) == *( const Ball_MemCmpWord_t * )( pRight + n ) )
+		n += 8;
+
+	while ( n < nSize && pLeft[ n ] == pRight[ n ] )
+		n++;
+
+	return n;
+}
+
+#ifdef BALL_MEMCOMPARE_X86
+typedef char Ball_MemCmpVec_SSE2_t __attribute__(( vector_size( 16 ), aligned( 1 ), may_alias ));
+typedef char Ball_MemCmpVec_AVX2_t __attribute__(( vector_size( 32 ), aligned( 1 ), may_alias ));
+typedef char Ball_MemCmpVec_AVX512_t __attribute__(( vector_size( 64 ), aligned( 1 ), may_alias ));
+
+typedef char Ball_MemCmpMask_SSE2_t __attribute__(( vector_size( 16 ) ));
+typedef char Ball_MemCmpMask_AVX2_t __attribute__(( vector_size( 32 ) ));
+typedef char Ball_MemCmpMask_AVX512_t __attribute__(( vector_size( 64 ) ));
+
+// Bit n set when byte n of the two vectors differs.
+__attribute__(( target( "sse2" ) )) static inline uint64_t Ball_MemDiff_SSE2( Ball_MemCmpVec_SSE2_t vLeft, Ball_MemCmpVec_SSE2_t vRight )
+{
+	return ~( uint64_t )( uint32_t )__builtin_ia32_pmovmskb128( ( Ball_MemCmpMask_SSE2_t )( vLeft == vRight ) ) & 0xFFFFu;
+}
+
+__attribute__(( target( "avx2" ) )) static inline uint64_t Ball_MemDiff_AVX2( Ball_MemCmpVec_AVX2_t vLeft, Ball_MemCmpVec_AVX2_t vRight )
+{
+	return ~( uint64_t )( uint32_t )__builtin_ia32_pmovmskb256( ( Ball_MemCmpMask_AVX2_t )( vLeft == vRight ) ) & 0xFFFFFFFFu;
+}
+
+__attribute__(( target( "avx512bw" ) )) static inline uint64_t Ball_MemDiff_AVX512( Ball_MemCmpVec_AVX512_t vLeft, Ball_MemCmpVec_AVX512_t vRight )
+{
+	return __builtin_ia32_ucmpb512_mask( ( Ball_MemCmpMask_AVX512_t )vLeft, ( Ball_MemCmpMask_AVX512_t )vRight, 4, ~( uint64_t )0u );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Define Ball_MemMismatch_##name over @p width byte vectors compiled for
+///        @p target, handing runs below one vector to @p narrower.
+/// @note  The main loop ORs the XOR of four vector pairs and tests once; the
+///        last partial vector is re-read overlapping the previous one (whose
+///        bytes are known equal) instead of byte by byte.
+///-----------------------------------------------------------------------------
+#	define BALL_MEMCOMPARE_DEFINE( name, width, target, narrower ) \
+	target static size_t Ball_MemMismatch_##name( const uchar_t *pLeft, const uchar_t *pRight, size_t nSize ) \
+	{ \
+		typedef Ball_MemCmpVec_##name##_t Vec_t; \
+		\
+		if ( nSize < ( width ) ) \
+			return narrower( pLeft, pRight, nSize ); \
+		\
+		const Vec_t vZero = { 0 }; \
+		size_t n = 0; \
+		\
+		for ( ; n + 4 * ( width ) <= nSize; n += 4 * ( width ) ) \
+		{ \
+			const Vec_t vAny = ( *( const Vec_t * )( pLeft + n ) ^ *( const Vec_t * )( pRight + n ) ) | \
+			                   ( *( const Vec_t * )( pLeft + n + ( width ) ) ^ *( const Vec_t * )( pRight + n + ( width ) ) ) | \
+			                   ( *( const Vec_t * )( pLeft + n + 2 * ( width ) ) ^ *( const Vec_t * )( pRight + n + 2 * ( width ) ) ) | \
+			                   ( *( const Vec_t * )( pLeft + n + 3 * ( width ) ) ^ *( const Vec_t * )( pRight + n + 3 * ( width ) ) ); \
+			\
+			if ( Ball_MemDiff_##name( vAny, vZero ) ) \
+				break; \
+		} \
+		\
+		for ( ; n + ( width ) <= nSize; n += ( width ) ) \
+		{ \
+			const uint64_t nDiff = Ball_MemDiff_##name( *( const Vec_t * )( pLeft + n ), *( const Vec_t * )( pRight + n ) ); \
+			\
+			if ( nDiff ) \
+				return n + ( size_t )__builtin_ctzll( nDiff ); \
+		} \
+		\
+		if ( n == nSize ) \
+			return nSize; \
+		\
+		n = nSize - ( width ); \
+		\
+		const uint64_t nDiff = Ball_MemDiff_##name( *( const Vec_t * )( pLeft + n ), *( const Vec_t * )( pRight + n ) ); \
+		\
+		return nDiff ? n + ( size_t )__builtin_ctzll( nDiff ) : nSize; \
+	}
+
+BALL_MEMCOMPARE_DEFINE( SSE2, 16, __attribute__(( target( "sse2" ) )), Ball_MemMismatchWord )
+BALL_MEMCOMPARE_DEFINE( AVX2, 32, __attribute__(( target( "avx2" ) )), Ball_MemMismatch_SSE2 )
+BALL_MEMCOMPARE_DEFINE( AVX512, 64, __attribute__(( target( "avx512bw" ) )), Ball_MemMismatch_AVX2 )
+
+static const Ball_MemMismatchFn_t s_apfnMemMismatch[ BALL_MEMCOMPARE_KERNELS ] =
+{
+	Ball_MemMismatchWord, Ball_MemMismatch_SSE2, Ball_MemMismatch_AVX2, Ball_MemMismatch_AVX512,
+};
+#else // !defined( BALL_MEMCOMPARE_X86 )
+static const Ball_MemMismatchFn_t s_apfnMemMismatch[ BALL_MEMCOMPARE_KERNELS ] = { Ball_MemMismatchWord };
+#endif // defined( BALL_MEMCOMPARE_X86 )
+
+///-----------------------------------------------------------------------------
+/// @brief  Find where two byte ranges start to differ.
+/// @return Index of the first differing byte, or @p nSize when they are equal.
+///-----------------------------------------------------------------------------
+size_t Ball_MemMismatch( const void *pLeft, const void *pRight, size_t nSize )
+{
+	if ( pLeft == pRight )
+		return nSize;
+
+	return s_apfnMemMismatch[ Ball_MemCopyKernel() ]( ( const uchar_t * )pLeft, ( const uchar_t * )pRight, nSize );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  memcmp over the mismatch kernels.
+/// @return -1, 0 or 1 as the first differing byte (unsigned) is lower, absent
+///         or higher in @p pLeft.
+///-----------------------------------------------------------------------------
+int Ball_MemCompare( const void *pLeft, const void *pRight, size_t nSize )
+{
+	const size_t n = Ball_MemMismatch( pLeft, pRight, nSize );
+
+	if ( n == nSize )
+		return 0;
+
+	return ( ( const uchar_t * )pLeft )[ n ] < ( ( const uchar_t * )pRight )[ n ] ? -1 : 1;
+}
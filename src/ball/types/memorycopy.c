@@ -0,0 +1,538 @@
+#include <ball/types/base/arch.h>
+#include <ball/types/base/fixed.h>
+#include <ball/types/c/atomic.h>
+#include <ball/types/c/mmap.h>
+#include <ball/types/c/thread.h>
+#include <ball/types/memorycopy.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#	define BALL_MEMCOPY_X86 1
+#endif
+
+#define BALL_MEMCOPY_KERNELS  4
+#define BALL_MEMCOPY_UNSET    0xFFFFFFFFu
+#define BALL_MEMCOPY_UNROLL   4 // Vectors per main loop iteration.
+#define BALL_MEMCOPY_CLOSED   0xFFFFFFFFu // Claim index while a job is being set up.
+#define BALL_MEMCOPY_ALIGN    ( ( size_t )4096u ) // Granularity of the shares of a large copy.
+
+typedef void ( *Ball_MemCopyFn_t )( uchar_t *pDest, const uchar_t *pSrc, size_t nSize );
+
+///-----------------------------------------------------------------------------
+/// @brief BALL_MEMCOPY_SYSTEM: the C library memmove, either direction.
+///-----------------------------------------------------------------------------
+static void Ball_MemCopySystem( uchar_t *pDest, const uchar_t *pSrc, size_t nSize )
+{
+	__builtin_memmove( pDest, pSrc, nSize );
+}
+
+#ifdef BALL_MEMCOPY_X86
+typedef uint32_t Ball_MemWord32_t __attribute__(( aligned( 1 ), may_alias ));
+
+///-----------------------------------------------------------------------------
+/// @brief Copies below 8 bytes, either direction: everything is loaded before
+///        anything is stored, so any overlap is fine.
+///-----------------------------------------------------------------------------
+static void Ball_MemCopyTiny( uchar_t *pDest, const uchar_t *pSrc, size_t nSize )
+{
+	if ( nSize >= 4 )
+	{
+		const uint32_t nHead = *( const Ball_MemWord32_t * )pSrc;
+		const uint32_t nTail = *( const Ball_MemWord32_t * )( pSrc + nSize - 4 );
+
+		*( Ball_MemWord32_t * )pDest = nHead;
+		*( Ball_MemWord32_t * )( pDest + nSize - 4 ) = nTail;
+	}
+	else if ( nSize )
+	{
+		const uchar_t nFirst = pSrc[ 0 ];
+		const uchar_t nMiddle = pSrc[ nSize / 2 ];
+		const uchar_t nLast = pSrc[ nSize - 1 ];
+
+		pDest[ 0 ] = nFirst;
+		pDest[ nSize / 2 ] = nMiddle;
+		pDest[ nSize - 1 ] = nLast;
+	}
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Define Ball_MemCopyForward_##name and Ball_MemCopyBackward_##name
+///        over @p width byte vectors (GCC vector extensions, compiled for
+///        @p target), handing copies below one vector to @p narrower.
+/// @note
+///   * Forward is overlap-safe when pDest <= pSrc, backward when pDest >= pSrc.
+///   * The first and last vector are loaded up front and stored last; the
+///     loop in between stores to aligned addresses, walking away from the
+///     overlap, so it never reads bytes it has already overwritten.
+///   * Copies of one to two vectors are a head and a tail that may overlap.
+///-----------------------------------------------------------------------------
+#define BALL_MEMCOPY_DEFINE( name, width, target, narrower ) \
+	typedef uchar_t Ball_MemVec_##name##_t __attribute__(( vector_size( width ), aligned( 1 ), may_alias )); \
+	typedef uchar_t Ball_MemVecAligned_##name##_t __attribute__(( vector_size( width ), may_alias )); \
+	\
+	target static void Ball_MemCopyForward_##name( uchar_t *pDest, const uchar_t *pSrc, size_t nSize ) \
+	{ \
+		typedef Ball_MemVec_##name##_t Vec_t; \
+		typedef Ball_MemVecAligned_##name##_t VecAligned_t; \
+		\
+		if ( nSize < ( width ) ) \
+		{ \
+			narrower( pDest, pSrc, nSize ); \
+			return; \
+		} \
+		\
+		const Vec_t vHead = *( const Vec_t * )pSrc; \
+		const Vec_t vTail = *( const Vec_t * )( pSrc + nSize - ( width ) ); \
+		\
+		if ( nSize > 2 * ( width ) ) \
+		{ \
+			const size_t nEnd = nSize - ( width ); \
+			size_t n = ( width ) - ( ( uintptr_t )pDest & ( ( width ) - 1 ) ); \
+			\
+			for ( ; n + BALL_MEMCOPY_UNROLL * ( width ) <= nEnd; n += BALL_MEMCOPY_UNROLL * ( width ) ) \
+			{ \
+				const Vec_t v0 = *( const Vec_t * )( pSrc + n ); \
+				const Vec_t v1 = *( const Vec_t * )( pSrc + n + ( width ) ); \
+				const Vec_t v2 = *( const Vec_t * )( pSrc + n + 2 * ( width ) ); \
+				const Vec_t v3 = *( const Vec_t * )( pSrc + n + 3 * ( width ) ); \
+				\
+				*( VecAligned_t * )( pDest + n ) = v0; \
+				*( VecAligned_t * )( pDest + n + ( width ) ) = v1; \
+				*( VecAligned_t * )( pDest + n + 2 * ( width ) ) = v2; \
+				*( VecAligned_t * )( pDest + n + 3 * ( width ) ) = v3; \
+			} \
+			\
+			for ( ; n < nEnd; n += ( width ) ) \
+				*( VecAligned_t * )( pDest + n ) = *( const Vec_t * )( pSrc + n ); \
+		} \
+		\
+		*( Vec_t * )pDest = vHead; \
+		*( Vec_t * )( pDest + nSize - ( width ) ) = vTail; \
+	} \
+	\
+	target static void Ball_MemCopyBackward_##name( uchar_t *pDest, const uchar_t *pSrc, size_t nSize ) \
+	{ \
+		typedef Ball_MemVec_##name##_t Vec_t; \
+		typedef Ball_MemVecAligned_##name##_t VecAligned_t; \
+		\
+		if ( nSize < ( width ) ) \
+		{ \
+			narrower( pDest, pSrc, nSize ); \
+			return; \
+		} \
+		\
+		const Vec_t vHead = *( const Vec_t * )pSrc; \
+		const Vec_t vTail = *( const Vec_t * )( pSrc + nSize - ( width ) ); \
+		\
+		if ( nSize > 2 * ( width ) ) \
+		{ \
+			const size_t nMisaligned = ( ( uintptr_t )pDest + nSize ) & ( ( width ) - 1 ); \
+			size_t n = nSize - ( nMisaligned ? nMisaligned : ( width ) ); \
+			\
+			for ( ; n >= ( BALL_MEMCOPY_UNROLL + 1 ) * ( width ); n -= BALL_MEMCOPY_UNROLL * ( width ) ) \
+			{ \
+				const Vec_t v0 = *( const Vec_t * )( pSrc + n - ( width ) ); \
+				const Vec_t v1 = *( const Vec_t * )( pSrc + n - 2 * ( width ) ); \
+				const Vec_t v2 = *( const Vec_t * )( pSrc + n - 3 * ( width ) ); \
+				const Vec_t v3 = *( const Vec_t * )( pSrc + n - 4 * ( width ) ); \
+				\
+				*( VecAligned_t * )( pDest + n - ( width ) ) = v0; \
+				*( VecAligned_t * )( pDest + n - 2 * ( width ) ) = v1; \
+				*( VecAligned_t * )( pDest + n - 3 * ( width ) ) = v2; \
+				*( VecAligned_t * )( pDest + n - 4 * ( width ) ) = v3; \
+			} \
+			\
+			for ( ; n > ( width ); n -= ( width ) ) \
+				*( VecAligned_t * )( pDest + n - ( width ) ) = *( const Vec_t * )( pSrc + n - ( width ) ); \
+		} \
+		\
+		*( Vec_t * )( pDest + nSize - ( width ) ) = vTail; \
+		*( Vec_t * )pDest = vHead; \
+	}
+
+// Only the forward copy of the word kernel is used (as the narrowest one).
+BALL_MEMCOPY_DEFINE( Word, 8, __attribute__(( unused )), Ball_MemCopyTiny )
+BALL_MEMCOPY_DEFINE( SSE2, 16, __attribute__(( target( "sse2" ) )), Ball_MemCopyForward_Word )
+BALL_MEMCOPY_DEFINE( AVX2, 32, __attribute__(( target( "avx2" ) )), Ball_MemCopyForward_SSE2 )
+BALL_MEMCOPY_DEFINE( AVX512, 64, __attribute__(( target( "avx512f" ) )), Ball_MemCopyForward_AVX2 )
+
+///-----------------------------------------------------------------------------
+/// @brief Define Ball_MemCopyStream_##name: a forward copy of disjoint ranges
+///        whose aligned body goes through non-temporal @p store (movntdq), so
+///        the destination does not evict the cache. Ends with an sfence, as
+///        streaming stores are weakly ordered.
+///-----------------------------------------------------------------------------
+#define BALL_MEMCOPY_DEFINE_STREAM( name, width, target, store ) \
+	typedef long long Ball_MemVecStream_##name##_t __attribute__(( vector_size( width ) )); \
+	\
+	target static void Ball_MemCopyStream_##name( uchar_t *pDest, const uchar_t *pSrc, size_t nSize ) \
+	{ \
+		typedef Ball_MemVec_##name##_t Vec_t; \
+		typedef Ball_MemVecStream_##name##_t VecStream_t; \
+		\
+		const size_t nHead = ( 0u - ( uintptr_t )pDest ) & ( ( width ) - 1 ); \
+		\
+		if ( nSize < nHead + BALL_MEMCOPY_UNROLL * ( width ) ) \
+		{ \
+			Ball_MemCopyForward_##name( pDest, pSrc, nSize ); \
+			return; \
+		} \
+		\
+		Ball_MemCopyForward_##name( pDest, pSrc, nHead ); \
+		\
+		size_t n = nHead; \
+		\
+		for ( ; n + BALL_MEMCOPY_UNROLL * ( width ) <= nSize; n += BALL_MEMCOPY_UNROLL * ( width ) ) \
+		{ \
+			const Vec_t v0 = *( const Vec_t * )( pSrc + n ); \
+			const Vec_t v1 = *( const Vec_t * )( pSrc + n + ( width ) ); \
+			const Vec_t v2 = *( const Vec_t * )( pSrc + n + 2 * ( width ) ); \
+			const Vec_t v3 = *( const Vec_t * )( pSrc + n + 3 * ( width ) ); \
+			\
+			store( ( VecStream_t * )( pDest + n ), ( VecStream_t )v0 ); \
+			store( ( VecStream_t * )( pDest + n + ( width ) ), ( VecStream_t )v1 ); \
+			store( ( VecStream_t * )( pDest + n + 2 * ( width ) ), ( VecStream_t )v2 ); \
+			store( ( VecStream_t * )( pDest + n + 3 * ( width ) ), ( VecStream_t )v3 ); \
+		} \
+		\
+		Ball_MemCopyForward_##name( pDest + n, pSrc + n, nSize - n ); \
+		__builtin_ia32_sfence(); \
+	}
+
+BALL_MEMCOPY_DEFINE_STREAM( SSE2, 16, __attribute__(( target( "sse2" ) )), __builtin_ia32_movntdq )
+BALL_MEMCOPY_DEFINE_STREAM( AVX2, 32, __attribute__(( target( "avx2" ) )), __builtin_ia32_movntdq256 )
+BALL_MEMCOPY_DEFINE_STREAM( AVX512, 64, __attribute__(( target( "avx512f" ) )), __builtin_ia32_movntdq512 )
+
+static const Ball_MemCopyFn_t s_apfnMemCopyForward[ BALL_MEMCOPY_KERNELS ] =
+{
+	Ball_MemCopySystem, Ball_MemCopyForward_SSE2, Ball_MemCopyForward_AVX2, Ball_MemCopyForward_AVX512,
+};
+
+static const Ball_MemCopyFn_t s_apfnMemCopyBackward[ BALL_MEMCOPY_KERNELS ] =
+{
+	Ball_MemCopySystem, Ball_MemCopyBackward_SSE2, Ball_MemCopyBackward_AVX2, Ball_MemCopyBackward_AVX512,
+};
+
+static const Ball_MemCopyFn_t s_apfnMemCopyStream[ BALL_MEMCOPY_KERNELS ] =
+{
+	Ball_MemCopySystem, Ball_MemCopyStream_SSE2, Ball_MemCopyStream_AVX2, Ball_MemCopyStream_AVX512,
+};
+#else // !defined( BALL_MEMCOPY_X86 )
+static const Ball_MemCopyFn_t s_apfnMemCopyForward[ BALL_MEMCOPY_KERNELS ] = { Ball_MemCopySystem };
+static const Ball_MemCopyFn_t s_apfnMemCopyBackward[ BALL_MEMCOPY_KERNELS ] = { Ball_MemCopySystem };
+static const Ball_MemCopyFn_t s_apfnMemCopyStream[ BALL_MEMCOPY_KERNELS ] = { Ball_MemCopySystem };
+#endif // defined( BALL_MEMCOPY_X86 )
+
+static struct
+{
+	uint32_t nSupported;    ///< Widest kernel set the CPU supports (BALL_MEMCOPY_UNSET until probed).
+	uint32_t nKernel;       ///< Kernel set in use.
+	uint32_t nThreads;      ///< Threads per large copy (0 until Ball_MemCopyTuning picks the default).
+	size_t   nLargeSize;    ///< Disjoint copies from this size go to Ball_MemCopyLarge.
+} s_MemCopy = { BALL_MEMCOPY_UNSET, BALL_MEMCOPY_UNSET, 0, BALL_MEMCOPY_LARGE_SIZE };
+
+///-----------------------------------------------------------------------------
+/// @brief Worker pool of large copies. A job is cut into nChunks shares that
+///        the caller and the workers claim one at a time.
+/// @note
+///   * nClaim packs the job generation (high half) and the next share (low
+///     half). The job is set up under a BALL_MEMCOPY_CLOSED claim and opened
+///     with a release store, and a share is only taken by a CAS on the exact
+///     word the job was read under, so stale workers never copy with another
+///     job's pointers.
+///   * Workers sleep on the nWake futex between jobs. One job runs at a time;
+///     a large copy finding the pool busy streams on its own thread.
+///-----------------------------------------------------------------------------
+static struct
+{
+	Ball_SpinLock_t nLock;          ///< Held by the copy running the job.
+	uint32_t        nWorkers;       ///< Worker threads started (they never exit).
+	uint32_t        nWake;          ///< Bumped for every job (futex word).
+	uint32_t        nDone;          ///< Shares of the current job copied.
+	uint64_t        nClaim;         ///< Generation << 32 | next share.
+	uint32_t        nChunks;        ///< Shares of the current job.
+	uint32_t        nKernel;        ///< Stream kernel of the current job.
+	size_t          nChunkSize;
+	size_t          nSize;
+	uchar_t        *pDest;
+	const uchar_t  *pSrc;
+} s_MemCopyPool;
+
+///-----------------------------------------------------------------------------
+/// @brief Widest kernel set usable here. __builtin_cpu_supports also checks
+///        that the OS saves the wider registers (XCR0).
+///-----------------------------------------------------------------------------
+static uint32_t Ball_MemCopySupported( void )
+{
+	uint32_t nSupported = BALL_ATOMIC_LOAD( &s_MemCopy.nSupported, BALL_ATOMIC_RELAXED );
+
+	if ( nSupported != BALL_MEMCOPY_UNSET )
+		return nSupported;
+
+	nSupported = BALL_MEMCOPY_SYSTEM;
+
+#ifdef BALL_MEMCOPY_X86
+	__builtin_cpu_init();
+
+	// The comparison kernels (memorycompare.c) need byte compares on 512-bit vectors.
+	if ( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512bw" ) )
+		nSupported = BALL_MEMCOPY_AVX512;
+	else if ( __builtin_cpu_supports( "avx2" ) )
+		nSupported = BALL_MEMCOPY_AVX2;
+	else if ( __builtin_cpu_supports( "sse2" ) )
+		nSupported = BALL_MEMCOPY_SSE2;
+#endif // defined( BALL_MEMCOPY_X86 )
+
+	BALL_ATOMIC_STORE( &s_MemCopy.nSupported, nSupported, BALL_ATOMIC_RELAXED );
+
+	return nSupported;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Kernel set used by Ball_MemMove: the widest supported one unless
+///         Ball_MemCopySetKernel picked another.
+///-----------------------------------------------------------------------------
+uint32_t Ball_MemCopyKernel( void )
+{
+	const uint32_t nKernel = BALL_ATOMIC_LOAD( &s_MemCopy.nKernel, BALL_ATOMIC_RELAXED );
+
+	return nKernel != BALL_MEMCOPY_UNSET ? nKernel : Ball_MemCopySupported();
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Use kernel set @p nKernel (BALL_MEMCOPY_*) from now on, process-wide;
+///         capped to the widest supported one. For benchmarks and tests.
+/// @return The kernel set now in use.
+///-----------------------------------------------------------------------------
+uint32_t Ball_MemCopySetKernel( uint32_t nKernel )
+{
+	const uint32_t nSupported = Ball_MemCopySupported();
+
+	if ( nKernel > nSupported )
+		nKernel = nSupported;
+
+	BALL_ATOMIC_STORE( &s_MemCopy.nKernel, nKernel, BALL_ATOMIC_RELAXED );
+
+	return nKernel;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Set the large copy engine up: disjoint copies of @p nLargeSize bytes
+///         or more stream past the cache, split across up to @p nThreads
+///         threads (the caller included, at least BALL_MEMCOPY_THREAD_SIZE
+///         each). ~0 disables the engine, 1 thread keeps it single-threaded.
+///-----------------------------------------------------------------------------
+void Ball_MemCopyTune( size_t nLargeSize, uint32_t nThreads )
+{
+	if ( nThreads < 1 )
+		nThreads = 1;
+	else if ( nThreads > BALL_MEMCOPY_MAX_THREADS )
+		nThreads = BALL_MEMCOPY_MAX_THREADS;
+
+	BALL_ATOMIC_STORE( &s_MemCopy.nLargeSize, nLargeSize, BALL_ATOMIC_RELAXED );
+	BALL_ATOMIC_STORE( &s_MemCopy.nThreads, nThreads, BALL_ATOMIC_RELAXED );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Current Ball_MemCopyTune settings. Until tuned, BALL_MEMCOPY_LARGE_SIZE
+///        and BALL_MEMCOPY_THREADS capped to the online CPUs.
+///-----------------------------------------------------------------------------
+void Ball_MemCopyTuning( size_t *pLargeSize, uint32_t *pThreads )
+{
+	uint32_t nThreads = BALL_ATOMIC_LOAD( &s_MemCopy.nThreads, BALL_ATOMIC_RELAXED );
+
+	if ( !nThreads )
+	{
+		const long nCPUs = sysconf( BALL_SC_NPROCESSORS_ONLN );
+
+		nThreads = ( nCPUs > 0 && ( unsigned long )nCPUs < BALL_MEMCOPY_THREADS ) ? ( uint32_t )nCPUs : BALL_MEMCOPY_THREADS;
+
+		BALL_ATOMIC_STORE( &s_MemCopy.nThreads, nThreads, BALL_ATOMIC_RELAXED );
+	}
+
+	*pLargeSize = BALL_ATOMIC_LOAD( &s_MemCopy.nLargeSize, BALL_ATOMIC_RELAXED );
+	*pThreads = nThreads;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Claim and copy shares of the current job until none is left.
+///-----------------------------------------------------------------------------
+static void Ball_MemCopyPoolWork( void )
+{
+	uint64_t nClaim = BALL_ATOMIC_LOAD( &s_MemCopyPool.nClaim, BALL_ATOMIC_ACQUIRE );
+
+	for ( ; ; )
+	{
+		const uint32_t nChunk = ( uint32_t )nClaim;
+
+		if ( nChunk >= BALL_ATOMIC_LOAD( &s_MemCopyPool.nChunks, BALL_ATOMIC_RELAXED ) )
+			return;
+
+		const size_t nChunkSize = BALL_ATOMIC_LOAD( &s_MemCopyPool.nChunkSize, BALL_ATOMIC_RELAXED );
+		const size_t nSize = BALL_ATOMIC_LOAD( &s_MemCopyPool.nSize, BALL_ATOMIC_RELAXED );
+		const uint32_t nKernel = BALL_ATOMIC_LOAD( &s_MemCopyPool.nKernel, BALL_ATOMIC_RELAXED );
+		uchar_t *pDest = BALL_ATOMIC_LOAD( &s_MemCopyPool.pDest, BALL_ATOMIC_RELAXED );
+		const uchar_t *pSrc = BALL_ATOMIC_LOAD( &s_MemCopyPool.pSrc, BALL_ATOMIC_RELAXED );
+
+		// The job fields above belong to nClaim only if the claim still reads nClaim.
+		__atomic_thread_fence( BALL_ATOMIC_ACQUIRE );
+
+		if ( !BALL_ATOMIC_CAS( &s_MemCopyPool.nClaim, &nClaim, nClaim + 1, BALL_ATOMIC_ACQ_REL ) )
+		{
+			nClaim = BALL_ATOMIC_LOAD( &s_MemCopyPool.nClaim, BALL_ATOMIC_ACQUIRE );
+
+			continue;
+		}
+
+		const size_t nOffset = ( size_t )nChunk * nChunkSize;
+
+		s_apfnMemCopyStream[ nKernel ]( pDest + nOffset, pSrc + nOffset, ( nSize - nOffset < nChunkSize ) ? nSize - nOffset : nChunkSize );
+
+		BALL_ATOMIC_ADD( &s_MemCopyPool.nDone, 1, BALL_ATOMIC_RELEASE );
+
+		nClaim++;
+	}
+}
+
+#ifdef BALL_SYS_FUTEX
+static void *Ball_MemCopyWorker( void *pArgument )
+{
+	( void )pArgument;
+
+	for ( ; ; )
+	{
+		const uint32_t nWake = BALL_ATOMIC_LOAD( &s_MemCopyPool.nWake, BALL_ATOMIC_ACQUIRE );
+
+		Ball_MemCopyPoolWork();
+
+		// Returns at once if a job was posted since nWake was read.
+		( void )syscall( BALL_SYS_FUTEX, &s_MemCopyPool.nWake, BALL_FUTEX_WAIT_PRIVATE, nWake, BALL_NULL, BALL_NULL, 0 );
+	}
+
+	return BALL_NULL;
+}
+#endif // defined( BALL_SYS_FUTEX )
+
+///-----------------------------------------------------------------------------
+/// @brief Copy @p nSize bytes with streaming stores, split into @p nChunks
+///        shares over the pool (the calling thread takes shares too).
+///-----------------------------------------------------------------------------
+static void Ball_MemCopyLarge( uchar_t *pDest, const uchar_t *pSrc, size_t nSize, uint32_t nKernel, uint32_t nChunks )
+{
+#ifdef BALL_SYS_FUTEX
+	if ( nChunks < 2 || !Ball_SpinTryLock( &s_MemCopyPool.nLock ) )
+#endif // defined( BALL_SYS_FUTEX )
+	{
+		s_apfnMemCopyStream[ nKernel ]( pDest, pSrc, nSize );
+
+		return;
+	}
+
+#ifdef BALL_SYS_FUTEX
+	while ( s_MemCopyPool.nWorkers + 1 < nChunks )
+	{
+		Ball_Thread_t nThread;
+
+		if ( pthread_create( &nThread, BALL_NULL, Ball_MemCopyWorker, BALL_NULL ) != 0 )
+			break;
+
+		s_MemCopyPool.nWorkers++;
+	}
+
+	const uint64_t nGeneration = ( BALL_ATOMIC_LOAD( &s_MemCopyPool.nClaim, BALL_ATOMIC_RELAXED ) >> 32 ) + 1;
+	const size_t nChunkSize = ( ( nSize / nChunks ) + BALL_MEMCOPY_ALIGN - 1 ) & ~( BALL_MEMCOPY_ALIGN - 1 );
+
+	BALL_ATOMIC_STORE( &s_MemCopyPool.nClaim, nGeneration << 32 | BALL_MEMCOPY_CLOSED, BALL_ATOMIC_RELAXED );
+	__atomic_thread_fence( BALL_ATOMIC_RELEASE );
+
+	BALL_ATOMIC_STORE( &s_MemCopyPool.nChunks, ( uint32_t )( ( nSize + nChunkSize - 1 ) / nChunkSize ), BALL_ATOMIC_RELAXED );
+	BALL_ATOMIC_STORE( &s_MemCopyPool.nChunkSize, nChunkSize, BALL_ATOMIC_RELAXED );
+	BALL_ATOMIC_STORE( &s_MemCopyPool.nSize, nSize, BALL_ATOMIC_RELAXED );
+	BALL_ATOMIC_STORE( &s_MemCopyPool.nKernel, nKernel, BALL_ATOMIC_RELAXED );
+	BALL_ATOMIC_STORE( &s_MemCopyPool.pDest, pDest, BALL_ATOMIC_RELAXED );
+	BALL_ATOMIC_STORE( &s_MemCopyPool.pSrc, pSrc, BALL_ATOMIC_RELAXED );
+	BALL_ATOMIC_STORE( &s_MemCopyPool.nDone, 0, BALL_ATOMIC_RELAXED );
+
+	BALL_ATOMIC_STORE( &s_MemCopyPool.nClaim, nGeneration << 32, BALL_ATOMIC_RELEASE );
+
+	if ( s_MemCopyPool.nWorkers )
+	{
+		BALL_ATOMIC_ADD( &s_MemCopyPool.nWake, 1, BALL_ATOMIC_RELEASE );
+		( void )syscall( BALL_SYS_FUTEX, &s_MemCopyPool.nWake, BALL_FUTEX_WAKE_PRIVATE, s_MemCopyPool.nWorkers, BALL_NULL, BALL_NULL, 0 );
+	}
+
+	Ball_MemCopyPoolWork();
+
+	// The last shares may still be in flight on workers.
+	for ( int n = 0; BALL_ATOMIC_LOAD( &s_MemCopyPool.nDone, BALL_ATOMIC_ACQUIRE ) != s_MemCopyPool.nChunks; n++ )
+	{
+		if ( n < BALL_SPINLOCK_SPINS )
+		{
+			BALL_CPU_RELAX();
+		}
+		else
+		{
+			( void )sched_yield();
+			n = 0;
+		}
+	}
+
+	Ball_SpinUnlock( &s_MemCopyPool.nLock );
+#endif // defined( BALL_SYS_FUTEX )
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  memcpy (the ranges must not overlap) with the selected kernels;
+///         copies of the Ball_MemCopyTune size and up use the large copy engine.
+/// @return pDest
+///-----------------------------------------------------------------------------
+ptr_t Ball_MemCopy( ptr_t pDest, const void *pSrc, size_t nSize )
+{
+	size_t nLargeSize;
+	uint32_t nThreads;
+
+	Ball_MemCopyTuning( &nLargeSize, &nThreads );
+
+	const uint32_t nKernel = Ball_MemCopyKernel();
+
+	if ( nSize < nLargeSize )
+	{
+		s_apfnMemCopyForward[ nKernel ]( ( uchar_t * )pDest, ( const uchar_t * )pSrc, nSize );
+
+		return pDest;
+	}
+
+	size_t nChunks = nSize / BALL_MEMCOPY_THREAD_SIZE;
+
+	if ( nChunks > nThreads )
+		nChunks = nThreads;
+
+	Ball_MemCopyLarge( ( uchar_t * )pDest, ( const uchar_t * )pSrc, nSize, nKernel, ( uint32_t )nChunks );
+
+	return pDest;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  memmove with the selected vector kernels; disjoint ranges go
+///         through Ball_MemCopy.
+/// @return pDest
+///-----------------------------------------------------------------------------
+ptr_t Ball_MemMove( ptr_t pDest, const void *pSrc, size_t nSize )
+{
+	uchar_t *pTo = ( uchar_t * )pDest;
+	const uchar_t *pFrom = ( const uchar_t * )pSrc;
+
+	if ( pTo == pFrom || !nSize )
+		return pDest;
+
+	if ( pTo + nSize <= pFrom || pTo >= pFrom + nSize )
+		return Ball_MemCopy( pDest, pSrc, nSize );
+
+	const uint32_t nKernel = Ball_MemCopyKernel();
+
+	if ( pTo < pFrom )
+		s_apfnMemCopyForward[ nKernel ]( pTo, pFrom, nSize );
+	else
+		s_apfnMemCopyBackward[ nKernel ]( pTo, pFrom, nSize );
+
+	return pDest;
+}
@@ -0,0 +1,319 @@
+#include <ball/types/base/arch.h>
+#include <ball/types/base/fixed.h>
+#include <ball/types/memoryfind.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#	define BALL_MEMFIND_X86 1
+#endif
+
+#define BALL_MEMFIND_KERNELS 4
+
+typedef size_t ( *Ball_MemFindFn_t )( const void *pData, size_t nCount, const void *pValue );
+typedef size_t ( *Ball_MemFindAllFn_t )( const void *pData, size_t nCount, const void *pValue, size_t *pIndices, size_t nMaxIndices );
+
+typedef struct
+{
+	Ball_MemFindFn_t pfnFind;
+	Ball_MemFindFn_t pfnRFind;
+	Ball_MemFindFn_t pfnCount;
+	Ball_MemFindAllFn_t pfnFindAll;
+} Ball_MemFindKernels_t;
+
+///-----------------------------------------------------------------------------
+/// @brief BALL_MEMCOPY_SYSTEM: one element per iteration, and the tails of the
+///        vector kernels.
+///-----------------------------------------------------------------------------
+#define BALL_MEMFIND_DEFINE_SCALAR( suffix, type ) \
+	static size_t Ball_MemFind_Scalar_##suffix( const void *pData, size_t nCount, const void *pValue ) \
+	{ \
+		const type *p = ( const type * )pData, value = *( const type * )pValue; \
+		size_t n = 0; \
+		\
+		while ( n < nCount && !( p[ n ] == value ) ) \
+			n++; \
+		\
+		return n; \
+	} \
+	\
+	static size_t Ball_MemRFind_Scalar_##suffix( const void *pData, size_t nCount, const void *pValue ) \
+	{ \
+		const type *p = ( const type * )pData, value = *( const type * )pValue; \
+		\
+		for ( size_t n = nCount; n-- > 0; ) \
+		{ \
+			if ( p[ n ] == value ) \
+				return n; \
+		} \
+		\
+		return nCount; \
+	} \
+	\
+	static size_t Ball_MemCount_Scalar_##suffix( const void *pData, size_t nCount, const void *pValue ) \
+	{ \
+		const type *p = ( const type * )pData, value = *( const type * )pValue; \
+		size_t nFound = 0; \
+		\
+		for ( size_t n = 0; n < nCount; n++ ) \
+			nFound += p[ n ] == value; \
+		\
+		return nFound; \
+	} \
+	\
+	static size_t Ball_MemFindAll_Scalar_##suffix( const void *pData, size_t nCount, const void *pValue, size_t *pIndices, size_t nMaxIndices ) \
+	{ \
+		const type *p = ( const type * )pData, value = *( const type * )pValue; \
+		size_t nFound = 0; \
+		\
+		for ( size_t n = 0; n < nCount && nFound < nMaxIndices; n++ ) \
+		{ \
+			if ( p[ n ] == value ) \
+				pIndices[ nFound++ ] = n; \
+		} \
+		\
+		return nFound; \
+	}
+
+BALL_MEMFIND_DEFINE_SCALAR( UINT8, uint8_t )
+BALL_MEMFIND_DEFINE_SCALAR( UINT16, uint16_t )
+BALL_MEMFIND_DEFINE_SCALAR( UINT32, uint32_t )
+BALL_MEMFIND_DEFINE_SCALAR( UINT64, uint64_t )
+BALL_MEMFIND_DEFINE_SCALAR( FLOAT, float )
+BALL_MEMFIND_DEFINE_SCALAR( DOUBLE, double )
+
+#define BALL_MEMFIND_ROW( isa ) \
+	{ \
+		{ Ball_MemFind_##isa##_UINT8, Ball_MemRFind_##isa##_UINT8, Ball_MemCount_##isa##_UINT8, Ball_MemFindAll_##isa##_UINT8 }, \
+		{ Ball_MemFind_##isa##_UINT16, Ball_MemRFind_##isa##_UINT16, Ball_MemCount_##isa##_UINT16, Ball_MemFindAll_##isa##_UINT16 }, \
+		{ Ball_MemFind_##isa##_UINT32, Ball_MemRFind_##isa##_UINT32, Ball_MemCount_##isa##_UINT32, Ball_MemFindAll_##isa##_UINT32 }, \
+		{ Ball_MemFind_##isa##_UINT64, Ball_MemRFind_##isa##_UINT64, Ball_MemCount_##isa##_UINT64, Ball_MemFindAll_##isa##_UINT64 }, \
+		{ Ball_MemFind_##isa##_FLOAT, Ball_MemRFind_##isa##_FLOAT, Ball_MemCount_##isa##_FLOAT, Ball_MemFindAll_##isa##_FLOAT }, \
+		{ Ball_MemFind_##isa##_DOUBLE, Ball_MemRFind_##isa##_DOUBLE, Ball_MemCount_##isa##_DOUBLE, Ball_MemFindAll_##isa##_DOUBLE }, \
+	}
+
+#ifdef BALL_MEMFIND_X86
+typedef char Ball_MemFindBytes_SSE2_t __attribute__(( vector_size( 16 ) ));
+typedef char Ball_MemFindBytes_AVX2_t __attribute__(( vector_size( 32 ) ));
+typedef char Ball_MemFindBytes_AVX512_t __attribute__(( vector_size( 64 ) ));
+
+// Bit n set when byte n of a lane-wise comparison result is set (every byte of an equal lane).
+__attribute__(( target( "sse2" ) )) static inline uint64_t Ball_MemFindMask_SSE2( Ball_MemFindBytes_SSE2_t vEqual )
+{
+	return ( uint64_t )( uint32_t )__builtin_ia32_pmovmskb128( vEqual ) & 0xFFFFu;
+}
+
+__attribute__(( target( "avx2" ) )) static inline uint64_t Ball_MemFindMask_AVX2( Ball_MemFindBytes_AVX2_t vEqual )
+{
+	return ( uint64_t )( uint32_t )__builtin_ia32_pmovmskb256( vEqual );
+}
+
+__attribute__(( target( "avx512bw" ) )) static inline uint64_t Ball_MemFindMask_AVX512( Ball_MemFindBytes_AVX512_t vEqual )
+{
+	return __builtin_ia32_cvtb2mask512( vEqual );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Define the Find, RFind, Count and FindAll kernels of @p type over
+///        @p width byte vectors compiled for @p target: broadcast the value,
+///        compare lane-wise, reduce to a byte mask (one group of
+///        sizeof( type ) bits per lane).
+/// @note  Find, RFind and FindAll OR four comparisons and test once, so runs
+///        without a match cost one mask per four vectors; Count adds up four
+///        masks per iteration. The last partial vector goes to the scalar loop.
+///-----------------------------------------------------------------------------
+#	define BALL_MEMFIND_DEFINE( isa, width, target, suffix, type ) \
+	target static size_t Ball_MemFind_##isa##_##suffix( const void *pData, size_t nCount, const void *pValue ) \
+	{ \
+		typedef type Vec_t __attribute__(( vector_size( width ), aligned( 1 ), may_alias )); \
+		\
+		static const size_t LANES = ( width ) / sizeof( type ); \
+		\
+		const type *p = ( const type * )pData; \
+		const Vec_t vValue = ( Vec_t ){ 0 } + *( const type * )pValue; \
+		size_t n = 0; \
+		\
+		for ( ; n + 4 * LANES <= nCount; n += 4 * LANES ) \
+		{ \
+			const __typeof__( vValue == vValue ) vAny = ( *( const Vec_t * )( p + n ) == vValue ) | \
+			                                            ( *( const Vec_t * )( p + n + LANES ) == vValue ) | \
+			                                            ( *( const Vec_t * )( p + n + 2 * LANES ) == vValue ) | \
+			                                            ( *( const Vec_t * )( p + n + 3 * LANES ) == vValue ); \
+			\
+			if ( Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )vAny ) ) \
+				break; \
+		} \
+		\
+		for ( ; n + LANES <= nCount; n += LANES ) \
+		{ \
+			const uint64_t nMask = Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )( *( const Vec_t * )( p + n ) == vValue ) ); \
+			\
+			if ( nMask ) \
+				return n + ( size_t )__builtin_ctzll( nMask ) / sizeof( type ); \
+		} \
+		\
+		return n + Ball_MemFind_Scalar_##suffix( p + n, nCount - n, pValue ); \
+	} \
+	\
+	target static size_t Ball_MemRFind_##isa##_##suffix( const void *pData, size_t nCount, const void *pValue ) \
+	{ \
+		typedef type Vec_t __attribute__(( vector_size( width ), aligned( 1 ), may_alias )); \
+		\
+		static const size_t LANES = ( width ) / sizeof( type ); \
+		\
+		const type *p = ( const type * )pData; \
+		const Vec_t vValue = ( Vec_t ){ 0 } + *( const type * )pValue; \
+		size_t n = nCount; \
+		\
+		for ( ; n >= 4 * LANES; n -= 4 * LANES ) \
+		{ \
+			const __typeof__( vValue == vValue ) vAny = ( *( const Vec_t * )( p + n - LANES ) == vValue ) | \
+			                                            ( *( const Vec_t * )( p + n - 2 * LANES ) == vValue ) | \
+			                                            ( *( const Vec_t * )( p + n - 3 * LANES ) == vValue ) | \
+			                                            ( *( const Vec_t * )( p + n - 4 * LANES ) == vValue ); \
+			\
+			if ( Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )vAny ) ) \
+				break; \
+		} \
+		\
+		for ( ; n >= LANES; n -= LANES ) \
+		{ \
+			const uint64_t nMask = Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )( *( const Vec_t * )( p + n - LANES ) == vValue ) ); \
+			\
+			if ( nMask ) \
+				return n - LANES + ( size_t )( 63 - __builtin_clzll( nMask ) ) / sizeof( type ); \
+		} \
+		\
+		const size_t nFound = Ball_MemRFind_Scalar_##suffix( p, n, pValue ); \
+		\
+		return nFound < n ? nFound : nCount; \
+	} \
+	\
+	target static size_t Ball_MemCount_##isa##_##suffix( const void *pData, size_t nCount, const void *pValue ) \
+	{ \
+		typedef type Vec_t __attribute__(( vector_size( width ), aligned( 1 ), may_alias )); \
+		\
+		static const size_t LANES = ( width ) / sizeof( type ); \
+		static const uint64_t FIRST_BITS = ~( uint64_t )0u / ( ( ( uint64_t )1u << sizeof( type ) ) - 1u ); \
+		\
+		const type *p = ( const type * )pData; \
+		const Vec_t vValue = ( Vec_t ){ 0 } + *( const type * )pValue; \
+		size_t n = 0, nFound = 0; \
+		\
+		for ( ; n + 4 * LANES <= nCount; n += 4 * LANES ) \
+		{ \
+			nFound += ( size_t )__builtin_popcountll( Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )( *( const Vec_t * )( p + n ) == vValue ) ) & FIRST_BITS ) + \
+			          ( size_t )__builtin_popcountll( Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )( *( const Vec_t * )( p + n + LANES ) == vValue ) ) & FIRST_BITS ) + \
+			          ( size_t )__builtin_popcountll( Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )( *( const Vec_t * )( p + n + 2 * LANES ) == vValue ) ) & FIRST_BITS ) + \
+			          ( size_t )__builtin_popcountll( Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )( *( const Vec_t * )( p + n + 3 * LANES ) == vValue ) ) & FIRST_BITS ); \
+		} \
+		\
+		for ( ; n + LANES <= nCount; n += LANES ) \
+			nFound += ( size_t )__builtin_popcountll( Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )( *( const Vec_t * )( p + n ) == vValue ) ) & FIRST_BITS ); \
+		\
+		return nFound + Ball_MemCount_Scalar_##suffix( p + n, nCount - n, pValue ); \
+	} \
+	\
+	target static size_t Ball_MemFindAll_##isa##_##suffix( const void *pData, size_t nCount, const void *pValue, size_t *pIndices, size_t nMaxIndices ) \
+	{ \
+		typedef type Vec_t __attribute__(( vector_size( width ), aligned( 1 ), may_alias )); \
+		\
+		static const size_t LANES = ( width ) / sizeof( type ); \
+		static const uint64_t FIRST_BITS = ~( uint64_t )0u / ( ( ( uint64_t )1u << sizeof( type ) ) - 1u ); \
+		\
+		const type *p = ( const type * )pData; \
+		const Vec_t vValue = ( Vec_t ){ 0 } + *( const type * )pValue; \
+		size_t n = 0, nFound = 0; \
+		\
+		while ( n + LANES <= nCount ) \
+		{ \
+			if ( n + 4 * LANES <= nCount ) \
+			{ \
+				const __typeof__( vValue == vValue ) vAny = ( *( const Vec_t * )( p + n ) == vValue ) | \
+				                                            ( *( const Vec_t * )( p + n + LANES ) == vValue ) | \
+				                                            ( *( const Vec_t * )( p + n + 2 * LANES ) == vValue ) | \
+				                                            ( *( const Vec_t * )( p + n + 3 * LANES ) == vValue ); \
+				\
+				if ( !Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )vAny ) ) \
+				{ \
+					n += 4 * LANES; \
+					continue; \
+				} \
+			} \
+			\
+			uint64_t nMask = Ball_MemFindMask_##isa( ( Ball_MemFindBytes_##isa##_t )( *( const Vec_t * )( p + n ) == vValue ) ) & FIRST_BITS; \
+			\
+			for ( ; nMask; nMask &= nMask - 1u ) \
+			{ \
+				if ( nFound == nMaxIndices ) \
+					return nFound; \
+				\
+				pIndices[ nFound++ ] = n + ( size_t )__builtin_ctzll( nMask ) / sizeof( type ); \
+			} \
+			\
+			n += LANES; \
+		} \
+		\
+		const size_t nTail = Ball_MemFindAll_Scalar_##suffix( p + n, nCount - n, pValue, pIndices + nFound, nMaxIndices - nFound ); \
+		\
+		for ( size_t i = nFound; i < nFound + nTail; i++ ) \
+			pIndices[ i ] += n; \
+		\
+		return nFound + nTail; \
+	}
+
+#	define BALL_MEMFIND_DEFINE_ISA( isa, width, target ) \
+	BALL_MEMFIND_DEFINE( isa, width, target, UINT8, uint8_t ) \
+	BALL_MEMFIND_DEFINE( isa, width, target, UINT16, uint16_t ) \
+	BALL_MEMFIND_DEFINE( isa, width, target, UINT32, uint32_t ) \
+	BALL_MEMFIND_DEFINE( isa, width, target, UINT64, uint64_t ) \
+	BALL_MEMFIND_DEFINE( isa, width, target, FLOAT, float ) \
+	BALL_MEMFIND_DEFINE( isa, width, target, DOUBLE, double )
+
+BALL_MEMFIND_DEFINE_ISA( SSE2, 16, __attribute__(( target( "sse2" ) )) )
+BALL_MEMFIND_DEFINE_ISA( AVX2, 32, __attribute__(( target( "avx2,popcnt" ) )) )
+BALL_MEMFIND_DEFINE_ISA( AVX512, 64, __attribute__(( target( "avx512bw,popcnt" ) )) )
+
+static const Ball_MemFindKernels_t s_aMemFind[ BALL_MEMFIND_KERNELS ][ BALL_MEMFIND_TYPES ] =
+{
+	BALL_MEMFIND_ROW( Scalar ), BALL_MEMFIND_ROW( SSE2 ), BALL_MEMFIND_ROW( AVX2 ), BALL_MEMFIND_ROW( AVX512 ),
+};
+#else // !defined( BALL_MEMFIND_X86 )
+static const Ball_MemFindKernels_t s_aMemFind[ BALL_MEMFIND_KERNELS ][ BALL_MEMFIND_TYPES ] = { BALL_MEMFIND_ROW( Scalar ) };
+#endif // defined( BALL_MEMFIND_X86 )
+
+///-----------------------------------------------------------------------------
+/// @brief  Find the first of @p nCount elements (BALL_MEMFIND_* @p nType)
+///         equal to *@p pValue.
+/// @return Its index, or @p nCount when there is none.
+///-----------------------------------------------------------------------------
+size_t Ball_MemFind( const void *pData, size_t nCount, const void *pValue, uint32_t nType )
+{
+	return s_aMemFind[ Ball_MemCopyKernel() ][ nType ].pfnFind( pData, nCount, pValue );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Find the last of @p nCount elements equal to *@p pValue.
+/// @return Its index, or @p nCount when there is none.
+///-----------------------------------------------------------------------------
+size_t Ball_MemRFind( const void *pData, size_t nCount, const void *pValue, uint32_t nType )
+{
+	return s_aMemFind[ Ball_MemCopyKernel() ][ nType ].pfnRFind( pData, nCount, pValue );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Count the elements equal to *@p pValue.
+///-----------------------------------------------------------------------------
+size_t Ball_MemCount( const void *pData, size_t nCount, const void *pValue, uint32_t nType )
+{
+	return s_aMemFind[ Ball_MemCopyKernel() ][ nType ].pfnCount( pData, nCount, pValue );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Store the indices of the elements equal to *@p pValue, in order, in
+///         @p pIndices until @p nMaxIndices are stored.
+/// @return Number of indices stored: below @p nMaxIndices when the search
+///         reached the end, otherwise resume after the last one.
+///-----------------------------------------------------------------------------
+size_t Ball_MemFindAll( const void *pData, size_t nCount, const void *pValue, uint32_t nType, size_t *pIndices, size_t nMaxIndices )
+{
+	return s_aMemFind[ Ball_MemCopyKernel() ][ nType ].pfnFindAll( pData, nCount, pValue, pIndices, nMaxIndices );
+}
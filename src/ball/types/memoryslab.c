@@ -0,0 +1,844 @@
+#include <ball/types/base/arch.h>
+#include <ball/types/base/fixed.h>
+#include <ball/types/c/assert.h>
+#include <ball/types/c/atomic.h>
+#include <ball/types/c/mmap.h>
+#include <ball/types/c/math.h>
+#include <ball/types/c/thread.h>
+#include <ball/types/memoryaligned.h>
+#include <ball/types/memoryslab.h>
+#include <ball/types/memorystats.h>
+
+#define BALL_SLAB_MAGIC 0x534C4142 // "SLAB" (without null-terminated)
+
+#define BALL_SLAB_PAGE_SHIFT  12
+#define BALL_SLAB_PAGE_SIZE   ( ( size_t )1u << BALL_SLAB_PAGE_SHIFT )
+#define BALL_SLAB_CHUNK_SHIFT 22
+#define BALL_SLAB_CHUNK_SIZE  ( ( size_t )1u << BALL_SLAB_CHUNK_SHIFT )
+#define BALL_SLAB_CHUNK_PAGES ( BALL_SLAB_CHUNK_SIZE >> BALL_SLAB_PAGE_SHIFT )
+
+#define BALL_SLAB_NUM_CLASSES BALL_MEMSTATS_SLAB_CLASSES
+#define BALL_SLAB_MIN_BLOCKS  4 // Minimum blocks per run (affects big classes only).
+
+#if defined( _LP64 ) || defined( __LP64__ )
+#	define BALL_SLAB_RESERVE_SIZE ( ( size_t )16u << 30 ) // 16 GiB of address space.
+#else // !( defined( _LP64 ) || defined( __LP64__ ) )
+#	define BALL_SLAB_RESERVE_SIZE ( ( size_t )256u << 20 ) // 256 MiB of address space.
+#endif // defined( _LP64 ) || defined( __LP64__ )
+
+#define BALL_SLAB_CACHE_LINE 64
+
+#define BALL_SLAB_STATE_NONE   0
+#define BALL_SLAB_STATE_INIT   1
+#define BALL_SLAB_STATE_READY  2
+#define BALL_SLAB_STATE_FAILED 3
+
+///-----------------------------------------------------------------------------
+/// @brief Block sizes: powers of two plus one intermediate (x1.5) class between
+///        each pair. Every class is aligned to its lowest set bit (capped to
+///        one slab page), so 48-byte blocks are 16-aligned, 96 -> 32, etc.
+///-----------------------------------------------------------------------------
+static const uint32_t s_aSlabClassSizes[ BALL_SLAB_NUM_CLASSES ] =
+{
+	8, 16,
+	24, 32, 48, 64, 96, 128, 192, 256,
+	384, 512, 768, 1024, 1536, 2048, 3072, 4096,
+	6144, 8192, 12288, 16384, 24576, 32768, 49152, 65536,
+};
+
+struct Ball_SlabHeap_t;
+
+///-----------------------------------------------------------------------------
+/// @brief A run is a page-granular slice of a chunk dedicated to one class.
+/// @note  Blocks are carved lazily via pBump; returned ones go to pFree.
+///        A run is either central (pOwner is BALL_NULL, guarded by the class
+///        lock) or owned by one thread heap; ownership only changes while the
+///        run is empty, so no free can race with the hand-over.
+///-----------------------------------------------------------------------------
+struct Ball_SlabRun_t
+{
+	ptr_t                  pFree;    ///< Intrusive list of returned blocks.
+	uchar_t               *pBump;    ///< Next never-used block.
+	uchar_t               *pEnd;     ///< End of the last whole block.
+	struct Ball_SlabRun_t *pNext;    ///< Next run in the class partial/empty list or heap bin.
+	struct Ball_SlabRun_t *pPrev;    ///< Previous run in a heap bin (heap bins are doubly linked).
+	struct Ball_SlabHeap_t *pOwner;  ///< Owning thread heap, BALL_NULL for central runs.
+	uint32_t               nUsed;    ///< Blocks currently handed out.
+	uint16_t               nClass;   ///< Index into s_aSlabClassSizes.
+	bool_t                 bListed;  ///< Whether the run sits in a partial list or bin.
+}; // struct Ball_SlabRun_t
+
+///-----------------------------------------------------------------------------
+/// @brief Chunk header placed at the (chunk-aligned) start of each chunk.
+/// @note  Pointer -> run lookup is: chunk = p & ~( CHUNK - 1 ), then
+///        aRuns[ aPageRun[ page of p ] ]. Header pages never host runs.
+///-----------------------------------------------------------------------------
+struct Ball_SlabChunk_t
+{
+	uint32_t              nMagic;                             ///< BALL_SLAB_MAGIC.
+	uint32_t              nNextPage;                          ///< First page not yet given to a run.
+	uint16_t              aPageRun[ BALL_SLAB_CHUNK_PAGES ];  ///< First page of the run owning each page.
+	struct Ball_SlabRun_t aRuns[ BALL_SLAB_CHUNK_PAGES ];     ///< Run descriptors, indexed by first page.
+}; // struct Ball_SlabChunk_t
+
+#define BALL_SLAB_HEADER_PAGES ( ( uint32_t )( ( sizeof( struct Ball_SlabChunk_t ) + BALL_SLAB_PAGE_SIZE - 1 ) >> BALL_SLAB_PAGE_SHIFT ) )
+
+struct Ball_SlabClass_t
+{
+	Ball_SpinLock_t        nLock;
+	struct Ball_SlabRun_t *pPartial; ///< Central runs with at least one free block.
+	struct Ball_SlabRun_t *pEmpty;   ///< Runs flushed back by thread heaps, reusable by anyone.
+}; // struct Ball_SlabClass_t
+
+///-----------------------------------------------------------------------------
+/// @brief Per-thread cache: one bin (list of owned runs with free blocks) per
+///        class, plus a lock-free queue of blocks other threads freed into
+///        runs of this heap.
+/// @note  Heaps are never destroyed. On thread exit the heap is parked in a
+///        recycled list and adopted, runs and pending remote frees included,
+///        by the next thread that needs one.
+///-----------------------------------------------------------------------------
+struct Ball_SlabHeap_t
+{
+	ptr_t                   pRemote;                                      ///< MPSC stack of remotely freed blocks.
+	uchar_t                 aPadding[ BALL_SLAB_CACHE_LINE - sizeof( ptr_t ) ];
+	struct Ball_SlabHeap_t *pNextRecycled;                                ///< Link in the recycled heap list.
+	struct Ball_SlabRun_t  *apBins[ BALL_SLAB_NUM_CLASSES ];              ///< Owned runs with free blocks.
+}; // struct Ball_SlabHeap_t
+
+///-----------------------------------------------------------------------------
+/// @brief Process-wide slab heap.
+/// @note  The whole heap lives in one PROT_NONE reservation, so ownership of a
+///        pointer is a range check, and chunks are committed with mprotect
+///        next to each other (the kernel merges them into a single VMA).
+///-----------------------------------------------------------------------------
+static struct
+{
+	int                      nState;
+	uintptr_t                pBase;       ///< Reservation start (chunk aligned), 0 until ready.
+	uintptr_t                pNext;       ///< First chunk not committed yet.
+	uintptr_t                pEnd;        ///< Reservation end.
+	Ball_SpinLock_t          nLock;       ///< Guards pNext and pChunk.
+	struct Ball_SlabChunk_t *pChunk;      ///< Chunk new runs are carved from.
+	struct Ball_SlabClass_t  aClasses[ BALL_SLAB_NUM_CLASSES ];
+} s_Slab;
+
+///-----------------------------------------------------------------------------
+/// @brief Thread heap bookkeeping.
+///-----------------------------------------------------------------------------
+static struct
+{
+	Ball_SpinLock_t         nLock;      ///< Guards everything below.
+	bool_t                  bKeyReady;  ///< Whether nKey was created.
+	bool_t                  bKeyTried;  ///< Whether creation was attempted.
+	Ball_ThreadKey_t        nKey;       ///< Thread-exit hook that recycles the heap.
+	struct Ball_SlabHeap_t *pRecycled;  ///< Heaps of exited threads.
+} s_SlabHeaps;
+
+static _Thread_local struct Ball_SlabHeap_t *s_pSlabThreadHeap;
+
+///-----------------------------------------------------------------------------
+/// @brief Reserve the slab address range once (thread-safe, lazy).
+/// @return Non-zero when the heap is usable.
+///-----------------------------------------------------------------------------
+static bool_t Ball_SlabInit( void )
+{
+	int nState = BALL_ATOMIC_LOAD( &s_Slab.nState, BALL_ATOMIC_ACQUIRE );
+
+	if ( nState == BALL_SLAB_STATE_READY )
+		return 1;
+
+	if ( nState == BALL_SLAB_STATE_NONE && BALL_ATOMIC_CAS( &s_Slab.nState, &nState, BALL_SLAB_STATE_INIT, BALL_ATOMIC_ACQUIRE ) )
+	{
+		const size_t nMapLength = BALL_SLAB_RESERVE_SIZE + BALL_SLAB_CHUNK_SIZE;
+
+		ptr_t pMap = mmap( BALL_NULL, nMapLength, BALL_PROT_NONE,
+		                   BALL_MAP_PRIVATE | BALL_MAP_ANONYMOUS | BALL_MAP_NORESERVE, -1, 0 );
+
+		if ( pMap == BALL_MAP_FAILED )
+		{
+			BALL_ATOMIC_STORE( &s_Slab.nState, BALL_SLAB_STATE_FAILED, BALL_ATOMIC_RELEASE );
+
+			return 0;
+		}
+
+		// Keep a chunk-aligned window so that chunk headers can be found by masking.
+		const uintptr_t pData  = ( uintptr_t )pMap;
+		const uintptr_t pBase  = BALL_ROUND_UP( pData, BALL_SLAB_CHUNK_SIZE );
+		const uintptr_t pEnd   = pBase + BALL_SLAB_RESERVE_SIZE;
+
+		if ( pBase > pData )
+			( void )munmap( ( void * )pData, ( size_t )( pBase - pData ) );
+
+		if ( pEnd < pData + nMapLength )
+			( void )munmap( ( void * )pEnd, ( size_t )( pData + nMapLength - pEnd ) );
+
+		s_Slab.pNext = pBase;
+		s_Slab.pEnd  = pEnd;
+
+		BALL_ATOMIC_STORE( &s_Slab.pBase, pBase, BALL_ATOMIC_RELEASE );
+		BALL_ATOMIC_STORE( &s_Slab.nState, BALL_SLAB_STATE_READY, BALL_ATOMIC_RELEASE );
+
+		return 1;
+	}
+
+	while ( ( nState = BALL_ATOMIC_LOAD( &s_Slab.nState, BALL_ATOMIC_ACQUIRE ) ) == BALL_SLAB_STATE_INIT )
+		BALL_CPU_RELAX();
+
+	return nState == BALL_SLAB_STATE_READY;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Alignment every block of a class is guaranteed to have.
+///-----------------------------------------------------------------------------
+static inline size_t Ball_SlabClassAlign( uint32_t nClass )
+{
+	const size_t nSize = s_aSlabClassSizes[ nClass ];
+	const size_t nLowBit = nSize & ( ~nSize + 1u );
+
+	return BALL_MIN( nLowBit, BALL_SLAB_PAGE_SIZE );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Smallest class that fits @p nSize bytes aligned to @p nAlign.
+/// @return Class index or BALL_SLAB_NUM_CLASSES when there is none.
+///-----------------------------------------------------------------------------
+static inline uint32_t Ball_SlabClassOf( size_t nSize, size_t nAlign )
+{
+	uint32_t nClass;
+
+	if ( nSize <= 8u )
+	{
+		nClass = 0;
+	}
+	else if ( nSize <= 16u )
+	{
+		nClass = 1;
+	}
+	else
+	{
+		// floor( log2( nSize - 1 ) ) >= 4 here; each power of two adds two classes.
+		const uint32_t nLog = ( uint32_t )( 63 - __builtin_clzll( ( ullong_t )( nSize - 1u ) ) );
+		const size_t   nPow = ( size_t )1u << nLog;
+
+		nClass = 2u + 2u * ( nLog - 4u ) + ( ( nSize > nPow + ( nPow >> 1 ) ) ? 1u : 0u );
+	}
+
+	while ( nClass < BALL_SLAB_NUM_CLASSES && Ball_SlabClassAlign( nClass ) < nAlign )
+		nClass++;
+
+	return nClass;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Page count of a run for blocks of @p nBlockSize bytes.
+/// @note  At least BALL_SLAB_MIN_BLOCKS blocks, tail waste at most 1/8 of the run.
+///-----------------------------------------------------------------------------
+static uint32_t Ball_SlabRunPages( size_t nBlockSize )
+{
+	uint32_t nPages = ( uint32_t )( ( nBlockSize * BALL_SLAB_MIN_BLOCKS + BALL_SLAB_PAGE_SIZE - 1u ) >> BALL_SLAB_PAGE_SHIFT );
+
+	while ( ( ( ( size_t )nPages << BALL_SLAB_PAGE_SHIFT ) % nBlockSize ) > ( ( ( size_t )nPages << BALL_SLAB_PAGE_SHIFT ) >> 3 ) )
+		nPages++;
+
+	return nPages;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Commit the next chunk of the reservation. Caller holds s_Slab.nLock.
+///-----------------------------------------------------------------------------
+static struct Ball_SlabChunk_t *Ball_SlabNewChunk( void )
+{
+	if ( s_Slab.pNext >= s_Slab.pEnd )
+		return BALL_NULL;
+
+	ptr_t pChunkMem = ( ptr_t )s_Slab.pNext;
+
+	if ( mprotect( pChunkMem, BALL_SLAB_CHUNK_SIZE, BALL_PROT_READ | BALL_PROT_WRITE ) != 0 )
+		return BALL_NULL;
+
+	s_Slab.pNext += BALL_SLAB_CHUNK_SIZE;
+
+	struct Ball_SlabChunk_t *pChunk = ( struct Ball_SlabChunk_t * )pChunkMem;
+
+	pChunk->nMagic    = BALL_SLAB_MAGIC;
+	pChunk->nNextPage = BALL_SLAB_HEADER_PAGES;
+
+	return pChunk;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Carve a fresh run for @p nClass.
+///-----------------------------------------------------------------------------
+static struct Ball_SlabRun_t *Ball_SlabNewRun( uint32_t nClass )
+{
+	const size_t   nBlockSize = s_aSlabClassSizes[ nClass ];
+	const uint32_t nPages     = Ball_SlabRunPages( nBlockSize );
+
+	Ball_SpinLock( &s_Slab.nLock );
+
+	struct Ball_SlabChunk_t *pChunk = s_Slab.pChunk;
+
+	// The tail of a chunk too short for this run is left unused.
+	if ( !pChunk || pChunk->nNextPage + nPages > BALL_SLAB_CHUNK_PAGES )
+	{
+		pChunk = Ball_SlabNewChunk();
+
+		if ( !pChunk )
+		{
+			Ball_SpinUnlock( &s_Slab.nLock );
+
+			return BALL_NULL;
+		}
+
+		s_Slab.pChunk = pChunk;
+	}
+
+	const uint32_t iFirst = pChunk->nNextPage;
+
+	pChunk->nNextPage += nPages;
+
+	Ball_SpinUnlock( &s_Slab.nLock );
+
+	// Pages [iFirst, iFirst + nPages) are exclusively ours from here on.
+	for ( uint32_t n = 0; n < nPages; n++ )
+		pChunk->aPageRun[ iFirst + n ] = ( uint16_t )iFirst;
+
+	uchar_t *pStart = ( uchar_t * )pChunk + ( ( size_t )iFirst << BALL_SLAB_PAGE_SHIFT );
+	const size_t nBlocks = ( ( size_t )nPages << BALL_SLAB_PAGE_SHIFT ) / nBlockSize;
+
+	struct Ball_SlabRun_t *pRun = &pChunk->aRuns[ iFirst ];
+
+	pRun->pFree   = BALL_NULL;
+	pRun->pBump   = pStart;
+	pRun->pEnd    = pStart + nBlocks * nBlockSize;
+	pRun->pNext   = BALL_NULL;
+	pRun->pPrev   = BALL_NULL;
+	pRun->pOwner  = BALL_NULL;
+	pRun->nUsed   = 0;
+	pRun->nClass  = ( uint16_t )nClass;
+	pRun->bListed = 0;
+
+	return pRun;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Run descriptor of a block. Precondition: Ball_SlabOwns( pMem ).
+///-----------------------------------------------------------------------------
+static inline struct Ball_SlabRun_t *Ball_SlabRunOf( ptr_t pMem )
+{
+	const uintptr_t pBlock = ( uintptr_t )pMem;
+	struct Ball_SlabChunk_t *pChunk = ( struct Ball_SlabChunk_t * )BALL_ROUND_DOWN( pBlock, BALL_SLAB_CHUNK_SIZE );
+	const size_t iPage = ( size_t )( pBlock - ( uintptr_t )pChunk ) >> BALL_SLAB_PAGE_SHIFT;
+
+	BALL_ASSERT_MESSAGE( pChunk->nMagic == BALL_SLAB_MAGIC, "Slab chunk validation failed" );
+
+	return &pChunk->aRuns[ pChunk->aPageRun[ iPage ] ];
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Take one block out of a run with free space.
+///-----------------------------------------------------------------------------
+static inline ptr_t Ball_SlabRunPop( struct Ball_SlabRun_t *pRun, size_t nBlockSize )
+{
+	ptr_t pBlock;
+
+	if ( pRun->pFree )
+	{
+		pBlock = pRun->pFree;
+		pRun->pFree = *( ptr_t * )pBlock;
+	}
+	else
+	{
+		pBlock = pRun->pBump;
+		pRun->pBump += nBlockSize;
+	}
+
+	pRun->nUsed++;
+
+	return pBlock;
+}
+
+static inline bool_t Ball_SlabRunExhausted( const struct Ball_SlabRun_t *pRun )
+{
+	return !pRun->pFree && pRun->pBump >= pRun->pEnd;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Hand an empty run back to the central pool of its class.
+///-----------------------------------------------------------------------------
+static void Ball_SlabReleaseRun( struct Ball_SlabRun_t *pRun )
+{
+	struct Ball_SlabClass_t *pClass = &s_Slab.aClasses[ pRun->nClass ];
+
+	BALL_ASSERT( !pRun->nUsed );
+
+	pRun->pOwner  = BALL_NULL;
+	pRun->pPrev   = BALL_NULL;
+	pRun->bListed = 0;
+
+	Ball_SpinLock( &pClass->nLock );
+	pRun->pNext    = pClass->pEmpty;
+	pClass->pEmpty = pRun;
+	Ball_SpinUnlock( &pClass->nLock );
+}
+
+static inline void Ball_SlabBinLink( struct Ball_SlabHeap_t *pHeap, struct Ball_SlabRun_t *pRun )
+{
+	struct Ball_SlabRun_t **ppBin = &pHeap->apBins[ pRun->nClass ];
+
+	pRun->pPrev   = BALL_NULL;
+	pRun->pNext   = *ppBin;
+	pRun->bListed = 1;
+
+	if ( *ppBin )
+		( *ppBin )->pPrev = pRun;
+
+	*ppBin = pRun;
+}
+
+static inline void Ball_SlabBinUnlink( struct Ball_SlabHeap_t *pHeap, struct Ball_SlabRun_t *pRun )
+{
+	if ( pRun->pPrev )
+		pRun->pPrev->pNext = pRun->pNext;
+	else
+		pHeap->apBins[ pRun->nClass ] = pRun->pNext;
+
+	if ( pRun->pNext )
+		pRun->pNext->pPrev = pRun->pPrev;
+
+	pRun->pNext   = BALL_NULL;
+	pRun->pPrev   = BALL_NULL;
+	pRun->bListed = 0;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Return a block to a run owned by @p pHeap (owner thread only).
+/// @note  A run that drains completely while another run of the class is in
+///        the bin is flushed to the central pool; the bin head is kept so that
+///        alloc/free ping-pong on one block does not bounce runs.
+///-----------------------------------------------------------------------------
+static void Ball_SlabHeapFree( struct Ball_SlabHeap_t *pHeap, struct Ball_SlabRun_t *pRun, ptr_t pMem )
+{
+	*( ptr_t * )pMem = pRun->pFree;
+	pRun->pFree = pMem;
+	pRun->nUsed--;
+
+	if ( !pRun->bListed )
+	{
+		Ball_SlabBinLink( pHeap, pRun );
+	}
+	else if ( !pRun->nUsed && pRun->pPrev )
+	{
+		Ball_SlabBinUnlink( pHeap, pRun );
+		Ball_SlabReleaseRun( pRun );
+	}
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Move all remotely freed blocks back into their (owned) runs.
+///-----------------------------------------------------------------------------
+static void Ball_SlabHeapCollect( struct Ball_SlabHeap_t *pHeap )
+{
+	ptr_t pBlock = BALL_ATOMIC_EXCHANGE( &pHeap->pRemote, BALL_NULL, BALL_ATOMIC_ACQUIRE );
+
+	while ( pBlock )
+	{
+		ptr_t pNext = *( ptr_t * )pBlock;
+
+		Ball_SlabHeapFree( pHeap, Ball_SlabRunOf( pBlock ), pBlock );
+		pBlock = pNext;
+	}
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Collect remote frees and flush every empty run to the central pool.
+///-----------------------------------------------------------------------------
+static void Ball_SlabHeapFlush( struct Ball_SlabHeap_t *pHeap )
+{
+	Ball_SlabHeapCollect( pHeap );
+
+	for ( uint32_t nClass = 0; nClass < BALL_SLAB_NUM_CLASSES; nClass++ )
+	{
+		struct Ball_SlabRun_t *pRun = pHeap->apBins[ nClass ];
+
+		while ( pRun )
+		{
+			struct Ball_SlabRun_t *pNext = pRun->pNext;
+
+			if ( !pRun->nUsed )
+			{
+				Ball_SlabBinUnlink( pHeap, pRun );
+				Ball_SlabReleaseRun( pRun );
+			}
+
+			pRun = pNext;
+		}
+	}
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Thread-exit hook: flush and park the heap for the next thread.
+///-----------------------------------------------------------------------------
+static void Ball_SlabHeapDetach( void *pArgument )
+{
+	struct Ball_SlabHeap_t *pHeap = ( struct Ball_SlabHeap_t * )pArgument;
+
+	Ball_SlabHeapFlush( pHeap );
+
+	if ( s_pSlabThreadHeap == pHeap )
+		s_pSlabThreadHeap = BALL_NULL;
+
+	Ball_SpinLock( &s_SlabHeaps.nLock );
+	pHeap->pNextRecycled   = s_SlabHeaps.pRecycled;
+	s_SlabHeaps.pRecycled  = pHeap;
+	Ball_SpinUnlock( &s_SlabHeaps.nLock );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Heap of the calling thread, adopting or creating one on first use.
+/// @return Heap or BALL_NULL when none can be set up.
+///-----------------------------------------------------------------------------
+static struct Ball_SlabHeap_t *Ball_SlabThreadHeap( void )
+{
+	struct Ball_SlabHeap_t *pHeap = s_pSlabThreadHeap;
+
+	if ( pHeap )
+		return pHeap;
+
+	if ( !Ball_SlabInit() )
+		return BALL_NULL;
+
+	Ball_SpinLock( &s_SlabHeaps.nLock );
+
+	if ( !s_SlabHeaps.bKeyTried )
+	{
+		s_SlabHeaps.bKeyTried = 1;
+		s_SlabHeaps.bKeyReady = pthread_key_create( &s_SlabHeaps.nKey, Ball_SlabHeapDetach ) == 0;
+	}
+
+	pHeap = s_SlabHeaps.pRecycled;
+
+	if ( pHeap )
+		s_SlabHeaps.pRecycled = pHeap->pNextRecycled;
+
+	Ball_SpinUnlock( &s_SlabHeaps.nLock );
+
+	if ( !pHeap )
+	{
+		pHeap = ( struct Ball_SlabHeap_t * )Ball_SlabAlloc( sizeof( struct Ball_SlabHeap_t ), BALL_SLAB_CACHE_LINE );
+
+		if ( !pHeap )
+			return BALL_NULL;
+
+		__builtin_memset( pHeap, 0, sizeof( struct Ball_SlabHeap_t ) );
+	}
+
+	pHeap->pNextRecycled = BALL_NULL;
+
+	// Without the exit hook the heap simply stays with the (exited) thread.
+	if ( s_SlabHeaps.bKeyReady )
+		( void )pthread_setspecific( s_SlabHeaps.nKey, pHeap );
+
+	s_pSlabThreadHeap = pHeap;
+
+	return pHeap;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Allocate a block of @p nClass from the thread heap.
+/// @note  Miss path: collect remote frees, then refill the bin with a whole run
+///        (a batch of blocks) from the central pool or a fresh one.
+///-----------------------------------------------------------------------------
+static ptr_t Ball_SlabHeapAlloc( struct Ball_SlabHeap_t *pHeap, uint32_t nClass )
+{
+	struct Ball_SlabRun_t *pRun = pHeap->apBins[ nClass ];
+
+	if ( !pRun )
+	{
+		Ball_SlabHeapCollect( pHeap );
+
+		pRun = pHeap->apBins[ nClass ];
+	}
+
+	if ( !pRun )
+	{
+		struct Ball_SlabClass_t *pClass = &s_Slab.aClasses[ nClass ];
+
+		Ball_SpinLock( &pClass->nLock );
+
+		if ( ( pRun = pClass->pEmpty ) != BALL_NULL )
+			pClass->pEmpty = pRun->pNext;
+
+		Ball_SpinUnlock( &pClass->nLock );
+
+		if ( !pRun && !( pRun = Ball_SlabNewRun( nClass ) ) )
+			return BALL_NULL;
+
+		BALL_ATOMIC_STORE( &pRun->pOwner, pHeap, BALL_ATOMIC_RELEASE );
+		Ball_SlabBinLink( pHeap, pRun );
+	}
+
+	ptr_t pBlock = Ball_SlabRunPop( pRun, s_aSlabClassSizes[ nClass ] );
+
+	if ( Ball_SlabRunExhausted( pRun ) )
+		Ball_SlabBinUnlink( pHeap, pRun );
+
+	Ball_MemStatSlab( nClass, 1 );
+
+	return pBlock;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Check whether @p pMem points into the slab heap.
+/// @note   A single range check; safe with any pointer (including BALL_NULL).
+///-----------------------------------------------------------------------------
+bool_t Ball_SlabOwns( ptr_t pMem )
+{
+	const uintptr_t pBase = BALL_ATOMIC_LOAD( &s_Slab.pBase, BALL_ATOMIC_RELAXED );
+
+	return pBase && ( ( uintptr_t )pMem - pBase ) < BALL_SLAB_RESERVE_SIZE;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Allocate a small block from its size class.
+/// @param  nSize  Requested size (bytes), 1..BALL_SLAB_MAX_SIZE.
+/// @param  nAlign Alignment (power of two, >= sizeof( ptr_t ), <= BALL_SLAB_MAX_ALIGN).
+/// @return Block pointer or BALL_NULL if the request is not a small one or the
+///         slab address range is exhausted (caller falls back to Ball_AllocAlign).
+///-----------------------------------------------------------------------------
+ptr_t Ball_SlabAlloc( size_t nSize, size_t nAlign )
+{
+	if ( !nSize || !BALL_SLAB_IS_SMALL( nSize, nAlign ) )
+		return BALL_NULL;
+
+	if ( !BALL_IS_POW2( nAlign ) || nAlign < sizeof( ptr_t ) )
+		return BALL_NULL;
+
+	if ( !Ball_SlabInit() )
+		return BALL_NULL;
+
+	const uint32_t nClass = Ball_SlabClassOf( nSize, nAlign );
+
+	if ( nClass >= BALL_SLAB_NUM_CLASSES )
+		return BALL_NULL;
+
+	const size_t nBlockSize = s_aSlabClassSizes[ nClass ];
+	struct Ball_SlabClass_t *pClass = &s_Slab.aClasses[ nClass ];
+
+	Ball_SpinLock( &pClass->nLock );
+
+	struct Ball_SlabRun_t *pRun = pClass->pPartial;
+
+	if ( !pRun && ( pRun = pClass->pEmpty ) != BALL_NULL )
+	{
+		pClass->pEmpty   = pRun->pNext;
+		pRun->pNext      = BALL_NULL;
+		pRun->bListed    = 1;
+		pClass->pPartial = pRun;
+	}
+
+	if ( !pRun )
+	{
+		pRun = Ball_SlabNewRun( nClass );
+
+		if ( !pRun )
+		{
+			Ball_SpinUnlock( &pClass->nLock );
+
+			return BALL_NULL;
+		}
+
+		pRun->bListed   = 1;
+		pClass->pPartial = pRun;
+	}
+
+	ptr_t pBlock = Ball_SlabRunPop( pRun, nBlockSize );
+
+	// Exhausted runs leave the partial list until a block comes back.
+	if ( Ball_SlabRunExhausted( pRun ) )
+	{
+		pClass->pPartial = pRun->pNext;
+		pRun->pNext      = BALL_NULL;
+		pRun->bListed    = 0;
+	}
+
+	Ball_SpinUnlock( &pClass->nLock );
+
+	Ball_MemStatSlab( nClass, 1 );
+
+	return pBlock;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Return a block to its size class.
+/// @param  pMem Block previously returned by any Ball_Slab* allocation function.
+/// @note   No-op for pointers outside the slab heap. Blocks of thread heaps are
+///         returned locally by the owner thread and queued (lock-free) by others.
+///-----------------------------------------------------------------------------
+void Ball_SlabFree( ptr_t pMem )
+{
+	if ( !Ball_SlabOwns( pMem ) )
+		return;
+
+	struct Ball_SlabRun_t *pRun = Ball_SlabRunOf( pMem );
+	struct Ball_SlabHeap_t *pOwner = BALL_ATOMIC_LOAD( &pRun->pOwner, BALL_ATOMIC_ACQUIRE );
+
+	Ball_MemStatSlab( pRun->nClass, 0 );
+
+	if ( pOwner )
+	{
+		if ( pOwner == s_pSlabThreadHeap )
+		{
+			Ball_SlabHeapFree( pOwner, pRun, pMem );
+
+			return;
+		}
+
+		// Remote free: lock-free push onto the owner's queue.
+		ptr_t pHead = BALL_ATOMIC_LOAD( &pOwner->pRemote, BALL_ATOMIC_RELAXED );
+
+		do
+		{
+			*( ptr_t * )pMem = pHead;
+		}
+		while ( !BALL_ATOMIC_CAS( &pOwner->pRemote, &pHead, pMem, BALL_ATOMIC_RELEASE ) );
+
+		return;
+	}
+
+	struct Ball_SlabClass_t *pClass = &s_Slab.aClasses[ pRun->nClass ];
+
+	Ball_SpinLock( &pClass->nLock );
+
+	*( ptr_t * )pMem = pRun->pFree;
+	pRun->pFree = pMem;
+	pRun->nUsed--;
+
+	if ( !pRun->bListed )
+	{
+		pRun->pNext      = pClass->pPartial;
+		pRun->bListed    = 1;
+		pClass->pPartial = pRun;
+	}
+
+	Ball_SpinUnlock( &pClass->nLock );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief Shared resize logic; @p pfnAlloc picks the small-block source.
+///-----------------------------------------------------------------------------
+static ptr_t Ball_SlabReallocWith( ptr_t pMem, size_t nSize, size_t nAlign, ptr_t ( *pfnAlloc )( size_t, size_t ) )
+{
+	BALL_ASSERT_IF_MESSAGE( !Ball_SlabOwns( pMem ), "Memory validation failed" )
+	{
+		return BALL_NULL;
+	}
+
+	if ( !nSize )
+	{
+		Ball_SlabFree( pMem );
+
+		return BALL_NULL;
+	}
+
+	const size_t nOldSize = s_aSlabClassSizes[ Ball_SlabRunOf( pMem )->nClass ];
+
+	if ( nSize <= nOldSize && nSize > ( nOldSize >> 1 ) && !( ( uintptr_t )pMem & ( nAlign - 1u ) ) )
+		return pMem;
+
+	ptr_t pNew = pfnAlloc( nSize, nAlign );
+
+	if ( !pNew )
+		pNew = Ball_AllocAlign( nSize, nAlign );
+
+	BALL_ASSERT_IF_MESSAGE( !pNew, "Failed to allocate new memory during reallocation" )
+	{
+		return BALL_NULL;
+	}
+
+	__builtin_memcpy( pNew, pMem, BALL_MIN( nOldSize, nSize ) );
+	Ball_SlabFree( pMem );
+
+	return pNew;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Resize a slab block.
+/// @param  pMem   Block owned by the slab heap.
+/// @param  nSize  New size; 0 frees the block.
+/// @param  nAlign Required alignment.
+/// @return Same block when it still fits (and is not shrunk below half of its
+///         class), otherwise a new block - small or mmap-backed - holding a copy.
+///-----------------------------------------------------------------------------
+ptr_t Ball_SlabRealloc( ptr_t pMem, size_t nSize, size_t nAlign )
+{
+	return Ball_SlabReallocWith( pMem, nSize, nAlign, Ball_SlabAlloc );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Usable size of a slab block (its class size), 0 for foreign pointers.
+///-----------------------------------------------------------------------------
+size_t Ball_SlabSize( ptr_t pMem )
+{
+	if ( !Ball_SlabOwns( pMem ) )
+		return 0u;
+
+	return s_aSlabClassSizes[ Ball_SlabRunOf( pMem )->nClass ];
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Block size of slab class @p nClass (see Ball_MemStats_t), 0 past the last.
+///-----------------------------------------------------------------------------
+size_t Ball_SlabClassSize( uint32_t nClass )
+{
+	return nClass < BALL_SLAB_NUM_CLASSES ? s_aSlabClassSizes[ nClass ] : 0u;
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Allocate a small block from the calling thread's cache.
+/// @return Block pointer or BALL_NULL under the same conditions as Ball_SlabAlloc.
+/// @note   No locks on the hit path; the bin is refilled a whole run at a time.
+///         Falls back to the central heap if the thread heap cannot be set up.
+///-----------------------------------------------------------------------------
+ptr_t Ball_SlabCacheAlloc( size_t nSize, size_t nAlign )
+{
+	if ( !nSize || !BALL_SLAB_IS_SMALL( nSize, nAlign ) )
+		return BALL_NULL;
+
+	if ( !BALL_IS_POW2( nAlign ) || nAlign < sizeof( ptr_t ) )
+		return BALL_NULL;
+
+	struct Ball_SlabHeap_t *pHeap = Ball_SlabThreadHeap();
+
+	if ( !pHeap )
+		return Ball_SlabAlloc( nSize, nAlign );
+
+	const uint32_t nClass = Ball_SlabClassOf( nSize, nAlign );
+
+	if ( nClass >= BALL_SLAB_NUM_CLASSES )
+		return BALL_NULL;
+
+	return Ball_SlabHeapAlloc( pHeap, nClass );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Ball_SlabRealloc counterpart that allocates from the thread cache.
+///-----------------------------------------------------------------------------
+ptr_t Ball_SlabCacheRealloc( ptr_t pMem, size_t nSize, size_t nAlign )
+{
+	return Ball_SlabReallocWith( pMem, nSize, nAlign, Ball_SlabCacheAlloc );
+}
+
+///-----------------------------------------------------------------------------
+/// @brief  Collect blocks other threads freed into the calling thread's runs
+///         and return its empty runs to the central heap.
+/// @note   Also done automatically when the thread exits.
+///-----------------------------------------------------------------------------
+void Ball_SlabCacheFlush( void )
+{
+	struct Ball_SlabHeap_t *pHeap = s_pSlabThreadHeap;
+
+	if ( pHeap )
+		Ball_SlabHeapFlush( pHeap );
+}
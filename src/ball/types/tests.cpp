@@ -20,6 +20,8 @@ struct pair_t
 extern "C"
 {
 	int puts( const char *pszTextNoNextLine );
+	int pthread_create( unsigned long *pThread, const void *pAttributes, void *( *pfnStart )( void * ), void *pArgument );
+	int pthread_join( unsigned long nThread, void **ppResult );
 };
 
 template < class V >
@@ -53,9 +55,1839 @@ String_t DumpVector( const V &vec )
 	return sBuffer;
 }
 
+// Returns the number of failed checks.
+int TestSlabAllocator()
+{
+	int nFailed = 0;
+
+	// Small blocks of every alignment come from the slab heap and keep their contents.
+	void *apBlocks[ 64 ];
+
+	for ( size_t n = 0; n < 64; n++ )
+	{
+		const size_t nSize = 1 + n * 97;
+		const size_t nAlign = size_t( 8 ) << ( n % 6 );
+
+		uint8_t *pBlock = reinterpret_cast< uint8_t * >( CAllocatorBase::Alloc( nSize, nAlign ) );
+
+		nFailed += !Ball_SlabOwns( pBlock );
+		nFailed += ( reinterpret_cast< uintptr_t >( pBlock ) & ( nAlign - 1 ) ) != 0;
+		nFailed += CAllocatorBase::Size( pBlock, nAlign ) < nSize;
+
+		for ( size_t i = 0; i < nSize; i++ )
+			pBlock[ i ] = static_cast< uint8_t >( n );
+
+		apBlocks[ n ] = pBlock;
+	}
+
+	for ( size_t n = 0; n < 64; n++ )
+	{
+		const uint8_t *pBlock = reinterpret_cast< const uint8_t * >( apBlocks[ n ] );
+
+		for ( size_t i = 0; i < 1 + n * 97; i++ )
+			nFailed += pBlock[ i ] != static_cast< uint8_t >( n );
+
+		CAllocatorBase::Free( apBlocks[ n ] );
+	}
+
+	// Growth crosses the large-object threshold and keeps the prefix.
+	uint8_t *pGrow = nullptr;
+
+	for ( size_t nSize = 16; nSize <= 4 * BALL_SLAB_MAX_SIZE; nSize *= 2 )
+	{
+		pGrow = reinterpret_cast< uint8_t * >( CAllocatorBase::Realloc( pGrow, nSize, 16 ) );
+		pGrow[ nSize - 1 ] = static_cast< uint8_t >( nSize );
+		nFailed += pGrow[ 15 ] != 16;
+		nFailed += Ball_SlabOwns( pGrow ) != ( nSize <= BALL_SLAB_MAX_SIZE );
+	}
+
+	CAllocatorBase::Free( pGrow );
+
+	// Size() is the usable size on both paths: the class size on the slab heap,
+	// the rest of the mapping for large blocks.
+	void *pSmall = CAllocatorBase::Alloc( 100, 8 );
+	void *pLarge = CAllocatorBase::Alloc( 3 * BALL_SLAB_MAX_SIZE + 100, 64 );
+	const size_t nLarge = CAllocatorBase::Size( pLarge, 64 );
+
+	nFailed += CAllocatorBase::Size( pSmall, 8 ) != Ball_SlabSize( pSmall );
+	nFailed += nLarge < 3 * BALL_SLAB_MAX_SIZE + 100 || ( reinterpret_cast< uintptr_t >( pLarge ) + nLarge ) % Ball_PageSize() != 0;
+
+	static_cast< uint8_t * >( pLarge )[ nLarge - 1 ] = 1;
+	CAllocatorBase::Free( pSmall );
+	CAllocatorBase::Free( pLarge );
+
+	// Freed blocks are recycled by the same class.
+	void *pFirst = CAllocatorBase::Alloc( 40, 8 );
+
+	CAllocatorBase::Free( pFirst );
+	nFailed += CAllocatorBase::Alloc( 40, 8 ) != pFirst;
+	CAllocatorBase::Free( pFirst );
+
+	// Slab blocks are counted per size class (40 bytes take the 48-byte class),
+	// through the central heap and the thread caches alike.
+	const Ball_MemStats_t before = CAllocatorBase::Stats();
+
+	void *apCounted[ 3 ] = { CAllocatorBase::Alloc( 40, 8 ), CThreadCacheAllocatorBase::Alloc( 40, 8 ), CAllocatorBase::Alloc( 40, 8 ) };
+
+	CAllocatorBase::Free( apCounted[ 1 ] );
+
+	const Ball_MemStats_t after = CAllocatorBase::Stats();
+
+	nFailed += after.aSlabAllocs[ 4 ] - before.aSlabAllocs[ 4 ] != 3 || after.aSlabFrees[ 4 ] - before.aSlabFrees[ 4 ] != 1;
+	nFailed += after.aSlabLiveBytes[ 4 ] - before.aSlabLiveBytes[ 4 ] != 2 * 48;
+	nFailed += after.aSlabAllocs[ 3 ] != before.aSlabAllocs[ 3 ] || after.nAllocCalls != before.nAllocCalls;
+
+	CAllocatorBase::Free( apCounted[ 0 ] );
+	CAllocatorBase::Free( apCounted[ 2 ] );
+
+	return nFailed;
+}
+
+static void *FreeBlocksThread( void *pArgument )
+{
+	void **apBlocks = reinterpret_cast< void ** >( pArgument );
+
+	for ( size_t n = 0; n < 256; n++ )
+		CThreadCacheAllocatorBase::Free( apBlocks[ n ] );
+
+	return nullptr;
+}
+
+static void *AllocBlocksThread( void *pArgument )
+{
+	void **apBlocks = reinterpret_cast< void ** >( pArgument );
+
+	for ( size_t n = 0; n < 256; n++ )
+	{
+		apBlocks[ n ] = CThreadCacheAllocatorBase::Alloc( 48, 16 );
+		*reinterpret_cast< size_t * >( apBlocks[ n ] ) = n;
+	}
+
+	return nullptr;
+}
+
+// Returns the number of failed checks.
+int TestThreadCacheAllocator()
+{
+	int nFailed = 0;
+
+	// Local free/alloc pairs are served from the thread bin.
+	void *pFirst = CThreadCacheAllocatorBase::Alloc( 40, 8 );
+
+	nFailed += !Ball_SlabOwns( pFirst );
+	CThreadCacheAllocatorBase::Free( pFirst );
+	nFailed += CThreadCacheAllocatorBase::Alloc( 40, 8 ) != pFirst;
+	CThreadCacheAllocatorBase::Free( pFirst );
+
+	// Blocks freed by another thread come back to the owner after a flush.
+	void *apBlocks[ 256 ];
+	unsigned long nThread;
+
+	for ( size_t n = 0; n < 256; n++ )
+		apBlocks[ n ] = CThreadCacheAllocatorBase::Alloc( 48, 16 );
+
+	nFailed += pthread_create( &nThread, nullptr, FreeBlocksThread, apBlocks ) != 0 || pthread_join( nThread, nullptr ) != 0;
+
+	CThreadCacheAllocatorBase::Flush();
+
+	for ( size_t n = 0; n < 256; n++ )
+	{
+		apBlocks[ n ] = CThreadCacheAllocatorBase::Alloc( 48, 16 );
+		nFailed += !Ball_SlabOwns( apBlocks[ n ] );
+	}
+
+	for ( size_t n = 0; n < 256; n++ )
+		CThreadCacheAllocatorBase::Free( apBlocks[ n ] );
+
+	// Blocks of an exited thread stay valid and can be freed here.
+	nFailed += pthread_create( &nThread, nullptr, AllocBlocksThread, apBlocks ) != 0 || pthread_join( nThread, nullptr ) != 0;
+
+	for ( size_t n = 0; n < 256; n++ )
+	{
+		nFailed += *reinterpret_cast< size_t * >( apBlocks[ n ] ) != n;
+		CThreadCacheAllocatorBase::Free( apBlocks[ n ] );
+	}
+
+	// Containers take it as their allocator.
+	CVector< size_t, size_t, CThreadCacheAllocator< size_t, size_t > > vec;
+	CString< size_t, char_t, CThreadCacheAllocator< size_t, char_t > > str;
+
+	for ( size_t n = 0; n < 1000; n++ )
+	{
+		vec.AddToTail( n );
+		str.Append( "x" );
+	}
+
+	nFailed += vec.Count() != 1000 || static_cast< const decltype( vec ) & >( vec )[ 999 ] != 999;
+	nFailed += str.Length() != 1000;
+
+	// Flags apply as with CAllocatorBase: padding survives leaving the slab.
+	void *pPadded = CThreadCacheAllocatorBase::Alloc( 24, 8, BALL_ALLOC_PADDED );
+
+	nFailed += !Ball_SlabOwns( pPadded ) || CThreadCacheAllocatorBase::Size( pPadded, 8 ) < 24 + BALL_ALLOC_PADDING;
+
+	pPadded = CThreadCacheAllocatorBase::Realloc( pPadded, 2 * BALL_SLAB_MAX_SIZE, 8, BALL_ALLOC_PADDED );
+	nFailed += Ball_SlabOwns( pPadded ) || Ball_MemSize( pPadded, 8, 0 ) != 2 * BALL_SLAB_MAX_SIZE + BALL_ALLOC_PADDING;
+	CThreadCacheAllocatorBase::Free( pPadded );
+
+	using PaddedAllocator_t = CThreadCacheAllocator< size_t, uint64_t, BALL_ALLOC_PADDED >;
+
+	static_assert( CVector< size_t, uint64_t, PaddedAllocator_t >::IS_PADDED );
+
+	CVector< size_t, uint64_t, PaddedAllocator_t > batch[ 2 ];
+	const size_t aCounts[ 2 ] = { 10, 20 };
+
+	nFailed += !CVector< size_t, uint64_t, PaddedAllocator_t >::ReserveMany( batch, aCounts, 2 );
+	nFailed += batch[ 1 ].Capacity() != 20 || batch[ 1 ].Data() == nullptr;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestArenaAllocator()
+{
+	int nFailed = 0;
+
+	alignas( 64 ) uchar_t aBuffer[ 4096 ];
+	CArena arena( aBuffer );
+
+	for ( size_t nRound = 0; nRound < 3; nRound++ )
+	{
+		{
+			CArenaScope scope( arena );
+
+			// The first block of every round starts in the caller buffer again.
+			CString< size_t, char_t, CArenaAllocator< size_t, char_t > > str;
+
+			str.Append( "arena" );
+			nFailed += str.Base() < reinterpret_cast< const char_t * >( aBuffer ) || str.Base() >= reinterpret_cast< const char_t * >( aBuffer + sizeof( aBuffer ) );
+
+			// Growth spills into heap chunks and keeps the contents.
+			CVector< size_t, size_t, CArenaAllocator< size_t, size_t > > vec;
+
+			for ( size_t n = 0; n < 10000; n++ )
+				vec.AddToTail( n );
+
+			const auto &cvec = vec;
+
+			for ( size_t n = 0; n < 10000; n++ )
+				nFailed += cvec[ n ] != n;
+
+			nFailed += str.Length() != 5;
+		}
+
+		arena.Reset();
+	}
+
+	// Without a bound arena the blocks come from the regular heap.
+	CVector< size_t, size_t, CArenaAllocator< size_t, size_t > > vec;
+
+	for ( size_t n = 0; n < 1000; n++ )
+		vec.AddToTail( n );
+
+	nFailed += CArena::HeaderOf( vec.Base() )->pArena != nullptr;
+	nFailed += vec.Count() != 1000;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestHugePageAllocator()
+{
+	int nFailed = 0;
+
+	// The mapping is 2 MiB aligned; user data follows the header at the first 64-byte boundary.
+	uint8_t *pBlock = reinterpret_cast< uint8_t * >( Ball_AllocAlignEx( 8 * BALL_HUGEPAGE_SIZE, 64, BALL_ALLOC_HUGEPAGE ) );
+
+	nFailed += !pBlock;
+	nFailed += ( reinterpret_cast< uintptr_t >( pBlock ) & ( BALL_HUGEPAGE_SIZE - 1 ) ) != 64;
+
+	for ( size_t n = 0; n < 8 * BALL_HUGEPAGE_SIZE; n += 4096 )
+		pBlock[ n ] = static_cast< uint8_t >( n >> 12 );
+
+	// Growth keeps both the contents and the aligned base.
+	pBlock = reinterpret_cast< uint8_t * >( Ball_ReallocAlign( pBlock, 32 * BALL_HUGEPAGE_SIZE, 64 ) );
+
+	nFailed += !pBlock;
+	nFailed += ( reinterpret_cast< uintptr_t >( pBlock ) & ( BALL_HUGEPAGE_SIZE - 1 ) ) != 64;
+
+	for ( size_t n = 0; n < 8 * BALL_HUGEPAGE_SIZE; n += 4096 )
+		nFailed += pBlock[ n ] != static_cast< uint8_t >( n >> 12 );
+
+	Ball_FreeAlign( pBlock );
+
+	// A vector crossing the threshold moves onto a huge page mapping.
+	HugePageVector_t< pair_t > vec;
+
+	for ( size_t n = 0; n < BALL_HUGEPAGE_SIZE / sizeof( pair_t ) * 2; n++ )
+		vec.AddToTail( pair_t{ n, n } );
+
+	nFailed += ( reinterpret_cast< uintptr_t >( vec.Base() ) & ( BALL_HUGEPAGE_SIZE - 1 ) ) >= 4096;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestMemStats()
+{
+	int nFailed = 0;
+
+	const Ball_MemStats_t before = CAllocatorBase::Stats();
+
+	ptr_t pBlock = Ball_AllocAlign( 1 << 20, 64 );
+
+	pBlock = Ball_ReallocAlign( pBlock, ( 1 << 20 ) + 1, 64 );   // Fits the page-rounded mapping.
+	pBlock = Ball_ReallocAlign( pBlock, 16 << 20, 64 );          // Needs mremap.
+
+	const Ball_MemStats_t live = CAllocatorBase::Stats();
+
+	Ball_FreeAlign( pBlock );
+
+	const Ball_MemStats_t after = CAllocatorBase::Stats();
+
+	nFailed += live.nAllocCalls - before.nAllocCalls != 1;
+	nFailed += live.aSizeHistogram[ 20 ] - before.aSizeHistogram[ 20 ] != 1;
+	nFailed += live.nReallocCalls - before.nReallocCalls != 2;
+	nFailed += live.nReallocInPlace - before.nReallocInPlace != 1;
+	nFailed += live.nReallocRemap + live.nReallocCopy - before.nReallocRemap - before.nReallocCopy != 1;
+	nFailed += live.nMappedBytes < before.nMappedBytes + ( 16 << 20 );
+	nFailed += live.nPeakMappedBytes < live.nMappedBytes;
+	nFailed += after.nFreeCalls - before.nFreeCalls != 1;
+	nFailed += after.nMappedBytes != before.nMappedBytes;
+
+	// A freed mapping is retained and handed out again for the same size.
+	ptr_t pFirst = Ball_AllocAlign( 256 << 10, 64 );
+
+	Ball_FreeAlign( pFirst );
+
+	const Ball_MemStats_t cached = CAllocatorBase::Stats();
+	ptr_t pSecond = Ball_AllocAlign( 256 << 10, 64 );
+
+	nFailed += pSecond != pFirst;
+	nFailed += CAllocatorBase::Stats().nCacheHits - cached.nCacheHits != 1;
+	nFailed += CAllocatorBase::Stats().nMapCalls != cached.nMapCalls;
+
+	Ball_FreeAlign( pSecond );
+
+	nFailed += CAllocatorBase::Trim() == 0;
+	nFailed += CAllocatorBase::Stats().nCachedBytes != 0;
+
+	// Compacting a vector that briefly held a lot returns the pages to the OS.
+	{
+		Vector_t< pair_t > vec;
+
+		for ( size_t n = 0; n < ( 1 << 20 ); n++ )
+			vec.AddToTail( pair_t{ n, n } );
+
+		const Ball_MemStats_t full = CAllocatorBase::Stats();
+
+		vec.Remove( 1000, vec.Count() - 1000 );
+		vec.Compact();
+
+		const Ball_MemStats_t compact = CAllocatorBase::Stats();
+
+		nFailed += compact.nShrinkCalls - full.nShrinkCalls != 1;
+		nFailed += compact.nMappedBytes + ( 15 << 20 ) > full.nMappedBytes;
+		nFailed += static_cast< const decltype( vec ) & >( vec )[ 999 ] != pair_t{ 999, 999 };
+
+		vec.Purge();
+		nFailed += vec.Capacity() != 0 || vec.Data() != nullptr;
+		nFailed += CAllocatorBase::Stats().nMappedBytes != before.nMappedBytes;
+	}
+
+	CAllocatorBase::Trim();
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestPopulate()
+{
+	int nFailed = 0;
+
+	// Policy: every mapping of the vector is faulted in up front.
+	{
+		const Ball_MemStats_t before = CAllocatorBase::Stats();
+
+		PopulatedVector_t< pair_t > vec;
+
+		for ( size_t n = 0; n < ( 1 << 17 ); n++ )
+			vec.AddToTail( pair_t{ n, n } );
+
+		nFailed += CAllocatorBase::Stats().nPopulateBytes - before.nPopulateBytes < ( 1 << 17 ) * sizeof( pair_t );
+		nFailed += static_cast< const decltype( vec ) & >( vec )[ 12'345 ] != pair_t{ 12'345, 12'345 };
+	}
+
+	// Per call: only the spare capacity is touched and the contents survive.
+	{
+		Vector_t< pair_t > vec;
+
+		for ( size_t n = 0; n < 10; n++ )
+			vec.AddToTail( pair_t{ n, n } );
+
+		const Ball_MemStats_t before = CAllocatorBase::Stats();
+
+		vec.Reserve( 100'000, true );
+
+		nFailed += CAllocatorBase::Stats().nPopulateBytes - before.nPopulateBytes < ( 100'000 - 10 ) * sizeof( pair_t );
+		nFailed += vec.Capacity() < 100'000 || vec.Count() != 10;
+		nFailed += static_cast< const decltype( vec ) & >( vec )[ 9 ] != pair_t{ 9, 9 };
+	}
+
+	return nFailed;
+}
+
+static void CountPressure( Ball_MemBudget_t *, void *pContext )
+{
+	( *static_cast< int * >( pContext ) )++;
+}
+
+// Returns the number of failed checks.
+int TestMemoryBudget()
+{
+	int nFailed = 0;
+	int nPressure = 0;
+
+	CMemoryBudget process( "process" );
+	CMemoryBudget cache( "cache", 1 << 20, 4 << 20, &process );
+	CMemoryBudget::Hook_t hook { CountPressure, &nPressure, nullptr };
+
+	cache.AddHook( hook );
+
+	ptr_t pFirst, pSecond, pDenied;
+
+	{
+		CMemoryBudgetScope scope( cache );
+
+		pFirst = Ball_AllocAlign( 512 << 10, 64 );
+		nFailed += cache.Used() < ( 512 << 10 ) || nPressure != 0;
+
+		// Crossing the soft limit succeeds and notifies once.
+		pSecond = Ball_AllocAlign( 768 << 10, 64 );
+		nFailed += !pSecond || nPressure != 1;
+
+		// The hard limit refuses.
+		pDenied = Ball_AllocAlign( 4 << 20, 64 );
+		nFailed += pDenied != nullptr || cache.Denied() != 1;
+	}
+
+	nFailed += process.Used() != cache.Used();
+
+	// Blocks stay charged to their budget outside the scope, also when growing.
+	pSecond = Ball_ReallocAlign( pSecond, 2 << 20, 64 );
+	nFailed += cache.Used() < ( 512 << 10 ) + ( 2 << 20 );
+
+	Ball_FreeAlign( pFirst );
+	Ball_FreeAlign( pSecond );
+
+	nFailed += cache.Used() != 0 || process.Used() != 0;
+	nFailed += cache.Peak() < ( 512 << 10 ) + ( 2 << 20 );
+	nFailed += process.Denied() != 0;
+
+	return nFailed;
+}
+
+// Counts calls into the allocator on top of CAllocator.
+template < typename I, typename T >
+class CCountingAllocator : public CAllocator< I, T >
+{
+public:
+	using Base_t = CAllocator< I, T >;
+
+	static inline size_t s_nCalls = 0;
+
+	static T *Alloc( I nCount, size_t nAligned ) { s_nCalls++; return Base_t::Alloc( nCount, nAligned ); }
+	static T *Realloc( T *pMem, I nCount, size_t nAligned ) { s_nCalls++; return Base_t::Realloc( pMem, nCount, nAligned ); }
+};
+
+// Returns the number of failed checks.
+int TestVectorCapacity()
+{
+	using Allocator_t = CCountingAllocator< size_t, pair_t >;
+
+	int nFailed = 0;
+
+	// A run of appends costs O(log n) allocator calls.
+	CVector< size_t, pair_t, Allocator_t > vec;
+
+	for ( size_t n = 0; n < 50'000; n++ )
+		vec.AddToTail( pair_t{ n, n } );
+
+	nFailed += Allocator_t::s_nCalls > 20;
+	nFailed += vec.Capacity() < vec.Count();
+
+	// Reserved room is used without further calls.
+	const size_t nCalls = Allocator_t::s_nCalls;
+
+	vec.Reserve( 100'000 );
+	nFailed += vec.Capacity() < 100'000;
+
+	for ( size_t n = vec.Count(); n < 100'000; n++ )
+		vec.AddToTail( pair_t{ n, n } );
+
+	nFailed += Allocator_t::s_nCalls != nCalls + 1;
+
+	vec.ShrinkToFit();
+	nFailed += vec.Capacity() != vec.Count();
+	nFailed += static_cast< const decltype( vec ) & >( vec )[ 99'999 ] != pair_t{ 99'999, 99'999 };
+
+	// A buffer vector returns to its inline storage on ShrinkToFit.
+	CBufferVector< size_t, pair_t, 8, Allocator_t > buffer;
+
+	for ( size_t n = 0; n < 100; n++ )
+		buffer.AddToTail( pair_t{ n, n } );
+
+	nFailed += !buffer.IsOverflow();
+
+	while ( buffer.Count() > 4 )
+		buffer.Remove( buffer.Count() - 1 );
+
+	nFailed += !buffer.IsOverflow();
+	buffer.ShrinkToFit();
+	nFailed += buffer.IsOverflow() || buffer.Capacity() != 8;
+	nFailed += static_cast< const decltype( buffer ) & >( buffer )[ 3 ] != pair_t{ 3, 3 };
+
+	return nFailed;
+}
+
+static_assert( CGrowOneAndHalf::Capacity< uint8_t >( 200, 201, 0, 1 ) == 255 );
+static_assert( CGrowOneAndHalf::Capacity< size_t >( 0, 1, 0, 8 ) == CGrowOneAndHalf::MIN_CAPACITY );
+static_assert( CGrowPages<>::Capacity< size_t >( 512, 513, 0, 8 ) == 1024 );
+static_assert( NextDoublingCapacityT< size_t >( 0, 10, 4, 100 ) == 10 );
+
+// Returns the number of failed checks.
+int TestGrowthPolicy()
+{
+	int nFailed = 0;
+
+	// 1.5x growth keeps the slack under a third of the count.
+	CompactVector_t< uint64_t > compact;
+	size_t nGrowths = 0;
+
+	for ( uint64_t n = 0; n < 1000; n++ )
+	{
+		const size_t nCapacity = compact.Capacity();
+
+		compact.AddToTail( n );
+
+		if ( compact.Capacity() != nCapacity )
+		{
+			nGrowths++;
+			nFailed += nCapacity && compact.Capacity() != nCapacity + nCapacity / 2;
+		}
+	}
+
+	nFailed += compact.Capacity() * 2 > compact.Count() * 3;
+	nFailed += nGrowths < 10;
+	nFailed += static_cast< const decltype( compact ) & >( compact )[ 999 ] != 999;
+
+	// Past a page, paged vectors allocate whole pages.
+	PagedVector_t< uint64_t > paged;
+
+	for ( uint64_t n = 0; n < 100'000; n++ )
+	{
+		paged.AddToTail( n );
+		nFailed += paged.Capacity() > 512 && paged.CapacitySize() % 4096 != 0;
+	}
+
+	nFailed += paged.Capacity() * 2 > paged.Count() * 3 + 512;
+
+	// Doubling clamped to [16, 1000] elements.
+	CVector< size_t, size_t, CAllocator< size_t, size_t >, CGrowDoubling< 16, 1000 > > clamped;
+
+	clamped.AddToTail( 0 );
+	nFailed += clamped.Capacity() != 16;
+
+	for ( size_t n = 1; n < 513; n++ )
+		clamped.AddToTail( n );
+
+	nFailed += clamped.Capacity() != 1000;
+
+	// Growable vectors grow from their inline count.
+	CBufferVector< size_t, size_t, 8, CAllocator< size_t, size_t >, CGrowOneAndHalf > buffer;
+
+	for ( size_t n = 0; n < 9; n++ )
+		buffer.AddToTail( n );
+
+	nFailed += !buffer.IsOverflow() || buffer.Capacity() != 12;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestMappedVector()
+{
+	using Mapped_t = MappedVector_t< pair_t >;
+
+	static constexpr const char *PATH = "ball-types-mapped.bin";
+
+	int nFailed = 0;
+
+	( void )unlink( PATH );
+
+	// Shared mode creates the file and persists the records on Close.
+	{
+		Mapped_t vec( PATH, Mapped_t::MODE_SHARED );
+
+		nFailed += !vec.IsOpen() || vec.Count() != 0;
+
+		for ( size_t n = 0; n < 10'000; n++ )
+			vec.AddToTail( pair_t{ n, n * 2 } );
+
+		nFailed += !vec.Flush();
+	}
+
+	// Read-only mode sees them straight from the mapping.
+	{
+		Mapped_t vec( PATH, Mapped_t::MODE_READ_ONLY );
+
+		nFailed += !vec.IsOpen() || vec.Count() != 10'000;
+		nFailed += vec.IsOpen() && static_cast< const Mapped_t & >( vec )[ 9'999 ] != pair_t{ 9'999, 19'998 };
+	}
+
+	// Read-only views have no room to append into.
+	{
+		Mapped_t vec( PATH, Mapped_t::MODE_READ_ONLY );
+
+		nFailed += vec.Capacity() != vec.Count();
+	}
+
+	// Appends past a file length that is not a page multiple extend the file first.
+	{
+		const int nFD = open( PATH, BALL_O_RDWR | BALL_O_CLOEXEC );
+
+		nFailed += nFD < 0 || ftruncate( nFD, static_cast< long >( Mapped_t::HEADER_SIZE + 10'000 * sizeof( pair_t ) ) ) != 0;
+
+		if ( nFD >= 0 )
+			( void )close( nFD );
+
+		{
+			Mapped_t vec( PATH, Mapped_t::MODE_SHARED );
+
+			nFailed += vec.Capacity() != 10'000;
+
+			vec.AddToTail( pair_t{ 10'000, 20'000 } );
+		}
+
+		Mapped_t vec( PATH, Mapped_t::MODE_READ_ONLY );
+
+		nFailed += vec.Count() != 10'001;
+		nFailed += vec.IsOpen() && static_cast< const Mapped_t & >( vec )[ 10'000 ] != pair_t{ 10'000, 20'000 };
+	}
+
+	// Copy-on-write changes and growth stay private.
+	{
+		Mapped_t vec( PATH, Mapped_t::MODE_COPY_ON_WRITE );
+
+		nFailed += !vec.IsOpen() || vec.Count() != 10'001;
+
+		if ( vec.IsOpen() )
+			vec.Data()[ 0 ] = pair_t{ 1, 1 };
+
+		for ( size_t n = 0; n < 50'000; n++ )
+			vec.AddToTail( pair_t{ n, n } );
+
+		nFailed += vec.Count() != 60'001;
+		nFailed += static_cast< const Mapped_t & >( vec )[ 60'000 ] != pair_t{ 49'999, 49'999 };
+
+		// Writable views remove as usual (read-only ones assert).
+		nFailed += vec.Remove( 0 ) != 0 || vec.Count() != 60'000;
+		nFailed += static_cast< const Mapped_t & >( vec )[ 0 ] != pair_t{ 1, 2 };
+	}
+
+	{
+		Mapped_t vec( PATH, Mapped_t::MODE_READ_ONLY );
+
+		nFailed += vec.Count() != 10'001;
+		nFailed += vec.IsOpen() && static_cast< const Mapped_t & >( vec )[ 0 ] != pair_t{ 0, 0 };
+	}
+
+	// A header written for another element type is rejected.
+	{
+		MappedVector_t< size_t > other;
+
+		nFailed += other.Open( PATH, MappedVector_t< size_t >::MODE_READ_ONLY );
+	}
+
+	( void )unlink( PATH );
+
+	return nFailed;
+}
+
+// Element that points at itself: a bytewise relocation leaves a stale pointer.
+struct CSelfTracked
+{
+	static inline int s_nLive = 0;
+
+	CSelfTracked( size_t nValue = 0 ) : m_pSelf( this ), m_nValue( nValue ) { s_nLive++; }
+	CSelfTracked( const CSelfTracked &other ) : m_pSelf( this ), m_nValue( other.m_nValue ) { s_nLive++; }
+	CSelfTracked( CSelfTracked &&other ) : m_pSelf( this ), m_nValue( other.m_nValue ) { s_nLive++; }
+	~CSelfTracked() { s_nLive--; }
+
+	CSelfTracked &operator=( const CSelfTracked &other ) { m_nValue = other.m_nValue; return *this; }
+	bool operator==( const CSelfTracked &other ) const { return m_nValue == other.m_nValue; }
+
+	bool IsValid() const { return m_pSelf == this; }
+
+	const CSelfTracked *m_pSelf;
+	size_t m_nValue;
+};
+
+static_assert( IS_TRIVIALLY_RELOCATABLE< pair_t >, "pair_t is trivially copyable" );
+static_assert( !IS_TRIVIALLY_RELOCATABLE< CSelfTracked >, "CSelfTracked depends on its address" );
+
+// Returns the number of failed checks.
+int TestRelocation()
+{
+	int nFailed = 0;
+
+	{
+		CBufferVector< size_t, CSelfTracked, 4 > vec;
+
+		for ( size_t n = 0; n < 100; n++ )
+			vec.AddToTail( CSelfTracked( n ) );
+
+		vec.AddToHead( CSelfTracked( 1000 ) );
+		vec.Remove( 50, 10 );
+
+		while ( vec.Count() > 3 )
+			vec.Remove( 1 );
+
+		vec.ShrinkToFit();
+		nFailed += vec.IsOverflow();
+
+		for ( const auto &it : static_cast< const decltype( vec ) & >( vec ) )
+			nFailed += !it.IsValid();
+
+		nFailed += vec.Count() != 3;
+		nFailed += static_cast< const decltype( vec ) & >( vec )[ 0 ].m_nValue != 1000;
+		nFailed += CSelfTracked::s_nLive != 3;
+
+		CVector< size_t, CSelfTracked > heap;
+
+		for ( size_t n = 0; n < 1000; n++ )
+			heap.AddToTail( CSelfTracked( n ) );
+
+		heap.Remove( 0, 500 );
+		heap.ShrinkToFit();
+
+		for ( const auto &it : static_cast< const decltype( heap ) & >( heap ) )
+			nFailed += !it.IsValid();
+
+		nFailed += static_cast< const decltype( heap ) & >( heap )[ 0 ].m_nValue != 500;
+		nFailed += CSelfTracked::s_nLive != 503;
+
+		// ReplaceRange constructs into the replaced slots and past the end.
+		const CSelfTracked aReplace[ 3 ] = { CSelfTracked( 7 ), CSelfTracked( 8 ), CSelfTracked( 9 ) };
+
+		heap.ReplaceRange( 10, CMemoryView< size_t, const CSelfTracked >( aReplace ) );
+		heap.ReplaceRange( 499, CMemoryView< size_t, const CSelfTracked >( aReplace ) );
+
+		const auto &replaced = static_cast< const decltype( heap ) & >( heap );
+
+		for ( const auto &it : replaced )
+			nFailed += !it.IsValid();
+
+		nFailed += replaced.Count() != 502 || replaced[ 10 ].m_nValue != 7 || replaced[ 12 ].m_nValue != 9 || replaced[ 13 ].m_nValue != 513;
+		nFailed += replaced[ 498 ].m_nValue != 998 || replaced[ 499 ].m_nValue != 7 || replaced[ 501 ].m_nValue != 9;
+		nFailed += CSelfTracked::s_nLive != 508;
+	}
+
+	nFailed += CSelfTracked::s_nLive != 0;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks of Ball_MemMove( pBuffer + nDest, pBuffer + nSrc, nSize ).
+static int CheckMemMove( uchar_t *pBuffer, uchar_t *pExpected, size_t nLength, size_t nDest, size_t nSrc, size_t nSize )
+{
+	static uchar_t s_aTemp[ 70'000 ];
+
+	for ( size_t n = 0; n < nLength; n++ )
+		pBuffer[ n ] = pExpected[ n ] = static_cast< uchar_t >( n * 7 + n / 251 );
+
+	for ( size_t n = 0; n < nSize; n++ )
+		s_aTemp[ n ] = pExpected[ nSrc + n ];
+
+	for ( size_t n = 0; n < nSize; n++ )
+		pExpected[ nDest + n ] = s_aTemp[ n ];
+
+	Ball_MemMove( pBuffer + nDest, pBuffer + nSrc, nSize );
+
+	for ( size_t n = 0; n < nLength; n++ )
+	{
+		if ( pBuffer[ n ] != pExpected[ n ] )
+			return 1;
+	}
+
+	return 0;
+}
+
+// Returns the number of failed checks.
+int TestMemoryCopy()
+{
+	static uchar_t s_aBuffer[ 140'000 ];
+	static uchar_t s_aExpected[ 140'000 ];
+
+	static constexpr size_t SIZES[] = { 1000, 4096, 4099, 65'536 + 77 };
+
+	int nFailed = 0;
+
+	const uint32_t nDefault = Ball_MemCopyKernel();
+
+	for ( uint32_t nKernel = BALL_MEMCOPY_SYSTEM; nKernel <= nDefault; nKernel++ )
+	{
+		nFailed += Ball_MemCopySetKernel( nKernel ) != nKernel;
+
+		// Every short size, every alignment, both directions and disjoint.
+		for ( size_t nSize = 0; nSize <= 300; nSize++ )
+		{
+			for ( size_t nShift = 1; nShift <= 67; nShift += 3 )
+			{
+				nFailed += CheckMemMove( s_aBuffer, s_aExpected, 512, nShift, 0, nSize );
+				nFailed += CheckMemMove( s_aBuffer, s_aExpected, 512, 3, 3 + nShift, nSize );
+				nFailed += CheckMemMove( s_aBuffer, s_aExpected, 1024, 512 + nShift % 64, nShift % 64, nSize );
+			}
+		}
+
+		for ( const size_t nSize : SIZES )
+		{
+			nFailed += CheckMemMove( s_aBuffer, s_aExpected, 2 * nSize + 256, 13, 0, nSize );
+			nFailed += CheckMemMove( s_aBuffer, s_aExpected, 2 * nSize + 256, 64, 200, nSize );
+			nFailed += CheckMemMove( s_aBuffer, s_aExpected, 2 * nSize + 256, nSize + 100, 5, nSize );
+		}
+	}
+
+	nFailed += Ball_MemCopySetKernel( nDefault ) != nDefault;
+
+	// Insert and Remove shift the tail through the kernels.
+	Vector_t< uint64_t > vec;
+
+	for ( uint64_t n = 0; n < 10'000; n++ )
+		vec.AddToTail( n );
+
+	vec.AddToHead( 100'000 );
+	vec.Remove( 1, 3 );
+
+	const auto &view = static_cast< const decltype( vec ) & >( vec );
+
+	nFailed += vec.Count() != 9'998 || view[ 0 ] != 100'000;
+
+	for ( size_t n = 1; n < vec.Count(); n++ )
+		nFailed += view[ n ] != n + 2;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestLargeCopy()
+{
+	static constexpr size_t SIZE = ( 24u << 20 ) + 123;
+
+	int nFailed = 0;
+
+	size_t nLargeSize;
+	uint32_t nThreads;
+
+	Ball_MemCopyTuning( &nLargeSize, &nThreads );
+	nFailed += nLargeSize != BALL_MEMCOPY_LARGE_SIZE || nThreads < 1 || nThreads > BALL_MEMCOPY_THREADS;
+
+	uchar_t *pSrc = static_cast< uchar_t * >( CAllocatorBase::Alloc( SIZE + 64, 64 ) );
+	uchar_t *pDest = static_cast< uchar_t * >( CAllocatorBase::Alloc( SIZE + 64, 64 ) );
+
+	for ( size_t n = 0; n < SIZE + 64; n++ )
+		pSrc[ n ] = static_cast< uchar_t >( n * 13 + n / 4099 );
+
+	const uint32_t nDefault = Ball_MemCopyKernel();
+
+	static constexpr uint32_t THREADS[] = { 1, 4 };
+
+	// Streamed on one thread, then shared by the pool, at odd offsets.
+	for ( uint32_t nKernel = BALL_MEMCOPY_SYSTEM; nKernel <= nDefault; nKernel++ )
+	{
+		for ( const uint32_t nTuneThreads : THREADS )
+		{
+			Ball_MemCopySetKernel( nKernel );
+			Ball_MemCopyTune( 1u << 20, nTuneThreads );
+
+			for ( size_t n = 0; n < SIZE + 64; n++ )
+				pDest[ n ] = 0;
+
+			Ball_MemCopy( pDest + 7, pSrc + 3, SIZE );
+
+			for ( size_t n = 0; n < SIZE + 64; n++ )
+			{
+				if ( pDest[ n ] != ( n >= 7 && n < SIZE + 7 ? pSrc[ n - 4 ] : 0 ) )
+				{
+					nFailed++;
+
+					break;
+				}
+			}
+		}
+	}
+
+	Ball_MemCopySetKernel( nDefault );
+
+	// CopyFrom between large vectors goes through the engine too.
+	Vector_t< uint64_t > from;
+
+	for ( uint64_t n = 0; n < ( 3u << 20 ); n++ )
+		from.AddToTail( n );
+
+	const Vector_t< uint64_t > to( from.View() );
+
+	nFailed += to.Count() != from.Count();
+
+	for ( size_t n = 0; n < to.Count(); n += 4097 )
+		nFailed += to[ n ] != n;
+
+	Ball_MemCopyTune( nLargeSize, nThreads );
+
+	CAllocatorBase::Free( pSrc );
+	CAllocatorBase::Free( pDest );
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestMemoryCompare()
+{
+	static uchar_t s_aLeft[ 512 ];
+	static uchar_t s_aRight[ 512 ];
+
+	for ( size_t n = 0; n < 512; n++ )
+		s_aLeft[ n ] = static_cast< uchar_t >( n * 7 + n / 251 );
+
+	int nFailed = 0;
+
+	const uint32_t nDefault = Ball_MemCopyKernel();
+
+	for ( uint32_t nKernel = BALL_MEMCOPY_SYSTEM; nKernel <= nDefault; nKernel++ )
+	{
+		nFailed += Ball_MemCopySetKernel( nKernel ) != nKernel;
+
+		// Every short size and alignment, equal and with one byte differing anywhere.
+		for ( size_t nSize = 0; nSize <= 300; nSize++ )
+		{
+			for ( size_t nOffset = 0; nOffset < 64; nOffset += 9 )
+			{
+				const uchar_t *pLeft = s_aLeft + nOffset;
+				uchar_t *pRight = s_aRight + nOffset * 5 % 64;
+
+				for ( size_t n = 0; n < nSize; n++ )
+					pRight[ n ] = pLeft[ n ];
+
+				nFailed += Ball_MemMismatch( pLeft, pRight, nSize ) != nSize || Ball_MemCompare( pLeft, pRight, nSize ) != 0;
+
+				for ( size_t nDiff = 0; nDiff < nSize; nDiff += 1 + nDiff / 16 )
+				{
+					const uchar_t nSaved = pRight[ nDiff ];
+
+					pRight[ nDiff ] = static_cast< uchar_t >( nSaved ^ 0x80 );
+
+					nFailed += Ball_MemMismatch( pLeft, pRight, nSize ) != nDiff;
+					nFailed += Ball_MemCompare( pLeft, pRight, nSize ) != ( pLeft[ nDiff ] < pRight[ nDiff ] ? -1 : 1 );
+
+					pRight[ nDiff ] = nSaved;
+				}
+			}
+		}
+	}
+
+	nFailed += Ball_MemCopySetKernel( nDefault ) != nDefault;
+
+	// Views and strings skip equal prefixes through the kernels, ordering as their elements.
+	static uint32_t s_aValues[ 100 ], s_aOther[ 100 ];
+
+	for ( uint32_t n = 0; n < 100; n++ )
+		s_aValues[ n ] = s_aOther[ n ] = n * 0x01010101u;
+
+	CMemoryView< size_t, const uint32_t > vValues( s_aValues ), vOther( s_aOther );
+	CMemoryView< size_t, const uint32_t > vPrefix = vOther.DropBack( 30 ), vLonger = vOther.DropBack( 29 ), vSuffix = vOther.DropFront( 10 );
+
+	nFailed += !( vValues == vOther ) || vValues < vOther || !vValues.StartsWith( vLonger ) || !vValues.EndsWith( vSuffix );
+
+	s_aOther[ 70 ] = 0x100u;
+
+	nFailed += vValues == vOther || !( vOther < vValues ) || vValues < vOther || !vValues.StartsWith( vPrefix ) || vValues.StartsWith( vLonger ) || vValues.EndsWith( vSuffix );
+
+	static char_t s_aText[ 80 ], s_aOtherText[ 80 ];
+
+	for ( size_t n = 0; n < 80; n++ )
+		s_aText[ n ] = s_aOtherText[ n ] = static_cast< char_t >( 'a' + n % 26 );
+
+	const StringView_t sText( 80, s_aText ), sOther( 80, s_aOtherText ), sShort( 50, s_aOtherText );
+
+	nFailed += !sText.Equals( sOther ) || sText.Compare( sOther ) != 0 || sShort.Compare( sText ) != -1 || sText.Compare( sShort ) != 1;
+
+	s_aOtherText[ 60 ] = 'A';
+
+	nFailed += sText.Equals( sOther ) || sText.Compare( sOther ) != 1 || sOther.Compare( sText ) != -1 || sShort.Compare( sText ) != -1;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks of the search kernels over @p nCount elements, @p value
+// at every @p nStep-th from @p nFirst on and @p other elsewhere.
+template < typename T >
+static int CheckMemFind( T *pData, size_t nCount, T value, T other, size_t nFirst, size_t nStep )
+{
+	static size_t s_aIndices[ 400 ];
+
+	size_t nExpectFirst = nCount, nExpectLast = nCount, nExpectCount = 0;
+
+	for ( size_t n = 0; n < nCount; n++ )
+	{
+		const bool_t bMatch = n >= nFirst && ( n - nFirst ) % nStep == 0;
+
+		pData[ n ] = bMatch ? value : other;
+
+		if ( bMatch )
+		{
+			nExpectFirst = nExpectFirst == nCount ? n : nExpectFirst;
+			nExpectLast = n;
+			nExpectCount++;
+		}
+	}
+
+	int nFailed = 0;
+
+	nFailed += Ball_MemFind( pData, nCount, &value, MEMFIND_TYPE< T > ) != nExpectFirst;
+	nFailed += Ball_MemRFind( pData, nCount, &value, MEMFIND_TYPE< T > ) != nExpectLast;
+	nFailed += Ball_MemCount( pData, nCount, &value, MEMFIND_TYPE< T > ) != nExpectCount;
+
+	// Small batches, resumed after the last index, as FindAllElements does.
+	size_t nFound = 0;
+
+	for ( size_t nFrom = 0; ; )
+	{
+		const size_t nBatch = Ball_MemFindAll( pData + nFrom, nCount - nFrom, &value, MEMFIND_TYPE< T >, s_aIndices + nFound, 7 );
+
+		for ( size_t n = nFound; n < nFound + nBatch; n++ )
+			s_aIndices[ n ] += nFrom;
+
+		nFound += nBatch;
+
+		if ( nBatch < 7 )
+			break;
+
+		nFrom = s_aIndices[ nFound - 1 ] + 1;
+	}
+
+	nFailed += nFound != nExpectCount;
+
+	for ( size_t n = 0; n < nFound; n++ )
+		nFailed += s_aIndices[ n ] != nFirst + n * nStep;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks of every search kernel over elements of T.
+template < typename T >
+static int CheckMemFindType( T value, T other )
+{
+	alignas( 64 ) static uint64_t s_aBuffer[ 330 ];
+
+	int nFailed = 0;
+
+	// Misaligned by one element, every count up to a few unrolled vectors.
+	T *pData = reinterpret_cast< T * >( s_aBuffer ) + 1;
+
+	for ( size_t nCount = 0; nCount <= 300; nCount++ )
+	{
+		nFailed += CheckMemFind( pData, nCount, value, other, nCount, 1 );
+		nFailed += CheckMemFind( pData, nCount, value, other, nCount / 2, nCount + 1 );
+		nFailed += CheckMemFind( pData, nCount, value, other, nCount - nCount / 7, 3 );
+		nFailed += CheckMemFind( pData, nCount, value, other, nCount % 5, 1 + nCount % 13 );
+	}
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestMemoryFind()
+{
+	int nFailed = 0;
+
+	const uint32_t nDefault = Ball_MemCopyKernel();
+
+	for ( uint32_t nKernel = BALL_MEMCOPY_SYSTEM; nKernel <= nDefault; nKernel++ )
+	{
+		nFailed += Ball_MemCopySetKernel( nKernel ) != nKernel;
+
+		nFailed += CheckMemFindType< uint8_t >( 0x80, 0x7F );
+		nFailed += CheckMemFindType< uint16_t >( 0x8001, 0x0180 );
+		nFailed += CheckMemFindType< uint32_t >( 0x80000001u, 0x01000080u );
+		nFailed += CheckMemFindType< uint64_t >( 0x8000000000000001u, 0x0100000000000080u );
+		nFailed += CheckMemFindType< float >( -0.0f, 1.5f );
+		nFailed += CheckMemFindType< double >( 2.5, -2.5 );
+	}
+
+	nFailed += Ball_MemCopySetKernel( nDefault ) != nDefault;
+
+	// Views: ranges, counts and every occurrence, as the element loops would.
+	static int32_t s_aValues[ 1'000 ];
+
+	for ( int32_t n = 0; n < 1'000; n++ )
+		s_aValues[ n ] = n % 100;
+
+	const CMemoryView< size_t, const int32_t > vValues( s_aValues );
+
+	nFailed += vValues.Find( 42 ) != 42 || vValues.Find( 42, 43 ) != 142 || vValues.Find( 100 ) != vValues.INVALID_INDEX;
+	nFailed += vValues.RFind( 42 ) != 942 || vValues.RFind( 42, 941 ) != 842 || vValues.RFind( 42, 41 ) != vValues.INVALID_INDEX;
+	nFailed += vValues.CountOf( 7 ) != 10 || vValues.CountOf( -7 ) != 0;
+
+	size_t nNext = 307;
+
+	nFailed += vValues.FindAll( 7, [ & ]( size_t i ) { nFailed += i != nNext; nNext += 100; }, 300 ) != 7 || nNext != 1'007;
+
+	// Floating point compares as such: -0 finds +0, NaN is never found.
+	static float s_aFloats[ 200 ];
+
+	s_aFloats[ 150 ] = 1.0f;
+
+	const CMemoryView< size_t, const float > vFloats( s_aFloats );
+
+	nFailed += vFloats.Find( -0.0f ) != 0 || vFloats.RFind( -0.0f ) != 199 || vFloats.Find( 1.0f ) != 150;
+	nFailed += vFloats.Find( __builtin_nanf( "" ) ) != vFloats.INVALID_INDEX || vFloats.CountOf( 0.0f ) != 199;
+
+	// Strings: characters and substrings hop between first-character matches.
+	static char_t s_aText[ 4'000 ];
+
+	for ( size_t n = 0; n < 4'000; n++ )
+		s_aText[ n ] = static_cast< char_t >( 'a' + n % 7 );
+
+	s_aText[ 3'000 ] = 'Z';
+
+	StringView_t sText( 4'000, s_aText );
+	char_t aNeedle[] = { 'c', 'd', 'Z', 'f' };
+	const CMemoryView< size_t, const char_t > vNeedle( aNeedle );
+
+	nFailed += sText.Find( 'Z' ) != 3'000 || sText.RFind( 'a' ) != 3'997 || sText.CountOf( 'Z' ) != 1;
+	nFailed += sText.Find( vNeedle ) != 2'998 || sText.RFind( vNeedle ) != 2'998 || sText.Find( vNeedle, 2'999 ) != sText.INVALID_INDEX;
+
+	aNeedle[ 2 ] = 'e';
+	aNeedle[ 3 ] = 'f';
+
+	nFailed += sText.Find( vNeedle ) != 2 || sText.RFind( vNeedle ) != 3'992;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestReservedVector()
+{
+	using Reserved_t = ReservedVector_t< pair_t >;
+
+	static constexpr size_t MAX_COUNT = 1u << 22; // 64 MiB of address space.
+
+	int nFailed = 0;
+
+	Ball_MemStats_t before, after;
+
+	Ball_MemStats( &before );
+
+	{
+		Reserved_t vec( MAX_COUNT );
+
+		nFailed += vec.MaxCount() != MAX_COUNT || vec.Data() != nullptr;
+
+		vec.AddToTail( pair_t{ 0, 0 } );
+
+		const pair_t *pFirst = vec.Data();
+
+		nFailed += vec.SetMaxCount( MAX_COUNT / 2 );
+
+		// Only the committed pages count as mapped, not the reservation.
+		Ball_MemStats( &after );
+		nFailed += after.nMappedBytes - before.nMappedBytes >= MAX_COUNT * sizeof( pair_t ) / 2;
+
+		for ( size_t n = 1; n < 500'000; n++ )
+			vec.AddToTail( pair_t{ n, n * 2 } );
+
+		// Grown without moving: earlier pointers are still valid.
+		nFailed += vec.Data() != pFirst;
+		nFailed += pFirst->first != 0 || pFirst[ 499'999 ] != pair_t{ 499'999, 999'998 };
+
+		Ball_MemStats( &after );
+		nFailed += after.nCommitCalls <= before.nCommitCalls;
+		nFailed += after.nReallocCopy != before.nReallocCopy || after.nReallocRemap != before.nReallocRemap;
+
+		// Shrinking decommits in place.
+		vec.Remove( 1'000, vec.Count() - 1'000 );
+		vec.Compact();
+		nFailed += vec.Data() != pFirst || vec.Capacity() != 1'000;
+
+		Ball_MemStats( &after );
+		nFailed += after.nShrinkCalls <= before.nShrinkCalls;
+
+		vec.AddToTail( pair_t{ 1, 1 } );
+		nFailed += vec.Data() != pFirst || pFirst[ 1'000 ] != pair_t{ 1, 1 };
+
+		// Copying an empty view empties the vector, as it does for CVector.
+		struct CCopyable : Reserved_t
+		{
+			using Reserved_t::Reserved_t;
+			using Reserved_t::CopyFrom;
+		} copy( 1'000 );
+
+		copy.AddToTail( pair_t{ 1, 1 } );
+		copy.CopyFrom( CMemoryView< size_t, pair_t >() );
+		nFailed += copy.Count() != 0;
+
+		// Non-trivial elements are never relocated either.
+		CReservedVector< size_t, CSelfTracked > tracked( 100'000 );
+
+		for ( size_t n = 0; n < 100'000; n++ )
+			tracked.AddToTail( CSelfTracked( n ) );
+
+		for ( const auto &it : static_cast< const decltype( tracked ) & >( tracked ) )
+			nFailed += !it.IsValid();
+
+		nFailed += CSelfTracked::s_nLive != 100'000;
+	}
+
+	nFailed += CSelfTracked::s_nLive != 0;
+
+	Ball_MemStats( &after );
+	nFailed += after.nMappedBytes != before.nMappedBytes;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestRingBuffer()
+{
+	int nFailed = 0;
+
+	RingBuffer_t ring( 1000 );
+
+	nFailed += !ring.IsValid() || ring.Capacity() < 1000 || !ring.Empty();
+
+	if ( !ring.IsValid() )
+		return nFailed;
+
+	const size_t nCapacity = ring.Capacity();
+	char_t aBlock[ 3000 ];
+
+	for ( size_t n = 0; n < sizeof( aBlock ); n++ )
+		aBlock[ n ] = static_cast< char_t >( 'a' + n % 26 );
+
+	// Push the head close to the end, so the next window wraps.
+	for ( size_t nWritten = 0; nWritten < nCapacity - 100; )
+	{
+		const size_t nChunk = nCapacity - 100 - nWritten < sizeof( aBlock ) ? nCapacity - 100 - nWritten : sizeof( aBlock );
+
+		nWritten += ring.Write( CMemoryView< size_t, const char_t >( nChunk, aBlock ) );
+	}
+
+	ring.Consume( ring.Count() );
+
+	// The write window spans the wrap point but is one contiguous range.
+	auto write = ring.WriteView();
+
+	nFailed += write.Count() != nCapacity;
+
+	for ( size_t n = 0; n < 300; n++ )
+		write.Data()[ n ] = aBlock[ n ];
+
+	ring.Commit( 300 );
+
+	auto read = ring.ReadString();
+
+	nFailed += read.Count() != 300;
+
+	for ( size_t n = 0; n < read.Count(); n++ )
+		nFailed += read.Data()[ n ] != aBlock[ n ];
+
+	// Bytes past the end of the first mapping are the start of the buffer.
+	const char_t *pFirst = read.Data() - ( nCapacity - 100 );
+
+	nFailed += pFirst[ nCapacity ] != aBlock[ 100 ] || pFirst[ 0 ] != aBlock[ 100 ];
+
+	char_t aOut[ 400 ];
+
+	nFailed += ring.Read( CMemoryView< size_t, char_t >( 400, aOut ) ) != 300;
+	nFailed += aOut[ 299 ] != aBlock[ 299 ] || !ring.Empty();
+
+	// Fill to the brim.
+	while ( !ring.Full() )
+		ring.Write( CMemoryView< size_t, const char_t >( sizeof( aBlock ), aBlock ) );
+
+	nFailed += ring.Space() != 0 || ring.Write( CMemoryView< size_t, const char_t >( 1, aBlock ) ) != 0;
+
+	// A narrow index with a capacity above half its range: head + count
+	// exceeds 65535 once the head is near the end.
+	CRingBuffer< uint16_t, char_t > narrow( 60'000 );
+
+	nFailed += !narrow.IsValid() || narrow.Capacity() < 60'000;
+
+	if ( narrow.IsValid() )
+	{
+		const uint16_t nNarrow = narrow.Capacity();
+
+		narrow.Commit( static_cast< uint16_t >( nNarrow - 10 ) );
+		narrow.Consume( static_cast< uint16_t >( nNarrow - 10 ) );
+		narrow.Commit( 50'000 );
+
+		// The tail wrapped to slot 50'000 - 10; the next write lands there.
+		nFailed += narrow.Write( CMemoryView< uint16_t, const char_t >( 1, "z" ) ) != 1;
+
+		const char_t *pBase = narrow.ReadView().Data() - ( nNarrow - 10 );
+
+		nFailed += pBase[ 50'000 - 10 ] != 'z';
+
+		narrow.Consume( 50'001 );
+		nFailed += !narrow.Empty() || narrow.ReadView().Data() != pBase + 50'000 - 9;
+	}
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestSharedSegment()
+{
+	static constexpr const char *NAME = "/ball-types-tests";
+
+	int nFailed = 0;
+
+	( void )CSharedSegment::Unlink( NAME );
+
+	CSharedSegment writer;
+
+	nFailed += !writer.Create( NAME, 1u << 20 );
+
+	if ( !writer.IsOpen() )
+		return nFailed;
+
+	nFailed += CSharedSegment().Create( NAME, 1u << 20 ); // Exists already.
+
+	{
+		CSharedSegmentScope scope( writer );
+
+		SharedVector_t< pair_t > vec;
+
+		for ( size_t n = 0; n < 10'000; n++ )
+			vec.AddToTail( pair_t{ n, n * 3 } );
+
+		SharedString_t str;
+
+		str.AppendMultiple( "shared ", 42 );
+
+		nFailed += !writer.Contains( vec.Data(), vec.Size() ) || !writer.Contains( str.Data(), str.Size() );
+		nFailed += !writer.Publish( "pairs", vec );
+		nFailed += !writer.Publish( "greeting", str );
+
+		// A second, read-only mapping (as another process would see it).
+		CSharedSegment reader;
+
+		nFailed += !reader.Open( NAME );
+
+		const auto pairs = reader.Find< pair_t >( "pairs" );
+
+		nFailed += pairs.Count() != 10'000 || pairs.Data() == vec.Data();
+		nFailed += pairs.Count() == 10'000 && pairs.Data()[ 9'999 ] != pair_t{ 9'999, 29'997 };
+
+		const auto greeting = reader.FindString( "greeting" );
+
+		nFailed += greeting.Count() != 9 || __builtin_memcmp( greeting.Data(), "shared 42", 9 );
+		nFailed += reader.Find< uint32_t >( "pairs" ).Count() != 0 || reader.Find< pair_t >( "missing" ).Count() != 0;
+		nFailed += reader.Alloc( 16, 16 ) != nullptr;
+
+		// The reader's copy of the most recent block can be neither grown nor
+		// rewound (either would write to its read-only pages).
+		const ptr_t pLast = const_cast< char * >( greeting.Data() );
+
+		nFailed += CSharedSegment::Realloc( pLast, 64, 16 ) != nullptr;
+		CSharedSegment::Free( pLast );
+		nFailed += reader.FindString( "greeting" ).Count() != 9;
+	}
+
+	// Blocks outside a scope come from the heap.
+	{
+		SharedVector_t< size_t > heap;
+
+		heap.AddToTail( 1 );
+		nFailed += writer.Contains( heap.Data() );
+	}
+
+	writer.Close();
+	nFailed += !CSharedSegment::Unlink( NAME );
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestSparseArray()
+{
+	int nFailed = 0;
+
+	{
+		// The full 32-bit id space: 32 GiB of address space, nothing committed.
+		SparseArray_t< uint64_t > arr( size_t( 1 ) << 32 );
+
+		nFailed += !arr.IsValid();
+
+		if ( !arr.IsValid() )
+			return nFailed;
+
+		const size_t nHigh = size_t( 1 ) << 31;
+
+		for ( size_t n = 0; n < 1'000; n++ )
+		{
+			arr.Set( n, n );
+			arr.Set( nHigh + n, n * 2 );
+		}
+
+		arr.Set( arr.MaxCount() - 1, 7u );
+
+		nFailed += arr.Count() != 2'001;
+		nFailed += arr.UsedPages() != 5; // 8000 bytes per cluster, one page for the last id.
+		nFailed += !arr.Find( 999 ) || *arr.Find( 999 ) != 999 || arr.Find( 1'000 ) != nullptr;
+		nFailed += !arr.Find( nHigh + 1 ) || *arr.Find( nHigh + 1 ) != 2;
+		nFailed += arr.Find( arr.MaxCount() ) != nullptr;
+
+		arr.Set( 5, 55u );
+		nFailed += *arr.Find( 5 ) != 55 || arr.Count() != 2'001;
+
+		// Emptied pages are released.
+		for ( size_t n = 0; n < 1'000; n++ )
+			nFailed += !arr.Remove( nHigh + n );
+
+		nFailed += arr.Remove( nHigh ) || arr.UsedPages() != 3 || arr.Count() != 1'001;
+
+		size_t nVisited = 0;
+		size_t nLast = 0;
+
+		arr.ForEach( [ & ]( size_t nIndex, uint64_t & ) { nFailed += nVisited && nIndex <= nLast; nLast = nIndex; nVisited++; } );
+		nFailed += nVisited != 1'001 || nLast != arr.MaxCount() - 1;
+
+		// A released page comes back zero-filled.
+		arr.Set( nHigh, 1u );
+		nFailed += *arr.Find( nHigh ) != 1 || *( arr.Find( nHigh ) + 1 ) != 0;
+	}
+
+	{
+		CSparseArray< uint32_t, CSelfTracked > tracked( 1u << 20 );
+
+		for ( uint32_t n = 0; n < 100; n++ )
+			tracked.Set( n * 4'099, CSelfTracked( n ) );
+
+		tracked.Remove( 0 );
+
+		nFailed += CSelfTracked::s_nLive != 99 || !tracked.Find( 4'099 ) || !tracked.Find( 4'099 )->IsValid();
+	}
+
+	nFailed += CSelfTracked::s_nLive != 0;
+
+	return nFailed;
+}
+
+// Returns the number of failed checks.
+int TestAllocBatch()
+{
+	int nFailed = 0;
+
+	const Ball_MemStats_t before = CAllocatorBase::Stats();
+
+	{
+		constexpr size_t VECTOR_COUNT = 1'000;
+
+		Vector_t< pair_t > vectors[ VECTOR_COUNT ];
+		size_t aCapacities[ VECTOR_COUNT ];
+
+		for ( size_t n = 0; n < VECTOR_COUNT; n++ )
+			aCapacities[ n ] = n % 7 ? 64 + n % 64 : 0;
+
+		nFailed += !Vector_t< pair_t >::ReserveMany( vectors, aCapacities, VECTOR_COUNT );
+
+		const Ball_MemStats_t live = CAllocatorBase::Stats();
+
+		nFailed += live.nBatchCalls != before.nBatchCalls + 1;
+		nFailed += live.nMapCalls != before.nMapCalls + 1;
+
+		for ( size_t n = 0; n < VECTOR_COUNT; n++ )
+		{
+			Vector_t< pair_t > &vec = vectors[ n ];
+
+			nFailed += vec.Capacity() != aCapacities[ n ] || ( vec.Data() != nullptr ) != ( aCapacities[ n ] != 0 );
+			nFailed += reinterpret_cast< uintptr_t >( vec.Data() ) % Vector_t< pair_t >::ALIGNED_SIZE != 0;
+
+			for ( size_t i = 0; i < aCapacities[ n ]; i++ )
+				vec.AddToTail( pair_t{ n, i } );
+		}
+
+		// Filling to capacity stayed inside the slots.
+		nFailed += CAllocatorBase::Stats().nMapCalls != live.nMapCalls;
+
+		// Growing past a slot moves that block out on its own.
+		vectors[ 1 ].AddToTail( pair_t{ 1, 65 } );
+		nFailed += vectors[ 1 ].Count() != 66 || static_cast< const Vector_t< pair_t > & >( vectors[ 1 ] )[ 0 ].second != 0;
+
+		// Individual frees; the mapping goes when its last block does.
+		for ( size_t n = 0; n < VECTOR_COUNT; n += 2 )
+			vectors[ n ].Purge();
+
+		nFailed += CAllocatorBase::Stats().nMappedBytes <= before.nMappedBytes;
+
+		for ( size_t n = 1; n < VECTOR_COUNT; n += 2 )
+		{
+			const Vector_t< pair_t > &vec = vectors[ n ];
+
+			nFailed += vec.Count() && vec[ vec.Count() - 1 ].first != n;
+			vectors[ n ].Purge();
+		}
+	}
+
+	const Ball_MemStats_t after = CAllocatorBase::Stats();
+
+	nFailed += after.nMappedBytes != before.nMappedBytes;
+	nFailed += after.nBatchBlocks - before.nBatchBlocks != 857;
+
+	// Capacities beyond the index type are refused before anything is allocated.
+	{
+		CVector< uint8_t, uint32_t > narrow[ 2 ];
+		const size_t aCapacities[ 2 ] = { 16, 256 };
+
+		nFailed += CVector< uint8_t, uint32_t >::ReserveMany( narrow, aCapacities, 2 );
+		nFailed += narrow[ 0 ].Data() != nullptr || narrow[ 0 ].Capacity() != 0;
+		nFailed += CAllocatorBase::Stats().nBatchCalls != after.nBatchCalls;
+	}
+
+	// Raw blocks, and a refused request leaves nothing behind.
+	{
+		ptr_t apBlocks[ 3 ];
+		const size_t aSizes[ 3 ] = { 100, 0, 5'000 };
+
+		nFailed += !CAllocatorBase::AllocMany( apBlocks, aSizes, 3, 64 );
+		nFailed += !apBlocks[ 0 ] || apBlocks[ 1 ] || !apBlocks[ 2 ] || CAllocatorBase::Size( apBlocks[ 2 ], 64 ) < 5'000;
+
+		__builtin_memset( apBlocks[ 2 ], 0xAB, 5'000 );
+		CAllocatorBase::Free( apBlocks[ 2 ] );
+		CAllocatorBase::Free( apBlocks[ 0 ] );
+
+		const size_t aHuge[ 2 ] = { 16, ~size_t( 0 ) / 2 };
+
+		nFailed += CAllocatorBase::AllocMany( apBlocks, aHuge, 2, 16 ) || apBlocks[ 0 ] != nullptr;
+	}
+
+	nFailed += CAllocatorBase::Stats().nMappedBytes != before.nMappedBytes;
+
+	return nFailed;
+}
+
+// Sums @p nBytes from @p pData with 64 byte loads, the way a SIMD kernel without
+// a scalar tail would; faults unless the buffer is padded.
+static size_t ReadPadded( const void *pData, size_t nBytes )
+{
+	const volatile uint64_t *pWords = static_cast< const volatile uint64_t * >( pData );
+	size_t nSum = 0;
+
+	for ( size_t n = 0; n < ( nBytes + 63 ) / 64 * 8; n++ )
+		nSum += pWords[ n ];
+
+	return nSum;
+}
+
+// Returns the number of failed checks.
+int TestPaddedAlloc()
+{
+	int nFailed = 0;
+
+	static_assert( PaddedVector_t< uint8_t >::IS_PADDED && !Vector_t< uint8_t >::IS_PADDED );
+	static_assert( decltype( PaddedString_t().PaddedView() )::IS_PADDED && !String_t::View_t::IS_PADDED );
+
+	const size_t nPage = 4096;
+
+	// Data ending on a page boundary still has readable padding, through reallocs.
+	{
+		const size_t nLarge = 32 * nPage - 64;
+
+		CAllocatorBase::Trim();
+
+		uchar_t *pMem = static_cast< uchar_t * >( Ball_AllocAlignEx( nLarge, 64, BALL_ALLOC_PADDED ) );
+
+		nFailed += !pMem || Ball_MemSize( pMem, 64, 0 ) != nLarge + BALL_ALLOC_PADDING;
+
+		if ( !pMem )
+			return nFailed;
+
+		pMem[ nLarge - 1 ] = 1;
+		ReadPadded( pMem, nLarge );
+
+		pMem = static_cast< uchar_t * >( Ball_ReallocAlign( pMem, 3 * nLarge, 64 ) );
+		nFailed += !pMem || pMem[ nLarge - 1 ] != 1;
+		ReadPadded( pMem, 3 * nLarge );
+
+		// Shrinking returns pages, but not the padding.
+		pMem = static_cast< uchar_t * >( Ball_ReallocAlign( pMem, nLarge / 2 - 32, 64 ) );
+		ReadPadded( pMem, nLarge / 2 - 32 );
+		Ball_FreeAlign( pMem );
+
+		// Small sizes come from the slab heap, padded as well.
+		pMem = static_cast< uchar_t * >( CAllocatorBase::Alloc( 24, 8, BALL_ALLOC_PADDED ) );
+		nFailed += !Ball_SlabOwns( pMem ) || CAllocatorBase::Size( pMem, 8 ) < 24 + BALL_ALLOC_PADDING;
+
+		pMem = static_cast< uchar_t * >( CAllocatorBase::Realloc( pMem, 1'000, 8, BALL_ALLOC_PADDED ) );
+		nFailed += !Ball_SlabOwns( pMem ) || CAllocatorBase::Size( pMem, 8 ) < 1'000 + BALL_ALLOC_PADDING;
+
+		CAllocatorBase::Free( pMem );
+	}
+
+	// Containers: plain growth, batches and strings.
+	{
+		PaddedVector_t< uint8_t > vec;
+
+		for ( size_t n = 0; n < 3 * nPage; n++ )
+		{
+			vec.AddToTail( static_cast< uint8_t >( n ) );
+			ReadPadded( vec.Data(), vec.Count() );
+		}
+
+		const CPaddedView< size_t, const uint8_t > view = vec.PaddedView();
+
+		nFailed += view.Count() != 3 * nPage || view.Data() != vec.Data();
+
+		PaddedVector_t< uint64_t > batch[ 3 ];
+		const size_t aCounts[ 3 ] = { 8, 100, nPage / 8 - 8 };
+
+		nFailed += !PaddedVector_t< uint64_t >::ReserveMany( batch, aCounts, 3 );
+
+		for ( PaddedVector_t< uint64_t > &v : batch )
+		{
+			while ( v.Count() < v.Capacity() )
+				v.AddToTail( v.Count() );
+
+			ReadPadded( v.Data(), v.Size() );
+		}
+
+		PaddedString_t sText;
+
+		sText.AppendMultiple( "padded ", 42u );
+		ReadPadded( sText.Data(), sText.Count() );
+		nFailed += sText.PaddedView().Count() != 9;
+	}
+
+	return nFailed;
+}
+
+// Forwards to the default resource and counts the calls.
+class CCountingResource final : public CMemoryResource
+{
+public:
+	void *Alloc( size_t nSize, size_t nAligned ) override { m_nAllocs++; return Default().Alloc( nSize, nAligned ); }
+	void *Realloc( ptr_t pMem, size_t nSize, size_t nAligned ) override { m_nReallocs++; return Default().Realloc( pMem, nSize, nAligned ); }
+	void Free( ptr_t pMem ) override { m_nFrees++; Default().Free( pMem ); }
+
+	size_t m_nAllocs = 0;
+	size_t m_nReallocs = 0;
+	size_t m_nFrees = 0;
+};
+
+// Returns the number of failed checks.
+int TestMemoryResource()
+{
+	int nFailed = 0;
+
+	static_assert( sizeof( Vector_t< size_t > ) < sizeof( ResourceVector_t< size_t > ), "Static allocators take no space" );
+
+	CCountingResource counting;
+	CArena arena;
+	CArenaResource arenaResource( arena );
+
+	{
+		// One type, three strategies picked at run time.
+		ResourceVector_t< size_t > heap, counted, arenaVec;
+
+		nFailed += &heap.Allocator().Resource() != &CMemoryResource::Default();
+		nFailed += !counted.SetAllocator( counting ) || !arenaVec.SetAllocator( arenaResource );
+
+		for ( size_t n = 0; n < 1'000; n++ )
+		{
+			heap.AddToTail( n );
+			counted.AddToTail( n );
+			arenaVec.AddToTail( n );
+		}
+
+		nFailed += counting.m_nAllocs != 1 || counting.m_nReallocs == 0;
+		nFailed += CArena::HeaderOf( arenaVec.Data() )->pArena != &arena;
+		nFailed += counted.SetAllocator( arenaResource ) || &counted.Allocator().Resource() != &counting;
+		nFailed += static_cast< const decltype( arenaVec ) & >( arenaVec )[ 999 ] != 999;
+
+		// Blocks go back to the resource they came from.
+		counted.Purge();
+		nFailed += counting.m_nFrees != 1 || !counted.SetAllocator( CMemoryResource::Default() );
+
+		ResourceString_t str;
+
+		str.SetAllocator( counting );
+		str.Append( "resource" );
+		nFailed += str.Length() != 8 || counting.m_nAllocs != 2;
+	}
+
+	nFailed += counting.m_nFrees != 2;
+
+	return nFailed;
+}
+
 // Entry point section.
 int main()
 {
+	if ( TestSlabAllocator() )
+	{
+		puts( "Slab allocator checks failed" );
+
+		return 1;
+	}
+
+	if ( TestThreadCacheAllocator() )
+	{
+		puts( "Thread cache allocator checks failed" );
+
+		return 1;
+	}
+
+	if ( TestArenaAllocator() )
+	{
+		puts( "Arena allocator checks failed" );
+
+		return 1;
+	}
+
+	if ( TestMemoryResource() )
+	{
+		puts( "Memory resource checks failed" );
+
+		return 1;
+	}
+
+	if ( TestHugePageAllocator() )
+	{
+		puts( "Huge page allocator checks failed" );
+
+		return 1;
+	}
+
+	if ( TestMemStats() )
+	{
+		puts( "Memory statistics checks failed" );
+
+		return 1;
+	}
+
+	if ( TestPopulate() )
+	{
+		puts( "Populate checks failed" );
+
+		return 1;
+	}
+
+	if ( TestPaddedAlloc() )
+	{
+		puts( "Padded allocation checks failed" );
+
+		return 1;
+	}
+
+	if ( TestMemoryBudget() )
+	{
+		puts( "Memory budget checks failed" );
+
+		return 1;
+	}
+
+	if ( TestVectorCapacity() )
+	{
+		puts( "Vector capacity checks failed" );
+
+		return 1;
+	}
+
+	if ( TestGrowthPolicy() )
+	{
+		puts( "Growth policy checks failed" );
+
+		return 1;
+	}
+
+	if ( TestMappedVector() )
+	{
+		puts( "Mapped vector checks failed" );
+
+		return 1;
+	}
+
+	if ( TestRelocation() )
+	{
+		puts( "Element relocation checks failed" );
+
+		return 1;
+	}
+
+	if ( TestMemoryCopy() )
+	{
+		puts( "Memory copy checks failed" );
+
+		return 1;
+	}
+
+	if ( TestLargeCopy() )
+	{
+		puts( "Large copy checks failed" );
+
+		return 1;
+	}
+
+	if ( TestMemoryCompare() )
+	{
+		puts( "Memory compare checks failed" );
+
+		return 1;
+	}
+
+	if ( TestMemoryFind() )
+	{
+		puts( "Memory find checks failed" );
+
+		return 1;
+	}
+
+	if ( TestReservedVector() )
+	{
+		puts( "Reserved vector checks failed" );
+
+		return 1;
+	}
+
+	if ( TestRingBuffer() )
+	{
+		puts( "Ring buffer checks failed" );
+
+		return 1;
+	}
+
+	if ( TestSharedSegment() )
+	{
+		puts( "Shared segment checks failed" );
+
+		return 1;
+	}
+
+	if ( TestSparseArray() )
+	{
+		puts( "Sparse array checks failed" );
+
+		return 1;
+	}
+
+	if ( TestAllocBatch() )
+	{
+		puts( "Batch allocation checks failed" );
+
+		return 1;
+	}
+
 	Vector_t< pair_t > vec;
 
 	{